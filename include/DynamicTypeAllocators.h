@@ -0,0 +1,139 @@
+#pragma once
+
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include "DynamicTypeDefs.h"
+
+/**
+ * Fixed-size slab pool for the instances of a single dynamic type
+ * Memory is allocated from the system allocator in slabs holding multiple blocks, and freed blocks are kept in a free list for reuse
+ * Slabs are only released when the pool is destroyed. Pool is thread safe, and blocks can be freed from a different thread than the one that allocated them
+ */
+class DTL_API FDynamicTypeSlabPool
+{
+protected:
+    size_t BlockSize{0};
+    size_t BlockAlignment{0};
+    size_t BlocksPerSlab{0};
+    std::mutex PoolMutex;
+    /** Intrusive list of the free blocks. First bytes of each free block hold the pointer to the next one */
+    void* FreeList{};
+    std::vector<void*> Slabs;
+public:
+    FDynamicTypeSlabPool(size_t InBlockSize, size_t InBlockAlignment, size_t InBlocksPerSlab = 64);
+    ~FDynamicTypeSlabPool();
+
+    FDynamicTypeSlabPool(const FDynamicTypeSlabPool&) = delete;
+    FDynamicTypeSlabPool& operator=(const FDynamicTypeSlabPool&) = delete;
+
+    [[nodiscard]] size_t GetBlockSize() const { return BlockSize; }
+
+    /** Allocates a single block from the pool, allocating a new slab if there are no free blocks left */
+    [[nodiscard]] void* Allocate();
+    /** Returns the block to the pool. The block must have been allocated from this pool */
+    void Free(void* Block);
+};
+
+/**
+ * Bump-pointer arena for short-lived dynamic type instances
+ * Allocation is a pointer increment, and individual allocations are never freed. Instead, the whole arena is released at once with Reset
+ * Note that Reset does not run destructors, so instances of non-trivially destructible types have to be destroyed before the arena is reset
+ * Arena is not thread safe, and is expected to be used by a single thread, for example through FDynamicTypeArenaScope
+ */
+class DTL_API FDynamicTypeArena
+{
+protected:
+    struct FArenaBlock
+    {
+        uint8_t* Memory;
+        size_t Size;
+    };
+    size_t DefaultBlockSize{0};
+    std::vector<FArenaBlock> Blocks;
+    size_t CurrentBlockIndex{0};
+    uint8_t* CurrentPosition{};
+    uint8_t* CurrentBlockEnd{};
+public:
+    explicit FDynamicTypeArena(size_t InDefaultBlockSize = 64 * 1024);
+    ~FDynamicTypeArena();
+
+    FDynamicTypeArena(const FDynamicTypeArena&) = delete;
+    FDynamicTypeArena& operator=(const FDynamicTypeArena&) = delete;
+
+    /** Allocates memory of the given size and alignment from the arena */
+    [[nodiscard]] void* Allocate(size_t Size, size_t Alignment);
+    /** Releases all allocations made from the arena at once. Memory blocks are kept and reused by the following allocations */
+    void Reset();
+
+    /** Returns the arena that is currently active on this thread, or nullptr if there is none */
+    static FDynamicTypeArena* GetCurrent();
+    /** Makes the provided arena current for this thread, and returns the previously current arena */
+    static FDynamicTypeArena* SetCurrent(FDynamicTypeArena* NewCurrentArena);
+};
+
+/** Makes the arena current for this thread for the lifetime of the scope */
+class FDynamicTypeArenaScope
+{
+    FDynamicTypeArena* PreviousArena{};
+public:
+    explicit FDynamicTypeArenaScope(FDynamicTypeArena& InArena) : PreviousArena(FDynamicTypeArena::SetCurrent(&InArena)) {}
+    ~FDynamicTypeArenaScope() { FDynamicTypeArena::SetCurrent(PreviousArena); }
+
+    FDynamicTypeArenaScope(const FDynamicTypeArenaScope&) = delete;
+    FDynamicTypeArenaScope& operator=(const FDynamicTypeArenaScope&) = delete;
+};
+
+/**
+ * Allocator policies define where Dyn and other containers place the instances of dynamic types
+ * Policies are stateless, and receive the dynamic type being allocated along with the size of the allocation
+ * Size can be larger than the size of the type when the type has a trailing array
+ */
+
+/** Allocates instances from the system heap. This is the default allocator policy */
+struct FDynHeapAllocator
+{
+    static void* Allocate(const IDynamicTypeLayout* Type, const size_t Size)
+    {
+        return ::operator new(Size, std::align_val_t{Type->GetMinAlignment()});
+    }
+    static void Free(const IDynamicTypeLayout* Type, void* Memory, size_t)
+    {
+        ::operator delete(Memory, std::align_val_t{Type->GetMinAlignment()});
+    }
+};
+
+/** Allocates instances from the slab pool of the dynamic type. Allocations that do not match the size of the type go to the heap */
+struct FDynPoolAllocator
+{
+    static void* Allocate(const IDynamicTypeLayout* Type, const size_t Size)
+    {
+        return Size == Type->GetSize() ? Type->GetInstancePool()->Allocate() : FDynHeapAllocator::Allocate(Type, Size);
+    }
+    static void Free(const IDynamicTypeLayout* Type, void* Memory, const size_t Size)
+    {
+        if (Size == Type->GetSize())
+        {
+            Type->GetInstancePool()->Free(Memory);
+        }
+        else
+        {
+            FDynHeapAllocator::Free(Type, Memory, Size);
+        }
+    }
+};
+
+/** Allocates instances from the arena that is current on this thread. Freeing is a no-op, memory is released when the arena is reset */
+struct FDynArenaAllocator
+{
+    static void* Allocate(const IDynamicTypeLayout* Type, const size_t Size)
+    {
+        FDynamicTypeArena* CurrentArena = FDynamicTypeArena::GetCurrent();
+        if (CurrentArena == nullptr)
+        {
+            throw std::runtime_error("FDynArenaAllocator used without an active FDynamicTypeArena on this thread");
+        }
+        return CurrentArena->Allocate(Size, Type->GetMinAlignment());
+    }
+    static void Free(const IDynamicTypeLayout*, void*, size_t) {}
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "DynamicTypeDefs.h"
+
+/**
+ * Hashes the range of bytes, continuing from the provided seed so that multiple ranges can be hashed as if they were one
+ * Input is consumed 32 bytes at a time by four independent lanes, so large bitwise comparable spans of the instances are hashed at the memory bandwidth instead of byte by byte
+ */
+DTL_API uint64_t HashDynamicTypeBytes(const void* Data, size_t Size, uint64_t Seed = 0);
+
+/** Mixes the hash of the value into the hash of the enclosing value. Order of the mixed values matters */
+constexpr uint64_t CombineDynamicTypeHash(const uint64_t Hash, const uint64_t ValueHash)
+{
+    return Hash ^ (ValueHash + 0x9E3779B97F4A7C15ull + (Hash << 12) + (Hash >> 4));
+}
+
+/**
+ * True if the values of the type are equal exactly when their bytes are equal. Requires unique object representations, which excludes floating point types and types with padding.
+ * Class types must also not define operator==, since the user defined equality might ignore some of the bytes or compare the values in a different way
+ */
+template<typename T>
+constexpr bool TIsBitwiseComparableType = std::has_unique_object_representations_v<T> && (std::is_scalar_v<T> || !std::equality_comparable<T>);
+
+/**
+ * Compares and hashes the values of the statically known member type for TMemberTypeDescriptor. Equality and ordering come from the operators of the type,
+ * and hashing from std::hash, except for the bitwise comparable types (see TIsBitwiseComparableType), which are hashed as raw bytes to agree with the bitwise comparable spans of the instances
+ * Can be specialized for the types that do not define the operators, or define them in a way that is not suitable for the dynamic types
+ */
+template<typename T>
+struct TMemberTypeComparator
+{
+    static constexpr bool bSupportsEquality = std::equality_comparable<T>;
+    static constexpr bool bSupportsOrdering = std::totally_ordered<T>;
+    static constexpr bool bSupportsHashing = TIsBitwiseComparableType<T> || requires(const T& Value) { { std::hash<T>{}(Value) } -> std::convertible_to<size_t>; };
+
+    static bool Equals(const T& ValueA, const T& ValueB) { return ValueA == ValueB; }
+    static int32_t Compare(const T& ValueA, const T& ValueB) { return ValueA < ValueB ? -1 : (ValueB < ValueA ? 1 : 0); }
+    static uint64_t Hash(const T& Value)
+    {
+        if constexpr (TIsBitwiseComparableType<T>)
+        {
+            return HashDynamicTypeBytes(&Value, sizeof(T));
+        }
+        else
+        {
+            return std::hash<T>{}(Value);
+        }
+    }
+};
+
+/** Vectors are compared element by element, and ordered lexicographically. Vectors of bitwise comparable elements are hashed with a single pass over their elements */
+template<typename ElementType, typename Allocator>
+struct TMemberTypeComparator<std::vector<ElementType, Allocator>>
+{
+    static constexpr bool bSupportsEquality = TMemberTypeComparator<ElementType>::bSupportsEquality;
+    static constexpr bool bSupportsOrdering = TMemberTypeComparator<ElementType>::bSupportsOrdering;
+    static constexpr bool bSupportsHashing = TMemberTypeComparator<ElementType>::bSupportsHashing;
+
+    static bool Equals(const std::vector<ElementType, Allocator>& ValueA, const std::vector<ElementType, Allocator>& ValueB)
+    {
+        if (ValueA.size() != ValueB.size())
+        {
+            return false;
+        }
+        for (size_t ElementIndex = 0; ElementIndex < ValueA.size(); ElementIndex++)
+        {
+            if (!TMemberTypeComparator<ElementType>::Equals(ValueA[ElementIndex], ValueB[ElementIndex]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    static int32_t Compare(const std::vector<ElementType, Allocator>& ValueA, const std::vector<ElementType, Allocator>& ValueB)
+    {
+        const size_t CommonSize = std::min(ValueA.size(), ValueB.size());
+        for (size_t ElementIndex = 0; ElementIndex < CommonSize; ElementIndex++)
+        {
+            if (const int32_t ElementResult = TMemberTypeComparator<ElementType>::Compare(ValueA[ElementIndex], ValueB[ElementIndex]); ElementResult != 0)
+            {
+                return ElementResult;
+            }
+        }
+        return ValueA.size() < ValueB.size() ? -1 : (ValueB.size() < ValueA.size() ? 1 : 0);
+    }
+    static uint64_t Hash(const std::vector<ElementType, Allocator>& Value)
+    {
+        if constexpr (TIsBitwiseComparableType<ElementType> && !std::is_same_v<ElementType, bool>)
+        {
+            return HashDynamicTypeBytes(Value.data(), Value.size() * sizeof(ElementType), Value.size());
+        }
+        else
+        {
+            uint64_t Hash = Value.size();
+            for (size_t ElementIndex = 0; ElementIndex < Value.size(); ElementIndex++)
+            {
+                Hash = CombineDynamicTypeHash(Hash, TMemberTypeComparator<ElementType>::Hash(Value[ElementIndex]));
+            }
+            return Hash;
+        }
+    }
+};
@@ -0,0 +1,571 @@
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include "DynamicTypeTraits.h"
+
+/**
+ * DynArray is a contiguous array of the instances of the dynamic type, laid out with the stride of the type size
+ * Lifecycle operations on the elements go through the bulk operations of the type layout, so adding, copying or destroying many elements
+ * costs one call per batch instead of one per element. Growth is amortized, and elements of bitwise relocatable types are relocated with memcpy
+ * Note that growing the array invalidates references to it's elements, same as with std::vector
+ */
+template<typename InDynamicType, typename InAllocator = FDynHeapAllocator>
+class DynArray
+{
+    uint8_t* ArrayData{};
+    size_t ArrayNum{0};
+    size_t ArrayMax{0};
+
+    static const IDynamicTypeLayout* GetElementType() { return InDynamicType::StaticType(); }
+    static size_t GetStride() { return GetElementType()->GetSize(); }
+
+    uint8_t* GetElementPtr(const size_t Index) const { return ArrayData + Index * GetStride(); }
+
+    /** Reallocates the array to the new capacity, relocating the existing elements */
+    void ResizeAllocation(const size_t NewMax)
+    {
+        const IDynamicTypeLayout* ElementType = GetElementType();
+        // Elements are laid out with the stride of the fixed type size, so there is no space for the trailing array
+        if (NewMax != 0 && ElementType->HasTrailingArray())
+        {
+            throw std::runtime_error("DynArray does not support types with trailing arrays");
+        }
+        uint8_t* NewArrayData = NewMax != 0 ? static_cast<uint8_t*>(InAllocator::Allocate(ElementType, NewMax * ElementType->GetSize())) : nullptr;
+
+        if (ArrayNum != 0)
+        {
+            if (EnumHasAnyFlags(ElementType->GetTypeFlags(), EMemberTypeFlags::BitwiseRelocatable))
+            {
+                std::memcpy(NewArrayData, ArrayData, ArrayNum * ElementType->GetSize());
+            }
+            else
+            {
+                // Failed move destroys the elements it has constructed, and the array keeps it's old allocation
+                try
+                {
+                    ElementType->MoveConstructTypeInstances(NewArrayData, ArrayData, ArrayNum);
+                }
+                catch (...)
+                {
+                    InAllocator::Free(ElementType, NewArrayData, NewMax * ElementType->GetSize());
+                    throw;
+                }
+                ElementType->DestructTypeInstances(ArrayData, ArrayNum);
+            }
+        }
+        if (ArrayData)
+        {
+            InAllocator::Free(ElementType, ArrayData, ArrayMax * ElementType->GetSize());
+        }
+        ArrayData = NewArrayData;
+        ArrayMax = NewMax;
+    }
+
+    /** Makes sure there is space for at least the provided number of elements, growing the allocation geometrically */
+    void GrowIfNeeded(const size_t RequiredNum)
+    {
+        if (RequiredNum > ArrayMax)
+        {
+            ResizeAllocation(std::max(RequiredNum, std::max<size_t>(ArrayMax * 2, 4)));
+        }
+    }
+
+    /**
+     * Makes sure there is space for one more element, and returns the location of the provided element afterwards
+     * Element might be one of the elements of this array, in which case it is relocated together with the rest of them when the array grows
+     */
+    const uint8_t* GrowForElement(const void* Element)
+    {
+        const uint8_t* ElementPtr = static_cast<const uint8_t*>(Element);
+        if (ArrayNum + 1 > ArrayMax && ElementPtr >= ArrayData && ElementPtr < GetElementPtr(ArrayNum))
+        {
+            const size_t ElementIndex = static_cast<size_t>(ElementPtr - ArrayData) / GetStride();
+            GrowIfNeeded(ArrayNum + 1);
+            return GetElementPtr(ElementIndex);
+        }
+        GrowIfNeeded(ArrayNum + 1);
+        return ElementPtr;
+    }
+public:
+    /** Iterator over the elements of the array. Advances with the stride of the type size */
+    template<typename InElementType>
+    class TIterator
+    {
+        uint8_t* ElementPtr{};
+        size_t Stride{0};
+    public:
+        TIterator(uint8_t* InElementPtr, const size_t InStride) : ElementPtr(InElementPtr), Stride(InStride) {}
+
+        InElementType& operator*() const { return *reinterpret_cast<InElementType*>(ElementPtr); }
+        InElementType* operator->() const { return reinterpret_cast<InElementType*>(ElementPtr); }
+        TIterator& operator++() { ElementPtr += Stride; return *this; }
+        bool operator==(const TIterator& Other) const { return ElementPtr == Other.ElementPtr; }
+        bool operator!=(const TIterator& Other) const { return ElementPtr != Other.ElementPtr; }
+    };
+
+    DynArray() = default;
+
+    DynArray(const DynArray& Other)
+    {
+        ResizeAllocation(Other.ArrayNum);
+        GetElementType()->CopyConstructTypeInstances(ArrayData, Other.ArrayData, Other.ArrayNum);
+        ArrayNum = Other.ArrayNum;
+    }
+
+    DynArray(DynArray&& Other) noexcept : ArrayData(Other.ArrayData), ArrayNum(Other.ArrayNum), ArrayMax(Other.ArrayMax)
+    {
+        Other.ArrayData = nullptr;
+        Other.ArrayNum = 0;
+        Other.ArrayMax = 0;
+    }
+
+    ~DynArray()
+    {
+        Empty();
+        ResizeAllocation(0);
+    }
+
+    DynArray& operator=(const DynArray& Other)
+    {
+        if (this != &Other)
+        {
+            Empty();
+            GrowIfNeeded(Other.ArrayNum);
+            GetElementType()->CopyConstructTypeInstances(ArrayData, Other.ArrayData, Other.ArrayNum);
+            ArrayNum = Other.ArrayNum;
+        }
+        return *this;
+    }
+
+    DynArray& operator=(DynArray&& Other) noexcept
+    {
+        std::swap(ArrayData, Other.ArrayData);
+        std::swap(ArrayNum, Other.ArrayNum);
+        std::swap(ArrayMax, Other.ArrayMax);
+        return *this;
+    }
+
+    [[nodiscard]] size_t Num() const { return ArrayNum; }
+    [[nodiscard]] size_t Max() const { return ArrayMax; }
+    [[nodiscard]] bool IsEmpty() const { return ArrayNum == 0; }
+    [[nodiscard]] bool IsValidIndex(const size_t Index) const { return Index < ArrayNum; }
+
+    /** Returns the pointer to the raw element data. Elements are laid out with the stride of the type size */
+    [[nodiscard]] void* GetData() { return ArrayData; }
+    [[nodiscard]] const void* GetData() const { return ArrayData; }
+
+    InDynamicType& operator[](const size_t Index) { return *reinterpret_cast<InDynamicType*>(GetElementPtr(Index)); }
+    const InDynamicType& operator[](const size_t Index) const { return *reinterpret_cast<const InDynamicType*>(GetElementPtr(Index)); }
+
+    /** Makes sure the array can hold at least the provided number of elements without reallocation */
+    void Reserve(const size_t NewMax)
+    {
+        if (NewMax > ArrayMax)
+        {
+            ResizeAllocation(NewMax);
+        }
+    }
+
+    /** Adds the provided number of default-initialized elements to the end of the array, and returns the index of the first one */
+    size_t AddDefaulted(const size_t Count = 1)
+    {
+        GrowIfNeeded(ArrayNum + Count);
+        GetElementType()->EmplaceTypeInstances(GetElementPtr(ArrayNum), Count);
+        ArrayNum += Count;
+        return ArrayNum - Count;
+    }
+
+    /** Adds a copy of the element to the end of the array, and returns it's index */
+    size_t Add(const InDynamicType& Element)
+    {
+        const uint8_t* SourceElement = GrowForElement(&Element);
+        GetElementType()->CopyConstructTypeInstance(GetElementPtr(ArrayNum), SourceElement);
+        return ArrayNum++;
+    }
+
+    /** Moves the element to the end of the array, and returns it's index */
+    size_t Add(InDynamicType&& Element)
+    {
+        uint8_t* SourceElement = const_cast<uint8_t*>(GrowForElement(&Element));
+        GetElementType()->MoveConstructTypeInstance(GetElementPtr(ArrayNum), SourceElement);
+        return ArrayNum++;
+    }
+
+    /** Removes the element at the provided index, shifting the following elements down to keep the order */
+    void RemoveAt(const size_t Index)
+    {
+        const IDynamicTypeLayout* ElementType = GetElementType();
+        for (size_t ElementIndex = Index + 1; ElementIndex < ArrayNum; ElementIndex++)
+        {
+            ElementType->MoveAssignTypeInstance(GetElementPtr(ElementIndex - 1), GetElementPtr(ElementIndex));
+        }
+        ElementType->DestructTypeInstance(GetElementPtr(--ArrayNum));
+    }
+
+    /** Removes the element at the provided index by moving the last element in it's place. Does not preserve the order of the elements */
+    void RemoveAtSwap(const size_t Index)
+    {
+        const IDynamicTypeLayout* ElementType = GetElementType();
+        if (Index != ArrayNum - 1)
+        {
+            ElementType->MoveAssignTypeInstance(GetElementPtr(Index), GetElementPtr(ArrayNum - 1));
+        }
+        ElementType->DestructTypeInstance(GetElementPtr(--ArrayNum));
+    }
+
+    /** Destroys all elements of the array. Keeps the allocation */
+    void Empty()
+    {
+        GetElementType()->DestructTypeInstances(ArrayData, ArrayNum);
+        ArrayNum = 0;
+    }
+
+    TIterator<InDynamicType> begin() { return TIterator<InDynamicType>(ArrayData, GetStride()); }
+    TIterator<InDynamicType> end() { return TIterator<InDynamicType>(GetElementPtr(ArrayNum), GetStride()); }
+    TIterator<const InDynamicType> begin() const { return TIterator<const InDynamicType>(ArrayData, GetStride()); }
+    TIterator<const InDynamicType> end() const { return TIterator<const InDynamicType>(GetElementPtr(ArrayNum), GetStride()); }
+};
+
+/**
+ * DynSoA stores the instances of the dynamic type as a structure of arrays, where each member of the type (including the members of the parent types) lives in it's own column
+ * Scans over a single member only touch the cache lines of that member, and columns of primitive members are plain arrays that the compiler can vectorize over
+ * Since the instances are never materialized, there is no virtual function table, and elements can only be accessed through the columns or copied in and out of the instances
+ */
+template<typename InDynamicType, typename InAllocator = FDynHeapAllocator>
+class DynSoA
+{
+    struct FColumn
+    {
+        const FDynamicTypeMember* Member{};
+        const IMemberTypeDescriptor* MemberType{};
+        /** Size of the single value of the member type. Array members store ValuesPerElement values for each element */
+        size_t ValueSize{0};
+        size_t ValuesPerElement{1};
+        size_t ElementSize{0};
+        uint8_t* ColumnData{};
+
+        uint8_t* GetValuePtr(const size_t ValueIndex) const { return ColumnData + ValueIndex * ValueSize; }
+    };
+    std::vector<FColumn> Columns;
+    size_t ArrayNum{0};
+    size_t ArrayMax{0};
+
+    static const IDynamicTypeLayout* GetElementType() { return InDynamicType::StaticType(); }
+
+    /** Destroys the values in the provided range of the column data */
+    static void DestructColumnValues(const FColumn& Column, uint8_t* ColumnData, const size_t FirstValueIndex, const size_t EndValueIndex)
+    {
+        if (!Column.MemberType->IsTriviallyDestructible())
+        {
+            for (size_t ValueIndex = FirstValueIndex; ValueIndex < EndValueIndex; ValueIndex++)
+            {
+                Column.MemberType->DestructValue(ColumnData + ValueIndex * Column.ValueSize);
+            }
+        }
+    }
+
+    /**
+     * Reallocates all columns to the new capacity, relocating the existing elements
+     * Values are relocated into all of the new columns before the old ones are released, so if relocating a value throws, the new columns are released and the array keeps it's old allocation
+     */
+    void ResizeAllocation(const size_t NewMax)
+    {
+        const IDynamicTypeLayout* ElementType = GetElementType();
+        std::vector<uint8_t*> NewColumnData(Columns.size(), nullptr);
+        size_t ColumnIndex = 0;
+        size_t NumRelocatedValues = 0;
+        try
+        {
+            for (; ColumnIndex < Columns.size(); ColumnIndex++)
+            {
+                const FColumn& Column = Columns[ColumnIndex];
+                NumRelocatedValues = 0;
+                if (NewMax != 0)
+                {
+                    NewColumnData[ColumnIndex] = static_cast<uint8_t*>(InAllocator::Allocate(ElementType, NewMax * Column.ElementSize));
+                }
+                if (ArrayNum != 0 && Column.MemberType->IsBitwiseRelocatable())
+                {
+                    std::memcpy(NewColumnData[ColumnIndex], Column.ColumnData, ArrayNum * Column.ElementSize);
+                }
+                else if (ArrayNum != 0)
+                {
+                    for (; NumRelocatedValues < ArrayNum * Column.ValuesPerElement; NumRelocatedValues++)
+                    {
+                        Column.MemberType->MoveConstructValue(NewColumnData[ColumnIndex] + NumRelocatedValues * Column.ValueSize, Column.GetValuePtr(NumRelocatedValues));
+                    }
+                }
+            }
+        }
+        catch (...)
+        {
+            // Bitwise relocated values are still owned by the old columns, so only the move constructed values are destroyed
+            for (size_t FailedColumnIndex = 0; FailedColumnIndex <= ColumnIndex && FailedColumnIndex < Columns.size(); FailedColumnIndex++)
+            {
+                const FColumn& Column = Columns[FailedColumnIndex];
+                if (NewColumnData[FailedColumnIndex] == nullptr)
+                {
+                    continue;
+                }
+                if (!Column.MemberType->IsBitwiseRelocatable())
+                {
+                    DestructColumnValues(Column, NewColumnData[FailedColumnIndex], 0, FailedColumnIndex < ColumnIndex ? ArrayNum * Column.ValuesPerElement : NumRelocatedValues);
+                }
+                InAllocator::Free(ElementType, NewColumnData[FailedColumnIndex], NewMax * Column.ElementSize);
+            }
+            throw;
+        }
+
+        for (size_t NewColumnIndex = 0; NewColumnIndex < Columns.size(); NewColumnIndex++)
+        {
+            FColumn& Column = Columns[NewColumnIndex];
+            if (!Column.MemberType->IsBitwiseRelocatable())
+            {
+                DestructColumnValues(Column, Column.ColumnData, 0, ArrayNum * Column.ValuesPerElement);
+            }
+            if (Column.ColumnData)
+            {
+                InAllocator::Free(ElementType, Column.ColumnData, ArrayMax * Column.ElementSize);
+            }
+            Column.ColumnData = NewColumnData[NewColumnIndex];
+        }
+        ArrayMax = NewMax;
+    }
+
+    void GrowIfNeeded(const size_t RequiredNum)
+    {
+        if (RequiredNum > ArrayMax)
+        {
+            ResizeAllocation(std::max(RequiredNum, std::max<size_t>(ArrayMax * 2, 4)));
+        }
+    }
+
+    /**
+     * Destroys the values constructed for the elements in the provided range by the operation that has failed on the value at the provided index of the provided column
+     * Columns before the failed one have the values of all of the elements constructed, and the failed column has the values before the failed one constructed
+     */
+    void DestructPartiallyConstructedElements(const size_t FirstIndex, const size_t Count, const size_t FailedColumnIndex, const size_t FailedValueIndex)
+    {
+        for (size_t ColumnIndex = 0; ColumnIndex < FailedColumnIndex; ColumnIndex++)
+        {
+            const FColumn& Column = Columns[ColumnIndex];
+            DestructColumnValues(Column, Column.ColumnData, FirstIndex * Column.ValuesPerElement, (FirstIndex + Count) * Column.ValuesPerElement);
+        }
+        const FColumn& FailedColumn = Columns[FailedColumnIndex];
+        DestructColumnValues(FailedColumn, FailedColumn.ColumnData, FirstIndex * FailedColumn.ValuesPerElement, FailedValueIndex);
+    }
+
+    /** Destroys the elements in the provided range of every column */
+    void DestructElements(const size_t FirstIndex, const size_t Count)
+    {
+        for (const FColumn& Column : Columns)
+        {
+            DestructColumnValues(Column, Column.ColumnData, FirstIndex * Column.ValuesPerElement, (FirstIndex + Count) * Column.ValuesPerElement);
+        }
+    }
+public:
+    DynSoA()
+    {
+        // Instances of the types with trailing arrays have different sizes, so their elements cannot be split into columns of the fixed size
+        if (GetElementType()->HasTrailingArray())
+        {
+            throw std::runtime_error("DynSoA does not support types with trailing arrays");
+        }
+
+        // Collect the members of the whole type hierarchy, starting with the root type so the columns follow the memory layout order
+        std::vector<const IDynamicTypeLayout*> TypeHierarchy;
+        for (const IDynamicTypeLayout* CurrentType = GetElementType(); CurrentType != nullptr; CurrentType = CurrentType->GetParentType())
+        {
+            TypeHierarchy.push_back(CurrentType);
+        }
+        for (auto TypeIterator = TypeHierarchy.rbegin(); TypeIterator != TypeHierarchy.rend(); ++TypeIterator)
+        {
+            for (const FDynamicTypeMember* Member : (*TypeIterator)->GetTypeMembers())
+            {
+                // Unresolved optional members have no storage
+                if (Member->GetMemberOffset() >= 0)
+                {
+                    Columns.push_back(FColumn{Member, Member->GetType(), Member->GetType()->GetMemberSize(), static_cast<size_t>(Member->GetArrayDim()), Member->GetMemberStorageSize(), nullptr});
+                }
+            }
+        }
+    }
+
+    DynSoA(const DynSoA& Other) : DynSoA()
+    {
+        ResizeAllocation(Other.ArrayNum);
+        size_t ColumnIndex = 0;
+        size_t ValueIndex = 0;
+        try
+        {
+            for (; ColumnIndex < Columns.size(); ColumnIndex++)
+            {
+                FColumn& Column = Columns[ColumnIndex];
+                for (ValueIndex = 0; ValueIndex < Other.ArrayNum * Column.ValuesPerElement; ValueIndex++)
+                {
+                    Column.MemberType->CopyConstructValue(Column.GetValuePtr(ValueIndex), Other.Columns[ColumnIndex].GetValuePtr(ValueIndex));
+                }
+            }
+        }
+        catch (...)
+        {
+            DestructPartiallyConstructedElements(0, Other.ArrayNum, ColumnIndex, ValueIndex);
+            throw;
+        }
+        ArrayNum = Other.ArrayNum;
+    }
+
+    /** Takes the elements and the columns of the other array. Other array is left empty and without columns, and can only be assigned to or destroyed */
+    DynSoA(DynSoA&& Other) noexcept : Columns(std::move(Other.Columns)), ArrayNum(Other.ArrayNum), ArrayMax(Other.ArrayMax)
+    {
+        Other.Columns.clear();
+        Other.ArrayNum = 0;
+        Other.ArrayMax = 0;
+    }
+
+    ~DynSoA()
+    {
+        Empty();
+        ResizeAllocation(0);
+    }
+
+    DynSoA& operator=(const DynSoA&) = delete;
+    /** Swaps the elements and the columns with the other array, which destroys the previous elements of this array when it goes out of scope */
+    DynSoA& operator=(DynSoA&& Other) noexcept
+    {
+        std::swap(Columns, Other.Columns);
+        std::swap(ArrayNum, Other.ArrayNum);
+        std::swap(ArrayMax, Other.ArrayMax);
+        return *this;
+    }
+
+    [[nodiscard]] size_t Num() const { return ArrayNum; }
+    [[nodiscard]] size_t Max() const { return ArrayMax; }
+    [[nodiscard]] bool IsEmpty() const { return ArrayNum == 0; }
+    [[nodiscard]] size_t NumColumns() const { return Columns.size(); }
+
+    /** Returns the index of the column holding the provided member, or -1 if there is no such column */
+    [[nodiscard]] int32_t FindColumn(const FDynamicTypeMember* Member) const
+    {
+        for (size_t ColumnIndex = 0; ColumnIndex < Columns.size(); ColumnIndex++)
+        {
+            if (Columns[ColumnIndex].Member == Member)
+            {
+                return static_cast<int32_t>(ColumnIndex);
+            }
+        }
+        return -1;
+    }
+
+    /** Returns the member stored in the column at the provided index */
+    [[nodiscard]] const FDynamicTypeMember* GetColumnMember(const int32_t ColumnIndex) const { return Columns[ColumnIndex].Member; }
+
+    /** Returns the contiguous array of the values of the column. T must match the type of the member. Array members store all values of the element next to each other */
+    template<typename T>
+    T* GetColumnData(const int32_t ColumnIndex) { return reinterpret_cast<T*>(Columns[ColumnIndex].ColumnData); }
+    template<typename T>
+    const T* GetColumnData(const int32_t ColumnIndex) const { return reinterpret_cast<const T*>(Columns[ColumnIndex].ColumnData); }
+
+    void Reserve(const size_t NewMax)
+    {
+        if (NewMax > ArrayMax)
+        {
+            ResizeAllocation(NewMax);
+        }
+    }
+
+    /** Adds the provided number of default-initialized elements to the end of the array, and returns the index of the first one */
+    size_t AddDefaulted(const size_t Count = 1)
+    {
+        GrowIfNeeded(ArrayNum + Count);
+        size_t ColumnIndex = 0;
+        size_t ValueIndex = 0;
+        try
+        {
+            for (; ColumnIndex < Columns.size(); ColumnIndex++)
+            {
+                FColumn& Column = Columns[ColumnIndex];
+                if (Column.MemberType->IsZeroConstructible())
+                {
+                    std::memset(Column.ColumnData + ArrayNum * Column.ElementSize, 0, Count * Column.ElementSize);
+                    continue;
+                }
+                for (ValueIndex = ArrayNum * Column.ValuesPerElement; ValueIndex < (ArrayNum + Count) * Column.ValuesPerElement; ValueIndex++)
+                {
+                    Column.MemberType->EmplaceValue(Column.GetValuePtr(ValueIndex));
+                }
+            }
+        }
+        catch (...)
+        {
+            DestructPartiallyConstructedElements(ArrayNum, Count, ColumnIndex, ValueIndex);
+            throw;
+        }
+        ArrayNum += Count;
+        return ArrayNum - Count;
+    }
+
+    /** Scatters the copy of the instance into the columns at the end of the array, and returns it's index */
+    size_t Add(const InDynamicType& Element)
+    {
+        GrowIfNeeded(ArrayNum + 1);
+        size_t ColumnIndex = 0;
+        size_t ValueIndex = 0;
+        try
+        {
+            for (; ColumnIndex < Columns.size(); ColumnIndex++)
+            {
+                FColumn& Column = Columns[ColumnIndex];
+                const uint8_t* ElementValues = Column.Member->template ContainerPtrToValuePtr<uint8_t>(&Element);
+                for (ValueIndex = ArrayNum * Column.ValuesPerElement; ValueIndex < (ArrayNum + 1) * Column.ValuesPerElement; ValueIndex++)
+                {
+                    Column.MemberType->CopyConstructValue(Column.GetValuePtr(ValueIndex), ElementValues + (ValueIndex - ArrayNum * Column.ValuesPerElement) * Column.ValueSize);
+                }
+            }
+        }
+        catch (...)
+        {
+            DestructPartiallyConstructedElements(ArrayNum, 1, ColumnIndex, ValueIndex);
+            throw;
+        }
+        return ArrayNum++;
+    }
+
+    /** Gathers the element at the provided index from the columns into an existing instance */
+    void CopyElementTo(const size_t Index, InDynamicType& OutElement) const
+    {
+        for (const FColumn& Column : Columns)
+        {
+            uint8_t* ElementValues = Column.Member->template ContainerPtrToValuePtr<uint8_t>(&OutElement);
+            for (size_t ArrayIndex = 0; ArrayIndex < Column.ValuesPerElement; ArrayIndex++)
+            {
+                Column.MemberType->CopyAssignValue(ElementValues + ArrayIndex * Column.ValueSize, Column.GetValuePtr(Index * Column.ValuesPerElement + ArrayIndex));
+            }
+        }
+    }
+
+    /** Removes the element at the provided index by moving the last element in it's place. Does not preserve the order of the elements */
+    void RemoveAtSwap(const size_t Index)
+    {
+        if (Index != ArrayNum - 1)
+        {
+            for (FColumn& Column : Columns)
+            {
+                for (size_t ArrayIndex = 0; ArrayIndex < Column.ValuesPerElement; ArrayIndex++)
+                {
+                    Column.MemberType->MoveAssignValue(Column.GetValuePtr(Index * Column.ValuesPerElement + ArrayIndex), Column.GetValuePtr((ArrayNum - 1) * Column.ValuesPerElement + ArrayIndex));
+                }
+            }
+        }
+        DestructElements(ArrayNum - 1, 1);
+        ArrayNum--;
+    }
+
+    /** Destroys all elements. Keeps the allocation */
+    void Empty()
+    {
+        DestructElements(0, ArrayNum);
+        ArrayNum = 0;
+    }
+};
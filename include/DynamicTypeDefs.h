@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -10,6 +14,23 @@
 #define DTL_API
 #endif
 
+/**
+ * Enabled by default. Every type implemented with the IMPLEMENT_DYNAMIC_TYPE macros is registered during the static initialization, without collecting it's members or computing it's layout,
+ * so FDynamicTypeRegistry::FindTypeByName, InitializeAllTypes and FDynamicTypeLayoutCache::SaveToFile see all the types linked into the program. Types are then initialized on first use,
+ * or all at once with FDynamicTypeRegistry::InitializeAllTypes. When disabled, types are only registered when they are first used, which keeps the unused types out of the registry
+ */
+#ifndef DTL_EAGER_TYPE_REGISTRATION
+#define DTL_EAGER_TYPE_REGISTRATION 1
+#endif
+
+#ifdef _MSC_VER
+    #define DTL_NOINLINE __declspec(noinline)
+    #define DTL_DEBUG_BREAK() __debugbreak()
+#else
+    #define DTL_NOINLINE __attribute__((noinline))
+    #define DTL_DEBUG_BREAK() __builtin_trap()
+#endif
+
 #ifdef _WIN32
     #define DTL_CHAR wchar_t
     #define DTL_TEXT(__IN_TEXT__) L##__IN_TEXT__
@@ -19,15 +40,133 @@
 #endif
 
 using dtl_string = std::basic_string<DTL_CHAR>;
+using dtl_string_view = std::basic_string_view<DTL_CHAR>;
 
 class IDynamicTypeLayout;
+class FDynamicTypeSlabPool;
+class IDynamicTypeWriter;
+class IDynamicTypeReader;
+
+/** Computes the FNV-1a hash of the name of the type member or virtual function */
+constexpr uint64_t HashDynamicTypeName(const dtl_string_view Name)
+{
+    uint64_t Hash = 14695981039346656037ull;
+    for (const DTL_CHAR Character : Name)
+    {
+        Hash = (Hash ^ static_cast<uint64_t>(Character)) * 1099511628211ull;
+    }
+    return Hash;
+}
+
+/** Incrementally computes the FNV-1a hash of the plain values. Used for the structural hashes of the type layouts and the keys and fingerprints of the record schemas, which are stable across runs of the same build */
+class FDynamicTypeHashBuilder
+{
+    uint64_t Hash{14695981039346656037ull};
+public:
+    template<typename T> requires std::is_trivially_copyable_v<T>
+    FDynamicTypeHashBuilder& Add(const T& Value)
+    {
+        const uint8_t* ValueBytes = reinterpret_cast<const uint8_t*>(&Value);
+        for (size_t ByteIndex = 0; ByteIndex < sizeof(T); ByteIndex++)
+        {
+            Hash = (Hash ^ ValueBytes[ByteIndex]) * 1099511628211ull;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] uint64_t GetHash() const { return Hash; }
+};
+
+/**
+ * Interned name of the dynamic type, member or virtual function. Each unique string is stored once in the global name table,
+ * so the names can be copied and compared for equality as pointers, and the hash of the string is computed only once when the name is interned
+ */
+class DTL_API FDynamicTypeName
+{
+    struct FNameEntry;
+    const FNameEntry* NameEntry{};
+
+    explicit FDynamicTypeName(const FNameEntry* InNameEntry) : NameEntry(InNameEntry) {}
+    static const FNameEntry* FindOrAddNameEntry(dtl_string_view InName, bool bAddIfNotFound);
+public:
+    /** Constructs the none name, which is equal to the empty string */
+    FDynamicTypeName() = default;
+    /** Interns the string, adding it to the name table if it is not there yet */
+    FDynamicTypeName(dtl_string_view InName);
+    FDynamicTypeName(const DTL_CHAR* InName) : FDynamicTypeName(dtl_string_view(InName)) {}
+    FDynamicTypeName(const dtl_string& InName) : FDynamicTypeName(dtl_string_view(InName)) {}
+
+    /** Returns the name if the string has already been interned, or the none name otherwise. Does not add the string to the name table */
+    static FDynamicTypeName Find(dtl_string_view InName);
+
+    [[nodiscard]] bool IsNone() const { return NameEntry == nullptr; }
+    /** Returns the interned string. The reference stays valid for the lifetime of the program */
+    [[nodiscard]] const dtl_string& ToString() const;
+    /** Returns the hash of the string, same as HashDynamicTypeName would */
+    [[nodiscard]] uint64_t GetHash() const;
+
+    bool operator==(const FDynamicTypeName& Other) const { return NameEntry == Other.NameEntry; }
+    bool operator!=(const FDynamicTypeName& Other) const { return NameEntry != Other.NameEntry; }
+};
+
+
+/** Defines bitwise operators for the enum class, allowing it to be used as a set of flags */
+#define DTL_ENUM_CLASS_FLAGS( __ENUM_TYPE__ ) \
+    constexpr __ENUM_TYPE__ operator|(__ENUM_TYPE__ A, __ENUM_TYPE__ B) { return static_cast<__ENUM_TYPE__>(static_cast<std::underlying_type_t<__ENUM_TYPE__>>(A) | static_cast<std::underlying_type_t<__ENUM_TYPE__>>(B)); } \
+    constexpr __ENUM_TYPE__ operator&(__ENUM_TYPE__ A, __ENUM_TYPE__ B) { return static_cast<__ENUM_TYPE__>(static_cast<std::underlying_type_t<__ENUM_TYPE__>>(A) & static_cast<std::underlying_type_t<__ENUM_TYPE__>>(B)); } \
+    constexpr __ENUM_TYPE__ operator~(__ENUM_TYPE__ A) { return static_cast<__ENUM_TYPE__>(~static_cast<std::underlying_type_t<__ENUM_TYPE__>>(A)); } \
+    constexpr __ENUM_TYPE__& operator|=(__ENUM_TYPE__& A, __ENUM_TYPE__ B) { return A = A | B; } \
+    constexpr __ENUM_TYPE__& operator&=(__ENUM_TYPE__& A, __ENUM_TYPE__ B) { return A = A & B; } \
+
+/** Returns true if any of the provided flags are set */
+template<typename TEnum>
+constexpr bool EnumHasAnyFlags(TEnum Flags, TEnum Contains)
+{
+    return static_cast<std::underlying_type_t<TEnum>>(Flags & Contains) != 0;
+}
+
+/** Returns true if all the provided flags are set */
+template<typename TEnum>
+constexpr bool EnumHasAllFlags(TEnum Flags, TEnum Contains)
+{
+    return (Flags & Contains) == Contains;
+}
+
+/** Traits of the member type. They allow layouts and containers to skip per-member work for trivial types entirely */
+enum class EMemberTypeFlags : uint32_t
+{
+    None = 0,
+    /** Default construction of the value does not need to run any code */
+    TriviallyDefaultConstructible = 1 << 0,
+    /** Default (value-initialized) value is represented by all zero bytes, so it can be constructed with memset */
+    ZeroConstructible = 1 << 1,
+    /** Value can be copied with memcpy */
+    TriviallyCopyable = 1 << 2,
+    /** Destruction of the value does not need to run any code */
+    TriviallyDestructible = 1 << 3,
+    /** Value can be moved to a different memory location with memcpy, without running move constructor and destructor */
+    BitwiseRelocatable = 1 << 4,
+    /** Values are equal exactly when their bytes are equal, so they can be compared with memcmp and hashed as raw bytes. Not the case for floating point values and types with padding */
+    BitwiseComparable = 1 << 5,
+
+    /** All the traits above. Types without any state (e.g. empty dynamic types) have all of them */
+    AllTraits = TriviallyDefaultConstructible | ZeroConstructible | TriviallyCopyable | TriviallyDestructible | BitwiseRelocatable | BitwiseComparable,
+};
+DTL_ENUM_CLASS_FLAGS(EMemberTypeFlags);
 
 /** Aligns the pointer or an integer to the given alignment */
 template <typename T>
 constexpr T Align(T Val, const uint64_t Alignment)
 {
     static_assert(std::is_integral_v<T> || std::is_pointer_v<T>, "Align expects an integer or pointer type as Val");
-    return static_cast<T>((static_cast<uint64_t>(Val) + Alignment - 1) & ~(Alignment - 1));
+    if constexpr (std::is_pointer_v<T>)
+    {
+        return reinterpret_cast<T>(Align(reinterpret_cast<uintptr_t>(Val), Alignment));
+    }
+    else
+    {
+        return static_cast<T>((static_cast<uint64_t>(Val) + Alignment - 1) & ~(Alignment - 1));
+    }
 }
 
 /** Base class for dynamic types */
@@ -42,7 +181,10 @@ public:
     FDynamicTypeBase( const FDynamicTypeBase& ) = delete;
     FDynamicTypeBase( FDynamicTypeBase&& ) = delete;
 
+    /** Returns the initialized dynamic type corresponding to this class */
     static IDynamicTypeLayout* StaticType();
+    /** Returns the registered dynamic type corresponding to this class without initializing it. Used to reference the type from the other types */
+    static IDynamicTypeLayout* GetPrivateStaticType();
     static const DTL_CHAR* StaticTypeName() { return DTL_TEXT("FDynamicTypeBase"); }
 
     static IDynamicTypeLayout* StaticParentType() { return nullptr; }
@@ -60,7 +202,7 @@ public:
     virtual ~IMemberTypeDescriptor() = default;
 
     /** Returns the name of the type */
-    [[nodiscard]] virtual dtl_string GetTypeName() const = 0;
+    [[nodiscard]] virtual const dtl_string& GetTypeName() const = 0;
     /** Returns the dynamic type represented by this descriptor, or nullptr if this is not a dynamic type */
     [[nodiscard]] virtual IDynamicTypeLayout* GetDynamicType() const { return nullptr; }
 
@@ -68,6 +210,15 @@ public:
     [[nodiscard]] virtual size_t GetMemberSize() const = 0;
     /** Returns the minimum alignment required for this member */
     [[nodiscard]] virtual size_t GetMemberAlignment() const = 0;
+    /** Returns the traits of this member type. By default, the type is assumed to be non-trivial */
+    [[nodiscard]] virtual EMemberTypeFlags GetTypeFlags() const { return EMemberTypeFlags::None; }
+
+    [[nodiscard]] bool IsTriviallyDefaultConstructible() const { return EnumHasAnyFlags(GetTypeFlags(), EMemberTypeFlags::TriviallyDefaultConstructible); }
+    [[nodiscard]] bool IsZeroConstructible() const { return EnumHasAnyFlags(GetTypeFlags(), EMemberTypeFlags::ZeroConstructible); }
+    [[nodiscard]] bool IsTriviallyCopyable() const { return EnumHasAnyFlags(GetTypeFlags(), EMemberTypeFlags::TriviallyCopyable); }
+    [[nodiscard]] bool IsTriviallyDestructible() const { return EnumHasAnyFlags(GetTypeFlags(), EMemberTypeFlags::TriviallyDestructible); }
+    [[nodiscard]] bool IsBitwiseRelocatable() const { return EnumHasAnyFlags(GetTypeFlags(), EMemberTypeFlags::BitwiseRelocatable); }
+    [[nodiscard]] bool IsBitwiseComparable() const { return EnumHasAnyFlags(GetTypeFlags(), EMemberTypeFlags::BitwiseComparable); }
 
     /** Initializes the value of this member */
     virtual void EmplaceValue(void* PlacementStorage) const = 0;
@@ -75,50 +226,143 @@ public:
     virtual void DestructValue(void* Data) const = 0;
     /** Copies the value from one place to another */
     virtual void CopyAssignValue(void* Dest, const void* Src) const = 0;
+    /** Initializes the value of this member as a copy of another value. By default, emplaces the value and then copy assigns it */
+    virtual void CopyConstructValue(void* PlacementStorage, const void* Src) const { EmplaceValue(PlacementStorage); CopyAssignValue(PlacementStorage, Src); }
+    /** Initializes the value of this member by moving another value into it. Source value is left in a valid but unspecified state. Falls back to the copy by default */
+    virtual void MoveConstructValue(void* PlacementStorage, void* Src) const { CopyConstructValue(PlacementStorage, Src); }
+    /** Moves the value from one place to another. Source value is left in a valid but unspecified state. Falls back to the copy by default */
+    virtual void MoveAssignValue(void* Dest, void* Src) const { CopyAssignValue(Dest, Src); }
+
+    /** Writes the value into the binary stream. By default, trivially copyable values are written as raw bytes and other values cannot be serialized */
+    virtual void SerializeValue(const void* Data, IDynamicTypeWriter& Writer) const;
+    /** Reads the value written by SerializeValue into the existing value */
+    virtual void DeserializeValue(void* Data, IDynamicTypeReader& Reader) const;
+
+    /** Returns true if both values are equal. By default, bitwise comparable values are compared as raw bytes and other values cannot be compared */
+    [[nodiscard]] virtual bool EqualsValue(const void* DataA, const void* DataB) const;
+    /** Returns a negative number, zero or a positive number if the first value is ordered before, together with or after the second one. By default, values cannot be ordered */
+    [[nodiscard]] virtual int32_t CompareValue(const void* DataA, const void* DataB) const;
+    /** Returns the hash of the value. Values that are equal according to EqualsValue have the same hash. By default, bitwise comparable values are hashed as raw bytes and other values cannot be hashed */
+    [[nodiscard]] virtual uint64_t HashValue(const void* Data) const;
+};
+
+/** Hints for the layouts that reorder the members of the type. Declaration order layouts ignore them */
+enum class EMemberLayoutHint : uint8_t
+{
+    Default,
+    /** Member is accessed frequently and should be packed together with other hot members at the start of the type */
+    Hot,
+    /** Member is rarely accessed and should be moved to the end of the type */
+    Cold,
 };
 
 /** Base class for dynamic type members. Can be inherited to allow additional information to member declarations, which is useful in some rare circumstances */
 class DTL_API FDynamicTypeMember {
 protected:
-    dtl_string MemberName;
+    FDynamicTypeName MemberName;
     IMemberTypeDescriptor* MemberType;
     bool bIsOptionalMember{false};
+    /** Number of elements of the fixed-size array member, 1 for regular members, or TrailingArrayDim for the variable-length trailing array */
+    int32_t ArrayDim{1};
     int64_t MemberOffset{-1};
+    /** Size of the member type, cached when the offset is resolved to avoid the virtual call when indexing */
+    int64_t MemberElementSize{0};
+    /** Offset cache of the generated accessors, updated together with the member offset */
+    int64_t* CachedMemberOffset{};
 public:
-    FDynamicTypeMember(const dtl_string& InMemberName, IMemberTypeDescriptor* InMemberType, bool bInIsOptional = false) : MemberName(InMemberName), MemberType(InMemberType), bIsOptionalMember(bInIsOptional) {}
+    /** Array dimension of the variable-length trailing array member. Number of it's elements is chosen when the instance is allocated, and stored in the instance */
+    static constexpr int32_t TrailingArrayDim = 0;
+
+    FDynamicTypeMember(const FDynamicTypeName& InMemberName, IMemberTypeDescriptor* InMemberType, bool bInIsOptional = false, int32_t InArrayDim = 1) :
+        MemberName(InMemberName), MemberType(InMemberType), bIsOptionalMember(bInIsOptional), ArrayDim(InArrayDim) {}
     virtual ~FDynamicTypeMember() = default;
 
-    [[nodiscard]] const dtl_string& GetName() const { return MemberName; }
+    [[nodiscard]] const dtl_string& GetName() const { return MemberName.ToString(); }
+    [[nodiscard]] FDynamicTypeName GetInternedName() const { return MemberName; }
     [[nodiscard]] IMemberTypeDescriptor* GetType() const { return MemberType; }
     [[nodiscard]] int64_t GetMemberOffset() const { return MemberOffset; }
     [[nodiscard]] bool IsOptionalMember() const { return bIsOptionalMember; }
+    [[nodiscard]] int32_t GetArrayDim() const { return ArrayDim; }
+    [[nodiscard]] bool IsTrailingArray() const { return ArrayDim == TrailingArrayDim; }
+    /** Returns the number of bytes the member occupies in the fixed part of the instance. Trailing arrays are placed after the fixed part and occupy no bytes in it */
+    [[nodiscard]] size_t GetMemberStorageSize() const { return IsTrailingArray() ? 0 : MemberType->GetMemberSize() * ArrayDim; }
+    /** Returns the layout hint for this member. Only honored by the layouts that reorder members */
+    [[nodiscard]] virtual EMemberLayoutHint GetLayoutHint() const { return EMemberLayoutHint::Default; }
+    /** Returns the alignment this member should be placed at instead of the natural alignment of it's type, or 0 to use the natural alignment */
+    [[nodiscard]] virtual size_t GetAlignmentOverride() const { return 0; }
 
     /** Converts a pointer to the base of the dynamic type to the pointer to this instance member */
     template<typename T>
-    T* ContainerPtrToValuePtr(void* ContainerPtr, const int32_t ArrayIndex = 0) const
+    T* ContainerPtrToValuePtr(void* ContainerPtr) const
     {
         // If this member is unresolved, return nullptr
         if (GetMemberOffset() < 0)
         {
             return nullptr;
         }
-        return static_cast<T*>(static_cast<uint8_t*>(ContainerPtr) + GetMemberOffset() + ArrayIndex * GetType()->GetMemberSize());
+        return ContainerPtrToValuePtrAtOffset<T>(ContainerPtr, GetMemberOffset());
     }
 
     /** Converts a pointer to the base of the dynamic type to the pointer to this instance member */
     template<typename T>
-    const T* ContainerPtrToValuePtr(const void* ContainerPtr, const int32_t ArrayIndex = 0) const
+    const T* ContainerPtrToValuePtr(const void* ContainerPtr) const
     {
         // If this member is unresolved, return nullptr
         if (GetMemberOffset() < 0)
         {
             return nullptr;
         }
-        return static_cast<const T*>(static_cast<const uint8_t*>(ContainerPtr) + GetMemberOffset() + ArrayIndex * GetType()->GetMemberSize());
+        return ContainerPtrToValuePtrAtOffset<T>(ContainerPtr, GetMemberOffset());
+    }
+
+    /** Converts a pointer to the base of the dynamic type to the pointer to the element of this instance member at the provided index */
+    template<typename T>
+    T* ContainerPtrToValuePtr(void* ContainerPtr, const int32_t ArrayIndex) const
+    {
+        if (GetMemberOffset() < 0)
+        {
+            return nullptr;
+        }
+        return ContainerPtrToValuePtrAtOffset<T>(ContainerPtr, GetMemberOffset() + ArrayIndex * MemberElementSize);
+    }
+
+    /** Converts a pointer to the base of the dynamic type to the pointer to the element of this instance member at the provided index */
+    template<typename T>
+    const T* ContainerPtrToValuePtr(const void* ContainerPtr, const int32_t ArrayIndex) const
+    {
+        if (GetMemberOffset() < 0)
+        {
+            return nullptr;
+        }
+        return ContainerPtrToValuePtrAtOffset<T>(ContainerPtr, GetMemberOffset() + ArrayIndex * MemberElementSize);
     }
 
+    /** Converts a pointer to the base of the dynamic type to the pointer to the value at the provided offset. Offset must be resolved */
+    template<typename T>
+    static T* ContainerPtrToValuePtrAtOffset(void* ContainerPtr, const int64_t Offset)
+    {
+        return reinterpret_cast<T*>(static_cast<uint8_t*>(ContainerPtr) + Offset);
+    }
+
+    template<typename T>
+    static const T* ContainerPtrToValuePtrAtOffset(const void* ContainerPtr, const int64_t Offset)
+    {
+        return reinterpret_cast<const T*>(static_cast<const uint8_t*>(ContainerPtr) + Offset);
+    }
+
+    /** Binds the external variable that receives the offset of this member when it is resolved. Used by the accessors generated by the macros */
+    void Internal_BindCachedMemberOffset(int64_t* InCachedMemberOffset) { CachedMemberOffset = InCachedMemberOffset; }
+
     /** Updates member offset directly. Only to be called by InitializeDynamicType! */
-    void Internal_SetupMemberOffset(const int64_t InMemberOffset) { MemberOffset = InMemberOffset; }
+    void Internal_SetupMemberOffset(const int64_t InMemberOffset)
+    {
+        MemberOffset = InMemberOffset;
+        MemberElementSize = static_cast<int64_t>(MemberType->GetMemberSize());
+        if (CachedMemberOffset)
+        {
+            *CachedMemberOffset = InMemberOffset;
+        }
+    }
 };
 
 /// A function pointer to a generic type-less function
@@ -127,15 +371,46 @@ typedef void (*GenericFunctionPtr);
 class DTL_API FDynamicTypeVirtualFunction
 {
 protected:
-    dtl_string FunctionName;
+    FDynamicTypeName FunctionName;
     int64_t VirtualFunctionTableDisplacement{-1};
     int64_t VirtualFunctionTableOffset{-1};
+    /** Index of the function in the virtual function table, cached so that the dispatch does not have to convert the offset */
+    int64_t VirtualFunctionTableIndex{-1};
     bool bIsOptional{false};
+    /**
+     * Whenever the instances point to the slot holding the currently published virtual function table of their type, instead of pointing to the table itself.
+     * Set for the tables managed by AutoTypeLayout, which are replaced as a whole. Tables of the foreign instances are read directly
+     */
+    bool bPublishedVirtualFunctionTable{false};
+    /**
+     * Implementation of this function shared by all the types that have it, or nullptr if the types have different implementations
+     * Acts as a monomorphic inline cache: while all the types agree, calls skip the virtual function table lookup entirely
+     */
+    std::atomic<GenericFunctionPtr> DevirtualizedFunctionPtr{};
+    /** Number of types having this function in their virtual function table */
+    uint32_t NumImplementingTypes{0};
+
+    /** Returns the virtual function table the instance points to, following the published table slot if the table is managed by the type layout */
+    const GenericFunctionPtr* LoadInstanceVirtualFunctionTable(const void* ContainerPtr) const
+    {
+        const GenericFunctionPtr* VirtualFunctionTable = *reinterpret_cast<const GenericFunctionPtr* const*>(static_cast<const uint8_t*>(ContainerPtr) + VirtualFunctionTableDisplacement);
+        return bPublishedVirtualFunctionTable ? LoadPublishedVirtualFunctionTable(VirtualFunctionTable) : VirtualFunctionTable;
+    }
 public:
-    FDynamicTypeVirtualFunction(const dtl_string& InFunctionName, bool bInIsOptional) : FunctionName(InFunctionName), bIsOptional(bInIsOptional) {}
+    /**
+     * Loads the virtual function table currently published in the slot. Tables are replaced as a whole while other threads are calling them, so the slot is read atomically.
+     * Published tables are never modified, so their entries can be read without synchronization
+     */
+    static const GenericFunctionPtr* LoadPublishedVirtualFunctionTable(const GenericFunctionPtr* PublishedTableSlot)
+    {
+        return static_cast<const GenericFunctionPtr*>(std::atomic_ref(const_cast<GenericFunctionPtr&>(*PublishedTableSlot)).load(std::memory_order_acquire));
+    }
+
+    FDynamicTypeVirtualFunction(const FDynamicTypeName& InFunctionName, bool bInIsOptional) : FunctionName(InFunctionName), bIsOptional(bInIsOptional) {}
     virtual ~FDynamicTypeVirtualFunction() = default;
 
-    [[nodiscard]] const dtl_string& GetName() const { return FunctionName; }
+    [[nodiscard]] const dtl_string& GetName() const { return FunctionName.ToString(); }
+    [[nodiscard]] FDynamicTypeName GetInternedName() const { return FunctionName; }
     [[nodiscard]] int64_t GetVirtualFunctionTableDisplacement() const { return VirtualFunctionTableDisplacement; }
     [[nodiscard]] int64_t GetVirtualFunctionTableOffset() const { return VirtualFunctionTableOffset; }
     [[nodiscard]] bool IsOptionalVirtualFunction() const { return bIsOptional; }
@@ -149,19 +424,130 @@ public:
             return nullptr;
         }
         // Retrieve virtual function table address
-        const GenericFunctionPtr* VirtualFunctionTable = *reinterpret_cast<const GenericFunctionPtr* const*>(static_cast<const uint8_t*>(ContainerPtr) + GetVirtualFunctionTableDisplacement());
+        const GenericFunctionPtr* VirtualFunctionTable = LoadInstanceVirtualFunctionTable(ContainerPtr);
         // Retrieve function at the offset in the virtual function table
-        return VirtualFunctionTable[GetVirtualFunctionTableOffset() / sizeof(GenericFunctionPtr)];
+        return VirtualFunctionTable[VirtualFunctionTableIndex];
     }
 
+    /**
+     * Returns the implementation of this virtual function for the instance without any validation. The function must have been resolved by the type initialization
+     * Returns the devirtualized implementation directly if all types share it, so the instance is only read when the implementations differ
+     */
+    GenericFunctionPtr ResolveVirtualFunctionPtr(const void* ContainerPtr) const
+    {
+        if (const GenericFunctionPtr DevirtualizedFunction = DevirtualizedFunctionPtr.load(std::memory_order_relaxed))
+        {
+            return DevirtualizedFunction;
+        }
+        return LoadInstanceVirtualFunctionTable(ContainerPtr)[VirtualFunctionTableIndex];
+    }
+
+    /**
+     * Returns the implementation of this virtual function from the table published in the slot the instances of the type point to. The function must have been resolved by the type initialization
+     * Used to dispatch the calls on the final types, whose instances are known to point to the slot of that exact type, so the instance does not have to be read
+     */
+    GenericFunctionPtr ResolveVirtualFunctionPtrInPublishedTable(const GenericFunctionPtr* PublishedTableSlot) const
+    {
+        return LoadPublishedVirtualFunctionTable(PublishedTableSlot)[VirtualFunctionTableIndex];
+    }
+
+    /** Returns the implementation shared by all the types having this function, or nullptr if they have different implementations */
+    [[nodiscard]] GenericFunctionPtr GetDevirtualizedFunctionPtr() const { return DevirtualizedFunctionPtr.load(std::memory_order_relaxed); }
+
     /** Updates virtual function offset and displacement directly. Only to be called by InitializeDynamicType! */
-    void Internal_SetupFunctionOffsetAndDisplacement(const int64_t InVirtualFunctionTableDisplacement, const int64_t InVirtualFunctionTableOffset)
+    void Internal_SetupFunctionOffsetAndDisplacement(const int64_t InVirtualFunctionTableDisplacement, const int64_t InVirtualFunctionTableOffset, const bool bInPublishedVirtualFunctionTable = false)
     {
         VirtualFunctionTableDisplacement = InVirtualFunctionTableDisplacement;
+        bPublishedVirtualFunctionTable = bInPublishedVirtualFunctionTable;
         VirtualFunctionTableOffset = InVirtualFunctionTableOffset;
+        VirtualFunctionTableIndex = InVirtualFunctionTableOffset / static_cast<int64_t>(sizeof(GenericFunctionPtr));
+    }
+    /** Records the implementation of this function in the virtual function table of the newly initialized type. Only to be called by InitializeDynamicType! */
+    void Internal_AddImplementation(GenericFunctionPtr Implementation);
+    /** Updates the implementation shared by all the types after one of them has replaced it. Only to be called by RegisterVirtualFunctionOverride! */
+    void Internal_UpdateDevirtualizedFunction(GenericFunctionPtr SharedImplementation);
+};
+
+/**
+ * Open addressing hash table mapping the names to the members or virtual functions of the whole type hierarchy
+ * Elements of the child types shadow the elements of the parent types with the same name. Built once by InitializeDynamicType and read-only afterwards
+ */
+template<typename InElementType>
+class TDynamicTypeNameIndex
+{
+    struct FEntry
+    {
+        uint64_t NameHash{0};
+        InElementType* Element{};
+        bool bDeclaredInThisType{false};
+    };
+    std::vector<FEntry> Entries;
+public:
+    [[nodiscard]] bool IsEmpty() const { return Entries.empty(); }
+
+    /** Clears the index and allocates the space for the provided number of elements, keeping the load factor at or below one half */
+    void Reset(const size_t NumElements)
+    {
+        size_t NumEntries = 0;
+        if (NumElements != 0)
+        {
+            NumEntries = 8;
+            while (NumEntries < NumElements * 2)
+            {
+                NumEntries *= 2;
+            }
+        }
+        Entries.assign(NumEntries, FEntry{});
+    }
+
+    /** Adds the element to the index, unless an element with the same name has already been added. Elements must be added from the most derived type to the root type */
+    void Add(InElementType* Element, const bool bDeclaredInThisType)
+    {
+        const uint64_t NameHash = Element->GetInternedName().GetHash();
+        const size_t IndexMask = Entries.size() - 1;
+        size_t EntryIndex = NameHash & IndexMask;
+        for (; Entries[EntryIndex].Element != nullptr; EntryIndex = (EntryIndex + 1) & IndexMask)
+        {
+            if (Entries[EntryIndex].Element->GetInternedName() == Element->GetInternedName())
+            {
+                return;
+            }
+        }
+        Entries[EntryIndex] = FEntry{NameHash, Element, bDeclaredInThisType};
+    }
+
+    /** Finds the element by name. Elements inherited from the parent types are only returned if bIncludeInherited is true */
+    [[nodiscard]] InElementType* Find(const dtl_string_view Name, const bool bIncludeInherited) const
+    {
+        if (Entries.empty())
+        {
+            return nullptr;
+        }
+        const uint64_t NameHash = HashDynamicTypeName(Name);
+        const size_t IndexMask = Entries.size() - 1;
+        for (size_t EntryIndex = NameHash & IndexMask; Entries[EntryIndex].Element != nullptr; EntryIndex = (EntryIndex + 1) & IndexMask)
+        {
+            const FEntry& Entry = Entries[EntryIndex];
+            if (Entry.NameHash == NameHash && Entry.Element->GetName() == Name)
+            {
+                return bIncludeInherited || Entry.bDeclaredInThisType ? Entry.Element : nullptr;
+            }
+        }
+        return nullptr;
     }
 };
 
+using CollectTypeMembersFunc = void(*)(std::vector<FDynamicTypeMember*>&, std::vector<FDynamicTypeVirtualFunction*>&);
+
+/** Initialization progress of the dynamic type, see IDynamicTypeLayout::EnsureInitialized */
+enum class EDynamicTypeInitializationState : uint8_t
+{
+    Uninitialized,
+    Initialized,
+    /** Initialization has thrown an exception. Type is left partially initialized and cannot be used */
+    Failed,
+};
+
 /**
  * Dynamic Type Layout calculates the locations of the members of the type, virtual functions, and provides functions
  * to allow performing common operations on the dynamic types, such as initialization, destruction, and copying
@@ -169,45 +555,209 @@ public:
  */
 class DTL_API IDynamicTypeLayout {
 protected:
-    dtl_string TypeName;
+    FDynamicTypeName TypeName;
     std::vector<FDynamicTypeMember*> TypeMembers;
     std::vector<FDynamicTypeVirtualFunction*> VirtualFunctions;
     IDynamicTypeLayout* ParentType{};
+    /** Number of the parent types of this type. Root type has the depth of zero */
+    uint32_t InheritanceDepth{0};
+    /** Types in the hierarchy of this type, starting at the root type and ending with this type. Indexed by the inheritance depth of the ancestor */
+    std::vector<const IDynamicTypeLayout*> AncestorTypes;
+    /**
+     * Offset of the pointer to the type header in the instances of this type, or -1 if the instances do not have one. The pointer points right past
+     * the pointer to the most derived type of the instance. Layouts reuse the virtual function table pointer for this, with the type stored at index -1
+     */
+    int64_t InstanceTypeHeaderDisplacement{-1};
+    /** Traits of the type aggregated from the parent type and all members. Computed by InitializeDynamicType */
+    EMemberTypeFlags TypeFlags{EMemberTypeFlags::None};
+    /** Slab pool for the instances of this type. Created on first use by GetInstancePool */
+    mutable std::atomic<FDynamicTypeSlabPool*> InstancePool{};
+    /** Lookup indices for the members and virtual functions of the type hierarchy. Built by InitializeDynamicType */
+    TDynamicTypeNameIndex<FDynamicTypeMember> MemberIndex;
+    TDynamicTypeNameIndex<FDynamicTypeVirtualFunction> VirtualFunctionIndex;
+    /** Sequential ID of the type assigned by FDynamicTypeRegistry, or InvalidTypeId if the type is not registered */
+    uint32_t TypeId{InvalidTypeId};
+    /** Intrusive list of the registered child types. Only written by FDynamicTypeRegistry, can be read without holding any locks */
+    std::atomic<IDynamicTypeLayout*> FirstChildType{};
+    std::atomic<IDynamicTypeLayout*> NextSiblingType{};
+    /** Collects the members and virtual functions of the type when it is initialized. Set for the types constructed by ConstructPrivateStaticType */
+    CollectTypeMembersFunc DeferredCollectTypeMembers{};
+    std::atomic<EDynamicTypeInitializationState> InitializationState{EDynamicTypeInitializationState::Uninitialized};
+    /** Serializes the member collection and the initialization of this type. Never held while initializing the other types */
+    mutable std::mutex InitializationMutex;
+
+    friend class FDynamicTypeRegistry;
 public:
-    IDynamicTypeLayout(const dtl_string& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions);
-    virtual ~IDynamicTypeLayout() = default;
+    static constexpr uint32_t InvalidTypeId = UINT32_MAX;
+
+    IDynamicTypeLayout(const FDynamicTypeName& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions);
+    virtual ~IDynamicTypeLayout();
 
     // Dynamic types cannot be copied or moved
     IDynamicTypeLayout(const IDynamicTypeLayout&) = delete;
     IDynamicTypeLayout(IDynamicTypeLayout&&) = delete;
 
-    [[nodiscard]] const dtl_string& GetTypeName() const { return TypeName; }
+    [[nodiscard]] const dtl_string& GetTypeName() const { return TypeName.ToString(); }
+    [[nodiscard]] FDynamicTypeName GetInternedTypeName() const { return TypeName; }
+    /** Returns the members declared by this type. Members of the types constructed by ConstructPrivateStaticType are only available after the type has been initialized */
     [[nodiscard]] const std::vector<FDynamicTypeMember*>& GetTypeMembers() const { return TypeMembers; }
+    [[nodiscard]] const std::vector<FDynamicTypeVirtualFunction*>& GetVirtualFunctions() const { return VirtualFunctions; }
     [[nodiscard]] IDynamicTypeLayout* GetParentType() const { return ParentType; }
-
-    /** Note that this function will NOT check the parent type */
-    [[nodiscard]] FDynamicTypeMember* FindTypeMember(const dtl_string& MemberName) const;
-    /** Finds the virtual function in this type by name. Note that this function will also not check the parent type */
-    [[nodiscard]] FDynamicTypeVirtualFunction* FindVirtualFunction(const dtl_string& VirtualFunctionName) const;
+    [[nodiscard]] uint32_t GetInheritanceDepth() const { return InheritanceDepth; }
+    /** Returns true if this type cannot have any child types */
+    [[nodiscard]] virtual bool IsFinalType() const { return false; }
+    /** Returns true if this type is the same type as the provided type or derives from it. Constant time, does not walk the hierarchy */
+    [[nodiscard]] bool IsChildOf(const IDynamicTypeLayout* OtherType) const
+    {
+        return OtherType->InheritanceDepth <= InheritanceDepth && AncestorTypes[OtherType->InheritanceDepth] == OtherType;
+    }
+    /** Returns true if the instances of this type store the pointer to their most derived type, see InstanceTypeHeaderDisplacement */
+    [[nodiscard]] bool HasInstanceTypeHeader() const { return InstanceTypeHeaderDisplacement >= 0; }
+    /** Returns the most derived type of the instance of this type, or nullptr if the instances of this type do not have the type header */
+    [[nodiscard]] const IDynamicTypeLayout* GetInstanceType(const void* TypeInstance) const
+    {
+        if (InstanceTypeHeaderDisplacement < 0)
+        {
+            return nullptr;
+        }
+        const void* const* InstanceTypeHeader = *reinterpret_cast<const void* const* const*>(static_cast<const uint8_t*>(TypeInstance) + InstanceTypeHeaderDisplacement);
+        return static_cast<const IDynamicTypeLayout*>(InstanceTypeHeader[-1]);
+    }
+    /** Returns the most derived type of the instance, or this type if the instance does not have the type header */
+    [[nodiscard]] const IDynamicTypeLayout* GetInstanceTypeOrSelf(const void* TypeInstance) const
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(TypeInstance);
+        return InstanceType ? InstanceType : this;
+    }
+    /** Returns the ID of the type in FDynamicTypeRegistry, or InvalidTypeId if the type has not been registered */
+    [[nodiscard]] uint32_t GetTypeId() const { return TypeId; }
+    [[nodiscard]] bool IsRegistered() const { return TypeId != InvalidTypeId; }
+    /** Returns the first registered child type of this type. Use GetNextSiblingType on the child to iterate over the rest of the children */
+    [[nodiscard]] IDynamicTypeLayout* GetFirstChildType() const { return FirstChildType.load(std::memory_order_acquire); }
+    [[nodiscard]] IDynamicTypeLayout* GetNextSiblingType() const { return NextSiblingType.load(std::memory_order_acquire); }
+    /** Returns the traits of the type. Types that are trivially copyable can be copied with a single memcpy, for example */
+    [[nodiscard]] EMemberTypeFlags GetTypeFlags() const { return TypeFlags; }
+    /** Returns the fixed-size slab pool for the instances of this type, creating it on first use */
+    [[nodiscard]] FDynamicTypeSlabPool* GetInstancePool() const;
+
+    /**
+     * Initializes the type if it has not been initialized yet. Parent type and the dynamic types of the members are initialized first, and cyclic dependencies between the types are detected.
+     * Thread safe, and only costs a single atomic load once the type has been initialized. Throws if the initialization of this type or any of it's dependencies fails
+     */
+    void EnsureInitialized() const
+    {
+        if (InitializationState.load(std::memory_order_acquire) != EDynamicTypeInitializationState::Initialized)
+        {
+            InitializeWithDependencies();
+        }
+    }
+    [[nodiscard]] bool IsInitialized() const { return InitializationState.load(std::memory_order_acquire) == EDynamicTypeInitializationState::Initialized; }
+    /** Makes the type collect it's members and virtual functions when it is initialized, instead of receiving them in the constructor. Only to be called by ConstructPrivateStaticType! */
+    void Internal_SetDeferredCollectTypeMembers(const CollectTypeMembersFunc InCollectTypeMembers) { DeferredCollectTypeMembers = InCollectTypeMembers; }
+
+    /** Finds the member in this type by name, initializing the type if needed. Note that this function will NOT check the parent type */
+    [[nodiscard]] FDynamicTypeMember* FindTypeMember(dtl_string_view MemberName) const;
+    /** Finds the virtual function in this type by name, initializing the type if needed. Note that this function will also not check the parent type */
+    [[nodiscard]] FDynamicTypeVirtualFunction* FindVirtualFunction(dtl_string_view VirtualFunctionName) const;
+    /** Finds the member in this type or any of it's parent types by name. Members of this type shadow parent members with the same name */
+    [[nodiscard]] FDynamicTypeMember* FindTypeMemberRecursive(dtl_string_view MemberName) const;
+    /** Finds the virtual function in this type or any of it's parent types by name */
+    [[nodiscard]] FDynamicTypeVirtualFunction* FindVirtualFunctionRecursive(dtl_string_view VirtualFunctionName) const;
 
     /** Returns the ID token for this type. This is used for casting the type implementation */
     [[nodiscard]] virtual uintptr_t GetTypeIdToken() const = 0;
     /** Returns true if this type has the same type ID as the passed token or is a child of a type having that token */
     [[nodiscard]] virtual bool IsSameOrChildOfTypeId(const uintptr_t TypeIdToken) const { return TypeIdToken == GetTypeIdToken(); }
 
-    /** Called once when this type is constructed to initialize it with data */
-    virtual void InitializeDynamicType() {}
     /** Initializes the instance of the type at the provided memory location */
     virtual void EmplaceTypeInstance(void* PlacementStorage) const = 0;
     /** Destroys the instance of the type at the provided memory location */
     virtual void DestructTypeInstance(void* TypeInstance) const = 0;
     /** Copies the data from one type instance to another. Note that this function is modeled after the copy assignment operator, so DestInstance must be a valid type instance, and not a placement storage */
     virtual void CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance) const = 0;
+    /** Initializes the instance of the type at the provided memory location as a copy of another instance. By default, emplaces the instance and then copy assigns it */
+    virtual void CopyConstructTypeInstance(void* PlacementStorage, const void* SrcInstance) const;
+    /** Initializes the instance of the type at the provided memory location by moving another instance into it. Source instance still has to be destroyed. Falls back to the copy by default */
+    virtual void MoveConstructTypeInstance(void* PlacementStorage, void* SrcInstance) const;
+    /** Moves the data from one type instance to another. Same as CopyAssignTypeInstance, DestInstance must be a valid type instance. Falls back to the copy by default */
+    virtual void MoveAssignTypeInstance(void* DestInstance, void* SrcInstance) const;
+
+    /**
+     * Bulk variants of the lifecycle operations above. They operate on Count instances laid out contiguously with the stride of GetSize()
+     * Default implementations call the single-instance operation for each instance, layouts are expected to override them with a more efficient implementation
+     * Constructing operations that throw destroy the instances they have constructed before propagating the exception, so the storage is left without constructed instances
+     */
+    virtual void EmplaceTypeInstances(void* PlacementStorage, size_t Count) const;
+    virtual void DestructTypeInstances(void* TypeInstances, size_t Count) const;
+    virtual void CopyAssignTypeInstances(void* DestInstances, const void* SrcInstances, size_t Count) const;
+    /** Constructs Count instances at the placement storage as copies of the source instances */
+    virtual void CopyConstructTypeInstances(void* PlacementStorage, const void* SrcInstances, size_t Count) const;
+    /** Constructs Count instances at the placement storage by moving the source instances into them. Source instances still have to be destroyed */
+    virtual void MoveConstructTypeInstances(void* PlacementStorage, void* SrcInstances, size_t Count) const;
+
+    /** Returns the member holding the variable-length trailing array of this type, or nullptr if the type does not have one */
+    [[nodiscard]] virtual const FDynamicTypeMember* GetTrailingArrayMember() const { return nullptr; }
+    [[nodiscard]] bool HasTrailingArray() const { return GetTrailingArrayMember() != nullptr; }
+    /** Returns the number of elements in the trailing array of the instance */
+    [[nodiscard]] virtual size_t GetTrailingArrayNum(const void*) const { return 0; }
+    /** Returns the size of the instance with the provided number of trailing array elements. Same as GetSize for types without the trailing array */
+    [[nodiscard]] virtual size_t GetSizeWithTrailingArray(size_t) const { return GetSize(); }
+    /** Returns the size of the existing instance, including it's trailing array */
+    [[nodiscard]] size_t GetTypeInstanceSize(const void* TypeInstance) const { return GetSizeWithTrailingArray(GetTrailingArrayNum(TypeInstance)); }
+    /** Initializes the instance with the provided number of default-initialized trailing array elements. Placement storage must be at least GetSizeWithTrailingArray bytes large */
+    virtual void EmplaceTypeInstanceWithTrailingArray(void* PlacementStorage, size_t TrailingArrayNum) const;
+
+    /**
+     * Writes the instance into the binary stream. The virtual function table is not written, and the trailing array is written as the number of elements followed by the elements
+     * Default implementation writes the parent type followed by the members of this type in the order of declaration. Throws if any of the members cannot be serialized
+     * Instances are written without any type information, data that is stored or sent elsewhere should be preceded by WriteDynamicTypeStreamHeader
+     */
+    virtual void SerializeTypeInstance(const void* TypeInstance, IDynamicTypeWriter& Writer) const;
+    /**
+     * Reads the instance written by SerializeTypeInstance into the existing instance. Instances cannot be resized in place, so the instance with the trailing array must have been constructed
+     * with the same number of elements as the serialized instance. The number is read after the fixed part of the instance, so the mismatch throws once the fixed part has been overwritten
+     */
+    virtual void DeserializeTypeInstance(void* TypeInstance, IDynamicTypeReader& Reader) const;
+    /** Bulk variants of the serialization. Instances are laid out contiguously with the stride of GetSize(), and are written one after another */
+    virtual void SerializeTypeInstances(const void* TypeInstances, size_t Count, IDynamicTypeWriter& Writer) const;
+    virtual void DeserializeTypeInstances(void* TypeInstances, size_t Count, IDynamicTypeReader& Reader) const;
+
+    /**
+     * Returns true if the members of both instances, including the members of the parent types and the trailing array elements, are equal. Neither the padding nor the virtual function table pointer is compared
+     * Default implementation compares the parent type followed by the members of this type through their descriptors. Throws if any of the members cannot be compared
+     * Transient values kept by the layout, such as the number of the trailing array elements, are not members and are never compared or hashed by themselves.
+     * The number of the trailing array elements is still taken into account when the trailing arrays are compared
+     */
+    [[nodiscard]] virtual bool EqualsTypeInstance(const void* TypeInstanceA, const void* TypeInstanceB) const;
+    /** Returns the hash of the instance. Instances that are equal according to EqualsTypeInstance have the same hash. Throws if any of the members cannot be hashed */
+    [[nodiscard]] virtual uint64_t HashTypeInstance(const void* TypeInstance) const;
+    /**
+     * Returns a negative number, zero or a positive number if the first instance is ordered before, together with or after the second one. Instances are ordered lexicographically
+     * by the members of the parent types followed by the members of this type in the order of declaration, regardless of where the layout has placed them, and then by the trailing array elements.
+     * Throws if any of the members cannot be ordered
+     */
+    [[nodiscard]] virtual int32_t CompareTypeInstance(const void* TypeInstanceA, const void* TypeInstanceB) const;
 
     /** @return the current size of the type, or -1 if not computed yet */
     [[nodiscard]] virtual size_t GetSize() const = 0;
     /** @return the current size of the type, or -1 if not computed yet */
     [[nodiscard]] virtual size_t GetMinAlignment() const = 0;
+protected:
+    /** Writes the number of the trailing array elements of the instance followed by the elements. Used by the layouts after the fixed part of the instance has been written */
+    void SerializeTrailingArray(const void* TypeInstance, IDynamicTypeWriter& Writer) const;
+    /** Reads the trailing array written by SerializeTrailingArray into the elements of the instance. Throws if the instance has a different number of elements, since it cannot be resized */
+    void DeserializeTrailingArray(void* TypeInstance, IDynamicTypeReader& Reader) const;
+    /** Compares the number of the trailing array elements of the instances and then the elements. Used by the layouts after the fixed parts of the instances have been compared */
+    [[nodiscard]] bool EqualsTrailingArray(const void* TypeInstanceA, const void* TypeInstanceB) const;
+    /** Mixes the number of the trailing array elements of the instance and the elements into the hash of the fixed part of the instance */
+    [[nodiscard]] uint64_t HashTrailingArray(const void* TypeInstance, uint64_t Hash) const;
+    /** Orders the trailing arrays of the instances lexicographically, the shorter array being ordered first if it is the prefix of the longer one */
+    [[nodiscard]] int32_t CompareTrailingArray(const void* TypeInstanceA, const void* TypeInstanceB) const;
+    /** Called once by EnsureInitialized to compute the layout of the type, after it's dependencies have been initialized. Builds the lookup indices, so overrides must call it */
+    virtual void InitializeDynamicType();
+private:
+    /** Slow path of EnsureInitialized */
+    void InitializeWithDependencies() const;
 };
 
 /** Attempts to cast a dynamic type implementation to the provided class */
@@ -221,15 +771,78 @@ InDynamicTypeImplCastType* CastDynamicTypeImpl(IDynamicTypeLayout* InDynamicType
     return nullptr;
 }
 
-using CollectTypeMembersFunc = void(*)(std::vector<FDynamicTypeMember*>&, std::vector<FDynamicTypeVirtualFunction*>&);
+/**
+ * Global registry of the dynamic types. All types constructed through ConstructPrivateStaticType are registered here when they are constructed, before they are initialized,
+ * and are assigned a sequential type ID. Lookups initialize the types they return, while the child type links and InitializeAllTypes can be used to reach the types without initializing them. Registration is serialized with a lock, but lookups by name, by ID and the enumeration of child types are lock-free,
+ * so they can be performed from any thread while other types are being registered. Data is only ever appended and published with release stores,
+ * and name tables replaced when the registry grows are retired instead of being freed, so that concurrent readers can finish probing them.
+ * Registered types are expected to live until the end of the program
+ */
+class DTL_API FDynamicTypeRegistry
+{
+    struct FTypeNameTable;
+
+    /** Registered types are stored in fixed-size chunks indexed by the type ID, so the existing chunks never move when the registry grows */
+    static constexpr uint32_t TypeChunkSizeLog2 = 8;
+    static constexpr uint32_t TypeChunkSize = 1 << TypeChunkSizeLog2;
+    static constexpr uint32_t MaxTypeChunks = 4096;
+
+    std::atomic<IDynamicTypeLayout**> TypeChunks[MaxTypeChunks]{};
+    std::atomic<uint32_t> NumRegisteredTypes{0};
+    std::atomic<FTypeNameTable*> TypeNameTable{};
+    /** Name tables that have been replaced by the larger ones. Kept alive because the readers might still be using them */
+    std::vector<std::unique_ptr<FTypeNameTable>> RetiredTypeNameTables;
+    std::unique_ptr<FTypeNameTable> CurrentTypeNameTable;
+    std::mutex RegistrationMutex;
+
+    FDynamicTypeRegistry();
+    void AddTypeToNameTable(IDynamicTypeLayout* Type);
+    /** Lookups that return the registered type without initializing it */
+    [[nodiscard]] IDynamicTypeLayout* FindRegisteredTypeById(uint32_t TypeId) const;
+    [[nodiscard]] IDynamicTypeLayout* FindRegisteredTypeByInternedName(const FDynamicTypeName& TypeName) const;
+public:
+    ~FDynamicTypeRegistry();
+
+    FDynamicTypeRegistry(const FDynamicTypeRegistry&) = delete;
+    FDynamicTypeRegistry& operator=(const FDynamicTypeRegistry&) = delete;
+
+    /** Returns the global type registry */
+    static FDynamicTypeRegistry& Get();
+
+    /**
+     * Registers the type, assigning it the next type ID and linking it to the child types list of it's parent. Type does not need to be initialized.
+     * Type names must be unique across the whole program. Types declared with the macros are named after the unqualified class name, so classes with the same name
+     * in different namespaces conflict. Throws if the name is taken, which happens during the static initialization when the types are registered on startup
+     */
+    void RegisterType(IDynamicTypeLayout* Type);
+
+    /** Returns the number of registered types. Type IDs are in the range [0; GetNumTypes()) */
+    [[nodiscard]] uint32_t GetNumTypes() const { return NumRegisteredTypes.load(std::memory_order_acquire); }
+    /** Returns the type with the provided ID, or nullptr if there is no such type. Types returned by the lookups are initialized */
+    [[nodiscard]] IDynamicTypeLayout* FindTypeById(uint32_t TypeId) const;
+    /** Finds the registered type by it's interned name */
+    [[nodiscard]] IDynamicTypeLayout* FindTypeByInternedName(const FDynamicTypeName& TypeName) const;
+    /** Finds the registered type by name. Unlike FDynamicTypeName::Find, this does not lock the name table */
+    [[nodiscard]] IDynamicTypeLayout* FindTypeByName(dtl_string_view TypeName) const;
+    /** Returns the registered child types of the provided type. If bRecursive is true, children of the children are returned as well. Returned types might not be initialized yet */
+    [[nodiscard]] static std::vector<IDynamicTypeLayout*> GetChildTypes(const IDynamicTypeLayout* ParentType, bool bRecursive = false);
+
+    /**
+     * Initializes all registered types that have not been initialized yet, using the provided number of threads, or one per hardware thread if zero.
+     * Types registered while the types are being initialized are initialized as well. Throws the first initialization failure once all threads have finished
+     */
+    void InitializeAllTypes(uint32_t NumThreads = 0) const;
+};
 
+/**
+ * Constructs and registers the type without initializing it. Members are only collected once the type is initialized, so constructing the type
+ * does not construct the types of it's members, and cyclic dependencies between the member types can be detected instead of recursing forever
+ */
 template<typename TypeImplClass, typename... ExtraArgTypes>
-std::unique_ptr<TypeImplClass> ConstructPrivateStaticType(TypeImplClass const dtl_string& InTypeName, IDynamicTypeLayout* InParentType, CollectTypeMembersFunc InCollectTypeMembers, ExtraArgTypes... Args)
+std::unique_ptr<TypeImplClass> ConstructPrivateStaticType(const FDynamicTypeName& InTypeName, IDynamicTypeLayout* InParentType, CollectTypeMembersFunc InCollectTypeMembers, ExtraArgTypes... Args)
 {
-    std::vector<FDynamicTypeMember*> CollectedMembers;
-    std::vector<FDynamicTypeVirtualFunction*> CollectedVirtualFunctions;
-    InCollectTypeMembers(CollectedMembers, CollectedVirtualFunctions);
-    std::unique_ptr<TypeImplClass> NewTypeInstance = std::make_unique<TypeImplClass>(InTypeName, InParentType, CollectedMembers, CollectedVirtualFunctions, std::forward<ExtraArgTypes>(Args...));
-    NewTypeInstance->InitializeDynamicType();
-    return std::move(NewTypeInstance);
+    std::unique_ptr<TypeImplClass> NewTypeInstance = std::make_unique<TypeImplClass>(InTypeName, InParentType, std::vector<FDynamicTypeMember*>{}, std::vector<FDynamicTypeVirtualFunction*>{}, std::forward<ExtraArgTypes>(Args)...);
+    NewTypeInstance->Internal_SetDeferredCollectTypeMembers(InCollectTypeMembers);
+    FDynamicTypeRegistry::Get().RegisterType(NewTypeInstance.get());
+    return NewTypeInstance;
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include "DynamicTypeDefs.h"
+#include "DynamicTypeMappedFile.h"
+
+/**
+ * Offset of the member or of the virtual function table entry of the external type, keyed by the hash of it's name (see HashDynamicTypeName)
+ * Full name is stored in the name data of the type layout, so the lookups can tell the colliding hashes apart
+ */
+struct FExternalMemberLayout
+{
+    uint64_t NameHash{0};
+    int64_t Offset{-1};
+    /** Position and number of the characters of the name within the name data of the type layout */
+    uint32_t NameOffset{0};
+    uint32_t NameLength{0};
+};
+
+/**
+ * Layout of the type in the foreign binary stored in the layout manifest, keyed by the hash of the type name
+ * Followed in the file by the member layouts and then the virtual function layouts, each sorted by the name hash, and then by the name data holding the type name followed by the member names
+ */
+struct FExternalTypeLayout
+{
+    uint64_t TypeNameHash{0};
+    uint64_t Size{0};
+    uint64_t Alignment{1};
+    int64_t VirtualFunctionTableDisplacement{-1};
+    uint32_t NumMembers{0};
+    uint32_t NumVirtualFunctions{0};
+    uint32_t TypeNameLength{0};
+    /** Number of the characters in the name data, which starts with the type name */
+    uint32_t NameDataLength{0};
+
+    [[nodiscard]] const FExternalMemberLayout* GetMembers() const { return reinterpret_cast<const FExternalMemberLayout*>(this + 1); }
+    [[nodiscard]] const FExternalMemberLayout* GetVirtualFunctions() const { return GetMembers() + NumMembers; }
+    [[nodiscard]] const DTL_CHAR* GetNameData() const { return reinterpret_cast<const DTL_CHAR*>(GetVirtualFunctions() + NumVirtualFunctions); }
+    [[nodiscard]] dtl_string_view GetTypeName() const { return dtl_string_view(GetNameData(), TypeNameLength); }
+    /** Returns the name of the member or of the virtual function of this type, or an empty string if it does not fit into the name data */
+    [[nodiscard]] dtl_string_view GetMemberName(const FExternalMemberLayout& MemberLayout) const;
+    /** Returns the layout of the member with the provided name, or nullptr if the manifest does not have it */
+    [[nodiscard]] const FExternalMemberLayout* FindMember(dtl_string_view Name) const;
+    /** Returns the layout of the virtual function with the provided name, or nullptr if the manifest does not have it */
+    [[nodiscard]] const FExternalMemberLayout* FindVirtualFunction(dtl_string_view Name) const;
+};
+
+/** Description of the layout of the type in the foreign binary, used to write the layout manifest. Offsets of the virtual functions are in bytes from the start of the virtual function table */
+struct FExternalTypeLayoutDesc
+{
+    dtl_string TypeName;
+    size_t Size{0};
+    size_t Alignment{1};
+    int64_t VirtualFunctionTableDisplacement{-1};
+    std::vector<std::pair<dtl_string, int64_t>> MemberOffsets;
+    std::vector<std::pair<dtl_string, int64_t>> VirtualFunctionOffsets;
+};
+
+/**
+ * Manifest of the layouts of the types defined by the foreign binary, loaded by FExternalLayoutDynamicType to resolve it's members
+ * Manifest is a single binary file with the layouts of all types, produced by the tooling that knows the layout of the foreign binary and memory-mapped at startup.
+ * Lookups are lock-free binary searches over the mapped file, so the manifest can describe thousands of types without parsing them. It must be loaded before the external types are initialized
+ */
+class DTL_API FExternalLayoutManifest
+{
+    struct FManifestIndexEntry;
+
+    FMappedFile MappedManifestFile;
+    /** Entries of the sorted index of the loaded manifest, or nullptr if no manifest has been loaded */
+    const FManifestIndexEntry* IndexEntries{};
+    uint32_t NumIndexEntries{0};
+
+    FExternalLayoutManifest() = default;
+public:
+    FExternalLayoutManifest(const FExternalLayoutManifest&) = delete;
+    FExternalLayoutManifest& operator=(const FExternalLayoutManifest&) = delete;
+
+    /** Returns the global manifest used by FExternalLayoutDynamicType */
+    static FExternalLayoutManifest& Get();
+
+    /** Maps the manifest file written by SaveToFile, replacing the previously loaded one. Returns false if the file does not exist or is not a valid manifest, in which case the manifest stays empty */
+    bool LoadFromFile(const std::filesystem::path& FilePath);
+    /** Writes the manifest with the provided type layouts. Throws if the same type is described more than once */
+    static void SaveToFile(const std::filesystem::path& FilePath, const std::vector<FExternalTypeLayoutDesc>& TypeLayouts);
+
+    /** Returns the layout of the type with the provided name, or nullptr if it is not in the manifest. Layouts are looked up by the name hash, and the full name is compared on the match */
+    [[nodiscard]] const FExternalTypeLayout* FindTypeLayout(dtl_string_view TypeName) const;
+    [[nodiscard]] uint32_t GetNumTypes() const { return NumIndexEntries; }
+};
+
+/**
+ * Layout of the type defined by the foreign binary. Member offsets, size, alignment and the virtual function table displacement are taken from FExternalLayoutManifest
+ * instead of being computed, so the accessors of the type can be used directly on the memory owned by the foreign binary without copying it (see OverlayExternalInstance).
+ * Optional members and virtual functions missing in the manifest are left unresolved, while missing required ones fail the initialization of the type.
+ * Instances are owned by the foreign binary, so they cannot be constructed or destroyed through this layout. Parent type must be another external type or the empty root type
+ */
+class DTL_API FExternalLayoutDynamicType : public IDynamicTypeLayout
+{
+protected:
+    size_t ExternalSize{0};
+    size_t ExternalAlignment{1};
+    int64_t VirtualFunctionTableDisplacement{-1};
+public:
+    using IDynamicTypeLayout::IDynamicTypeLayout;
+
+    static uintptr_t StaticTypeIdToken();
+    [[nodiscard]] uintptr_t GetTypeIdToken() const override { return StaticTypeIdToken(); }
+
+    void EmplaceTypeInstance(void* PlacementStorage) const override;
+    void DestructTypeInstance(void* TypeInstance) const override;
+    /** Copies the resolved members of the parent types and of this type through their descriptors */
+    void CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance) const override;
+    [[nodiscard]] size_t GetSize() const override { return ExternalSize; }
+    [[nodiscard]] size_t GetMinAlignment() const override { return ExternalAlignment; }
+
+    /** Returns the offset of the virtual function table pointer of the foreign type, or -1 if it does not have one */
+    [[nodiscard]] int64_t GetVirtualFunctionTableDisplacement() const { return VirtualFunctionTableDisplacement; }
+protected:
+    void InitializeDynamicType() override;
+};
+
+/** Views the memory owned by the foreign binary as the instance of the external dynamic type, initializing the type if needed. No data is copied, accessors read the foreign memory directly */
+template<typename InDynamicType>
+InDynamicType* OverlayExternalInstance(void* ForeignInstance)
+{
+    InDynamicType::StaticType();
+    return static_cast<InDynamicType*>(ForeignInstance);
+}
+
+template<typename InDynamicType>
+const InDynamicType* OverlayExternalInstance(const void* ForeignInstance)
+{
+    InDynamicType::StaticType();
+    return static_cast<const InDynamicType*>(ForeignInstance);
+}
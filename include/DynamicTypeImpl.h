@@ -1,26 +1,78 @@
 #pragma once
 
-#include <xstring>
+#include <string>
 #include <memory>
+#include <type_traits>
+#include "DynamicTypeComparison.h"
 #include "DynamicTypeDefs.h"
+#include "DynamicTypeSerialization.h"
+
+struct FCachedTypeLayout;
+
+/**
+ * Provides the traits of the statically known member type, derived from <type_traits> by default
+ * Can be specialized for types that are known to be bitwise relocatable or zero constructible, but are not trivial in the eyes of the compiler
+ * Scalars and classes without operator== are bitwise comparable if they have unique object representations (see TIsBitwiseComparableType). Classes with operator== that compares
+ * all of their bytes can opt in by specializing this template
+ */
+template<typename T>
+struct TMemberTypeTraits
+{
+    static constexpr EMemberTypeFlags Flags =
+        // Value initialization of trivially constructible types is zero initialization. Member pointers are an exception because their null value is not all zeros on some ABIs
+        (std::is_trivially_default_constructible_v<T> ? EMemberTypeFlags::TriviallyDefaultConstructible : EMemberTypeFlags::None) |
+        (std::is_trivially_default_constructible_v<T> && !std::is_member_pointer_v<T> ? EMemberTypeFlags::ZeroConstructible : EMemberTypeFlags::None) |
+        (std::is_trivially_copyable_v<T> ? EMemberTypeFlags::TriviallyCopyable | EMemberTypeFlags::BitwiseRelocatable : EMemberTypeFlags::None) |
+        (std::is_trivially_destructible_v<T> ? EMemberTypeFlags::TriviallyDestructible : EMemberTypeFlags::None) |
+        (TIsBitwiseComparableType<T> ? EMemberTypeFlags::BitwiseComparable : EMemberTypeFlags::None);
+};
 
 /** Implementation of the IMemberTypeDescriptor for a statically known type (e.g. a primitive like int32, FString, float, double) */
 template<typename T>
 class TMemberTypeDescriptor : public IMemberTypeDescriptor {
 protected:
-    dtl_string TypeNameReference;
+    FDynamicTypeName TypeNameReference;
 public:
-    explicit TMemberTypeDescriptor( dtl_string InTypeName ) : TypeNameReference(std::move(InTypeName)) {}
+    explicit TMemberTypeDescriptor( const FDynamicTypeName& InTypeName ) : TypeNameReference(InTypeName) {}
 
     static const T* GetValuePtr(const void* Data) { return static_cast<const T*>(Data); }
     static T* GetValuePtr(void* Data) { return static_cast<T*>(Data); }
 
-    [[nodiscard]] dtl_string GetTypeName() const override { return TypeNameReference; }
+    [[nodiscard]] const dtl_string& GetTypeName() const override { return TypeNameReference.ToString(); }
     [[nodiscard]] size_t GetMemberSize() const override { return sizeof(T); }
     [[nodiscard]] size_t GetMemberAlignment() const override { return alignof(T); }
+    [[nodiscard]] EMemberTypeFlags GetTypeFlags() const override { return TMemberTypeTraits<T>::Flags; }
     void EmplaceValue(void* PlacementStorage) const override { new (PlacementStorage) T(); }
     void DestructValue(void* Data) const override { GetValuePtr(Data)->~T(); }
     void CopyAssignValue(void* Dest, const void* Src) const override { *GetValuePtr(Dest) = *GetValuePtr(Src); }
+    void CopyConstructValue(void* PlacementStorage, const void* Src) const override { new (PlacementStorage) T(*GetValuePtr(Src)); }
+    void MoveConstructValue(void* PlacementStorage, void* Src) const override { new (PlacementStorage) T(std::move(*GetValuePtr(Src))); }
+    void MoveAssignValue(void* Dest, void* Src) const override { *GetValuePtr(Dest) = std::move(*GetValuePtr(Src)); }
+    void SerializeValue(const void* Data, IDynamicTypeWriter& Writer) const override
+    {
+        if constexpr (TMemberTypeSerializer<T>::bIsSerializable) { TMemberTypeSerializer<T>::Serialize(*GetValuePtr(Data), Writer); }
+        else { IMemberTypeDescriptor::SerializeValue(Data, Writer); }
+    }
+    void DeserializeValue(void* Data, IDynamicTypeReader& Reader) const override
+    {
+        if constexpr (TMemberTypeSerializer<T>::bIsSerializable) { TMemberTypeSerializer<T>::Deserialize(*GetValuePtr(Data), Reader); }
+        else { IMemberTypeDescriptor::DeserializeValue(Data, Reader); }
+    }
+    [[nodiscard]] bool EqualsValue(const void* DataA, const void* DataB) const override
+    {
+        if constexpr (TMemberTypeComparator<T>::bSupportsEquality) { return TMemberTypeComparator<T>::Equals(*GetValuePtr(DataA), *GetValuePtr(DataB)); }
+        else { return IMemberTypeDescriptor::EqualsValue(DataA, DataB); }
+    }
+    [[nodiscard]] int32_t CompareValue(const void* DataA, const void* DataB) const override
+    {
+        if constexpr (TMemberTypeComparator<T>::bSupportsOrdering) { return TMemberTypeComparator<T>::Compare(*GetValuePtr(DataA), *GetValuePtr(DataB)); }
+        else { return IMemberTypeDescriptor::CompareValue(DataA, DataB); }
+    }
+    [[nodiscard]] uint64_t HashValue(const void* Data) const override
+    {
+        if constexpr (TMemberTypeComparator<T>::bSupportsHashing) { return TMemberTypeComparator<T>::Hash(*GetValuePtr(Data)); }
+        else { return IMemberTypeDescriptor::HashValue(Data); }
+    }
 
     static TMemberTypeDescriptor* StaticDescriptor(const DTL_CHAR* TypeName)
     {
@@ -37,40 +89,342 @@ protected:
 public:
     explicit FDynamicMemberTypeDescriptor(IDynamicTypeLayout* InDynamicType) : DynamicType(InDynamicType) {}
 
-    [[nodiscard]] dtl_string GetTypeName() const override { return DynamicType->GetTypeName(); }
+    [[nodiscard]] const dtl_string& GetTypeName() const override { return DynamicType->GetTypeName(); }
     [[nodiscard]] size_t GetMemberSize() const override { return DynamicType->GetSize(); }
     [[nodiscard]] size_t GetMemberAlignment() const override { return DynamicType->GetMinAlignment(); }
+    [[nodiscard]] EMemberTypeFlags GetTypeFlags() const override { return DynamicType->GetTypeFlags(); }
     void EmplaceValue(void* PlacementStorage) const override { DynamicType->EmplaceTypeInstance(PlacementStorage); }
     void DestructValue(void* Data) const override { DynamicType->DestructTypeInstance(Data); }
     void CopyAssignValue(void* Dest, const void* Src) const override { DynamicType->CopyAssignTypeInstance(Dest, Src); }
+    void CopyConstructValue(void* PlacementStorage, const void* Src) const override { DynamicType->CopyConstructTypeInstance(PlacementStorage, Src); }
+    void MoveConstructValue(void* PlacementStorage, void* Src) const override { DynamicType->MoveConstructTypeInstance(PlacementStorage, Src); }
+    void MoveAssignValue(void* Dest, void* Src) const override { DynamicType->MoveAssignTypeInstance(Dest, Src); }
+    void SerializeValue(const void* Data, IDynamicTypeWriter& Writer) const override { DynamicType->SerializeTypeInstance(Data, Writer); }
+    void DeserializeValue(void* Data, IDynamicTypeReader& Reader) const override { DynamicType->DeserializeTypeInstance(Data, Reader); }
+    [[nodiscard]] bool EqualsValue(const void* DataA, const void* DataB) const override { return DynamicType->EqualsTypeInstance(DataA, DataB); }
+    [[nodiscard]] int32_t CompareValue(const void* DataA, const void* DataB) const override { return DynamicType->CompareTypeInstance(DataA, DataB); }
+    [[nodiscard]] uint64_t HashValue(const void* Data) const override { return DynamicType->HashTypeInstance(Data); }
     [[nodiscard]] IDynamicTypeLayout* GetDynamicType() const override { return DynamicType; }
 };
 
+/** Kind of the single step in the precompiled lifecycle plan of the type */
+enum class ELifecyclePlanStepKind : uint8_t
+{
+    /** Range of bytes that is filled with zeros */
+    ZeroFill,
+    /** Range of bytes that is copied with memcpy from the source instance, written to and read from the binary stream as is, or compared and hashed as is */
+    CopyBytes,
+    /** Writes the virtual function table pointer at the step offset */
+    VirtualFunctionTable,
+    /** Non-trivial member that has to be handled through it's member type descriptor */
+    MemberValue,
+    /** Dynamic type with a non-automatic layout (e.g. a parent type or a member) that has to be handled through it's type layout */
+    OpaqueType,
+};
+
+/** Single step of the lifecycle plan. Offset is relative to the start of the instance the plan has been compiled for */
+struct FLifecyclePlanStep
+{
+    ELifecyclePlanStepKind Kind{};
+    int64_t Offset{0};
+    /** Size of the byte range for ZeroFill and CopyBytes steps */
+    size_t Size{0};
+    union
+    {
+        const IMemberTypeDescriptor* MemberType{};
+        const IDynamicTypeLayout* OpaqueType;
+        const GenericFunctionPtr* VirtualFunctionTable;
+    };
+};
+
+/**
+ * Lifecycle plan is a flattened list of steps required to construct, destroy or copy an instance of the type, including all of it's parent types and nested dynamic type members
+ * Plans are compiled once when the type is initialized, so operations on the instances are a tight loop over a contiguous array instead of a recursive walk over the type hierarchy
+ * Trivial members are coalesced into bulk ZeroFill and CopyBytes ranges, and only non-trivial members are left as indirect calls
+ */
+class DTL_API FTypeLifecyclePlan
+{
+protected:
+    std::vector<FLifecyclePlanStep> ConstructSteps;
+    /** Steps for constructing the instance from another instance. Shared between copy and move construction */
+    std::vector<FLifecyclePlanStep> ConstructFromSteps;
+    std::vector<FLifecyclePlanStep> DestructSteps;
+    /** Steps for assigning another instance to the instance. Shared between copy and move assignment */
+    std::vector<FLifecyclePlanStep> AssignSteps;
+    /**
+     * Steps for serializing the instance, shared between serialization and deserialization. Byte ranges are only merged when they are adjacent,
+     * so neither the padding nor the virtual function table pointer is written to the stream
+     */
+    std::vector<FLifecyclePlanStep> SerializeSteps;
+    /** Steps for comparing and hashing the instance. Same as the serialization steps, byte ranges are only merged when they are adjacent, and only cover the bitwise comparable values */
+    std::vector<FLifecyclePlanStep> CompareSteps;
+public:
+    /** Appends steps of another plan, shifting them by the provided offset. Used to flatten parent types and nested dynamic type members */
+    void AppendPlan(const FTypeLifecyclePlan& OtherPlan, int64_t BaseOffset);
+    /** Appends steps for the member of the provided type located at the provided offset. Array members append the steps for each element. Transient members are not part of the value, so they are neither serialized nor compared or hashed */
+    void AppendMember(const IMemberTypeDescriptor* MemberType, int64_t MemberOffset, int32_t ArrayDim = 1, bool bIsTransient = false);
+    /** Appends steps for the type with an opaque layout located at the provided offset */
+    void AppendOpaqueType(const IDynamicTypeLayout* OpaqueType, int64_t TypeOffset);
+    /** Appends a step that writes the virtual function table pointer at the provided offset */
+    void AppendVirtualFunctionTable(const GenericFunctionPtr* VirtualFunctionTable, int64_t TableDisplacement);
+    /** Replaces the virtual function table written at the provided displacement. Used by child types to install their own virtual function table */
+    void ReplaceVirtualFunctionTable(const GenericFunctionPtr* NewVirtualFunctionTable, int64_t TableDisplacement);
+    /** Clears all steps of the plan */
+    void Reset();
+
+    /** Constructs the instance by executing the plan */
+    void EmplaceInstance(void* Instance) const { EmplaceInstances(Instance, 1, 0); }
+    /** Destroys the instance by executing the plan */
+    void DestructInstance(void* Instance) const { DestructInstances(Instance, 1, 0); }
+    /** Copies the data from one instance to another by executing the plan */
+    void CopyAssignInstance(void* DestInstance, const void* SrcInstance) const { CopyAssignInstances(DestInstance, SrcInstance, 1, 0); }
+    /** Moves the data from one instance to another by executing the plan */
+    void MoveAssignInstance(void* DestInstance, void* SrcInstance) const { MoveAssignInstances(DestInstance, SrcInstance, 1, 0); }
+    /** Constructs the instance as a copy of another instance by executing the plan */
+    void CopyConstructInstance(void* DestInstance, const void* SrcInstance) const { CopyConstructInstances(DestInstance, SrcInstance, 1, 0); }
+    /** Constructs the instance by moving another instance into it by executing the plan */
+    void MoveConstructInstance(void* DestInstance, void* SrcInstance) const { MoveConstructInstances(DestInstance, SrcInstance, 1, 0); }
+
+    /**
+     * Bulk variants of the operations above, operating on Count instances located Stride bytes apart
+     * Steps are executed in the outer loop and instances in the inner one, so each step is resolved once per batch
+     * If one of the constructing operations throws, the values it has constructed in all the instances are destroyed before the exception is propagated, so the instances are left unconstructed.
+     * Assignments that throw leave the instances constructed, with some of their values already assigned
+     */
+    void EmplaceInstances(void* Instances, size_t Count, size_t Stride) const;
+    void DestructInstances(void* Instances, size_t Count, size_t Stride) const;
+    void CopyAssignInstances(void* DestInstances, const void* SrcInstances, size_t Count, size_t Stride) const;
+    void MoveAssignInstances(void* DestInstances, void* SrcInstances, size_t Count, size_t Stride) const;
+    void CopyConstructInstances(void* DestInstances, const void* SrcInstances, size_t Count, size_t Stride) const;
+    void MoveConstructInstances(void* DestInstances, void* SrcInstances, size_t Count, size_t Stride) const;
+
+    /** Writes Count instances located Stride bytes apart into the stream, one instance after another */
+    void SerializeInstances(const void* Instances, size_t Count, size_t Stride, IDynamicTypeWriter& Writer) const;
+    /** Reads Count instances written by SerializeInstances into the existing instances */
+    void DeserializeInstances(void* Instances, size_t Count, size_t Stride, IDynamicTypeReader& Reader) const;
+    /** Returns true if the serialized instance is the exact copy of it's memory, so contiguous instances can be serialized with a single write */
+    [[nodiscard]] bool IsSerializedAsSingleByteRange(size_t InstanceSize) const;
+
+    /** Returns true if the values of both instances are equal. Byte ranges are compared with memcmp, so adjacent bitwise comparable members are compared at once */
+    [[nodiscard]] bool EqualsInstance(const void* InstanceA, const void* InstanceB) const;
+    /** Returns the hash of the values of the instance, hashing each byte range in a single pass */
+    [[nodiscard]] uint64_t HashInstance(const void* Instance) const;
+    /** Returns true if the instance is compared as a single range of bytes covering all of it, so it has no padding, virtual function table or members that are not bitwise comparable */
+    [[nodiscard]] bool IsComparedAsSingleByteRange(size_t InstanceSize) const;
+private:
+    /** Appends a step that has to be called indirectly, unless the traits of the value allow it to be coalesced into byte ranges or skipped */
+    void AppendIndirectStep(const FLifecyclePlanStep& IndirectStep, EMemberTypeFlags TypeFlags, size_t Size, bool bIsTransient);
+    /** Appends a byte range step, merging it with the last step if it is of the same kind. Ranges separated by padding are only merged if bMergeOverPadding is set */
+    static void AppendByteRange(std::vector<FLifecyclePlanStep>& Steps, ELifecyclePlanStepKind Kind, int64_t Offset, size_t Size, bool bMergeOverPadding = true);
+};
+
+/** Options of the AutoTypeLayout, passed to it's constructor */
+enum class EAutoTypeLayoutFlags : uint32_t
+{
+    None = 0,
+    /** Allocate the virtual function table even if the type has no virtual functions, so the instances know their own type. See IDynamicTypeLayout::GetInstanceType */
+    InstanceTypeHeader = 1 << 0,
+    /** Type cannot have child types */
+    Final = 1 << 1,
+};
+DTL_ENUM_CLASS_FLAGS(EAutoTypeLayoutFlags);
+
 /**
  * Automatic type layout that will lay out members in the order of declaration.
  * Supports virtual table management. If there are virtual functions, they will be bound to this type's vtable.
  * Virtual function implementations can be registered RegisterVirtualFunctionOverride. By default, all virtual functions are pure and calling them will result in a pure handler being called.
+ * Implementations can be replaced at any time, including while other threads are calling them. Child types that have not overridden the function themselves receive the new implementation too.
+ * Instances point to the slot of their type holding the published virtual function table, so each change is applied to a new copy of the table, which is then published with a single atomic store
+ * Types constructed with EAutoTypeLayoutFlags::InstanceTypeHeader get a virtual function table even if they have no virtual functions, so their instances
+ * and the instances of their child types know their own type (see IDynamicTypeLayout::GetInstanceType). Types with virtual functions always have it
  */
 class DTL_API AutoTypeLayout : public IDynamicTypeLayout {
 protected:
     size_t CalculatedSize{0};
     size_t CalculatedAlignment{1};
     int64_t VirtualFunctionTableDisplacement{-1};
+    /** Entries of the virtual function table of this type. Only accessed with the virtual function table mutex held, the callers read the published copies of it */
     std::vector<GenericFunctionPtr> VirtualFunctionTable;
+    /**
+     * Header the instances of this type point to instead of the virtual function table. First entry stores the IDynamicTypeLayout pointer, since that is what
+     * IDynamicTypeLayout::GetInstanceType reads back at index -1, and the second entry is the slot holding the published table, which is where the instances point to
+     */
+    GenericFunctionPtr InstanceTableHeader[2]{};
+    /**
+     * Published copies of the virtual function table, the last one being the current one. Copies are never modified after they are published, and never released
+     * while the type is alive, since the threads that have loaded a replaced table might still be calling through it
+     */
+    std::vector<std::unique_ptr<GenericFunctionPtr[]>> PublishedVirtualFunctionTables;
+    /** Whenever the entry of the virtual function table has been overridden by this type, as opposed to being inherited from the parent type */
+    std::vector<bool> OverriddenVirtualFunctionTableEntries;
+    /** Initialized child types sharing the virtual function table layout with this type. Overrides of this type are propagated to them */
+    std::vector<AutoTypeLayout*> ChildTypeLayouts;
+    EAutoTypeLayoutFlags LayoutFlags{EAutoTypeLayoutFlags::None};
+    /** Flattened lifecycle plan for this type, including the parent types. Compiled by InitializeDynamicType */
+    FTypeLifecyclePlan LifecyclePlan;
+    /** Member holding the variable-length trailing array, if this type has one. It is not a part of the lifecycle plan */
+    FDynamicTypeMember* TrailingArrayMember{};
+    /** Offset of the hidden number of the trailing array elements */
+    int64_t TrailingArrayNumOffset{-1};
+    /** Offset and alignment the members of this type are laid out from, which the structural hash is calculated from. Assigned by InitializeDynamicType */
+    size_t MemberLayoutOffset{0};
+    size_t MemberLayoutAlignment{1};
+
+    friend class FDynamicTypeLayoutCache;
 public:
-    AutoTypeLayout(const dtl_string& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions);
+    AutoTypeLayout(const FDynamicTypeName& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions, EAutoTypeLayoutFlags InLayoutFlags = EAutoTypeLayoutFlags::None);
 
-    /** Allows overriding the default implementation of the provided virtual function */
+    /** Implementation of the virtual function registered by RegisterVirtualFunctionOverrides */
+    struct FVirtualFunctionOverride
+    {
+        const FDynamicTypeVirtualFunction* VirtualFunction{};
+        GenericFunctionPtr FunctionPointer{};
+    };
+
+    /** Allows overriding the default implementation of the provided virtual function. Function can be declared by this type or any of it's parent types */
     void RegisterVirtualFunctionOverride(const FDynamicTypeVirtualFunction* InVirtualFunction, GenericFunctionPtr NewFunctionPointer);
+    /**
+     * Overrides multiple virtual functions at once. All overrides are validated before any of them is applied, so either the whole batch is applied or none of it
+     * Each affected type publishes a single new table with all of the overrides, so a call through an instance observes either none or all of them.
+     * Calls that have started before the batch has been published, or that use the implementation shared by all the types, can still complete with the old implementations
+     */
+    void RegisterVirtualFunctionOverrides(const std::vector<FVirtualFunctionOverride>& InOverrides);
 
     static uintptr_t StaticTypeIdToken();
     [[nodiscard]] uintptr_t GetTypeIdToken() const override { return StaticTypeIdToken(); }
-    void InitializeDynamicType() override;
+    [[nodiscard]] bool IsSameOrChildOfTypeId(const uintptr_t TypeIdToken) const override { return TypeIdToken == StaticTypeIdToken() || IDynamicTypeLayout::IsSameOrChildOfTypeId(TypeIdToken); }
+    [[nodiscard]] bool IsFinalType() const override { return EnumHasAnyFlags(LayoutFlags, EAutoTypeLayoutFlags::Final); }
     void EmplaceTypeInstance(void* Instance) const override;
     void DestructTypeInstance(void* Instance) const override;
     void CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance) const override;
+    void CopyConstructTypeInstance(void* PlacementStorage, const void* SrcInstance) const override;
+    void MoveConstructTypeInstance(void* PlacementStorage, void* SrcInstance) const override;
+    void MoveAssignTypeInstance(void* DestInstance, void* SrcInstance) const override;
+    void EmplaceTypeInstances(void* PlacementStorage, size_t Count) const override;
+    void DestructTypeInstances(void* TypeInstances, size_t Count) const override;
+    void CopyAssignTypeInstances(void* DestInstances, const void* SrcInstances, size_t Count) const override;
+    void CopyConstructTypeInstances(void* PlacementStorage, const void* SrcInstances, size_t Count) const override;
+    void MoveConstructTypeInstances(void* PlacementStorage, void* SrcInstances, size_t Count) const override;
+    [[nodiscard]] const FDynamicTypeMember* GetTrailingArrayMember() const override { return TrailingArrayMember; }
+    [[nodiscard]] size_t GetTrailingArrayNum(const void* TypeInstance) const override;
+    [[nodiscard]] size_t GetSizeWithTrailingArray(size_t TrailingArrayNum) const override;
+    void EmplaceTypeInstanceWithTrailingArray(void* PlacementStorage, size_t TrailingArrayNum) const override;
+    void SerializeTypeInstance(const void* TypeInstance, IDynamicTypeWriter& Writer) const override;
+    void DeserializeTypeInstance(void* TypeInstance, IDynamicTypeReader& Reader) const override;
+    void SerializeTypeInstances(const void* TypeInstances, size_t Count, IDynamicTypeWriter& Writer) const override;
+    void DeserializeTypeInstances(void* TypeInstances, size_t Count, IDynamicTypeReader& Reader) const override;
+    [[nodiscard]] bool EqualsTypeInstance(const void* TypeInstanceA, const void* TypeInstanceB) const override;
+    [[nodiscard]] uint64_t HashTypeInstance(const void* TypeInstance) const override;
     [[nodiscard]] size_t GetSize() const override { return CalculatedSize; }
     [[nodiscard]] size_t GetMinAlignment() const override { return CalculatedAlignment; }
+
+    /**
+     * Returns the slot holding the published virtual function table, which the instances of this type point to, or nullptr if this type has no virtual function table
+     * Slot is stable once the type is initialized, the table it holds can be read with FDynamicTypeVirtualFunction::LoadPublishedVirtualFunctionTable
+     */
+    [[nodiscard]] const GenericFunctionPtr* GetPublishedVirtualFunctionTableSlot() const { return VirtualFunctionTableDisplacement == -1 ? nullptr : &InstanceTableHeader[1]; }
+
+    /** Returns the lifecycle plan compiled for this type */
+    [[nodiscard]] const FTypeLifecyclePlan& GetLifecyclePlan() const { return LifecyclePlan; }
+    /** Returns the structural hash of this type, see CalculateStructuralHash. Calculated on each call, since it is only needed to look up and save the cached layouts */
+    [[nodiscard]] uint64_t GetStructuralHash() const { return CalculateStructuralHash(MemberLayoutOffset, MemberLayoutAlignment); }
+protected:
+    void InitializeDynamicType() override;
+    /** Whenever the layout of this type is worth taking from the layout cache. Declaration order layout is cheaper to compute than to look up, so only the layouts that reorder the members use the cache */
+    [[nodiscard]] virtual bool UsesLayoutCache() const { return false; }
+    /**
+     * Calculates the hash of everything the layout of this type depends on: the offset and alignment the members are laid out from, the name and layout of the parent type,
+     * the layout flags and the names, sizes, alignments and hints of the members. Layouts placing the members differently must mix their own inputs into the hash,
+     * so that their layouts are never taken from the cache entries of the other layouts
+     */
+    virtual uint64_t CalculateStructuralHash(size_t InTypeOffset, size_t InTypeAlignment) const;
+    /** Assigns offsets to the members of this type, starting at the provided offset. Members are laid out in declaration order by default */
+    virtual void LayoutTypeMembers(size_t& InOutTypeOffset, size_t& InOutTypeAlignment);
+    /**
+     * Takes the member offsets, size and alignment of this type from the layout cache instead of computing them. Offset and alignment are the ones LayoutTypeMembers would start from
+     * Returns false without changing the type if the cached layout is not valid for the members of this type, see IsValidCachedLayout
+     */
+    virtual bool ApplyCachedLayout(const FCachedTypeLayout& CachedLayout, size_t InTypeOffset, size_t InTypeAlignment);
+    /**
+     * Checks that the cached layout places every member of this type at it's alignment after the provided offset, without overlapping the other members and the trailing array number,
+     * and that the size and the alignment of the type cover all of them. Does not check that the layout is the one LayoutTypeMembers would compute, only that it is safe to use
+     */
+    [[nodiscard]] bool IsValidCachedLayout(const FCachedTypeLayout& CachedLayout, size_t InTypeOffset, size_t InTypeAlignment) const;
+    /** Compiles the lifecycle plan for this type. Called by InitializeDynamicType after the members and virtual functions have been laid out */
+    virtual void CompileLifecyclePlan();
+
+    /** Returns the index of the entry of the virtual function in VirtualFunctionTable */
+    static int64_t GetVirtualFunctionTableIndex(const FDynamicTypeVirtualFunction* VirtualFunction);
+
+    /** Returns the alignment the member should be placed at, taking the alignment override of the member into account */
+    static size_t GetEffectiveMemberAlignment(const FDynamicTypeMember* Member);
 private:
+    /** Operations on the trailing array elements of the instances, executed after the lifecycle plan has handled the fixed part of the instance */
+    void DestructTrailingArray(void* Instance) const;
+    void CopyConstructTrailingArray(void* DestInstance, const void* SrcInstance) const;
+    void MoveConstructTrailingArray(void* DestInstance, void* SrcInstance) const;
+    /** Checks that both instances have the same number of trailing array elements, since assignment cannot resize the instance */
+    void CheckTrailingArrayNumMatches(const void* DestInstance, const void* SrcInstance) const;
+
+    /** Refreshes the inherited entries of the virtual function table, publishes it, links this type to it's parent type and records it's implementations. Called at the end of InitializeDynamicType */
+    void PublishVirtualFunctionTable();
+    /** Publishes the copy of the current entries of the virtual function table. Called with the virtual function table mutex held */
+    void PublishVirtualFunctionTableCopy();
+    /** Checks that the virtual function is declared by this type or one of it's parent types and has an entry in our virtual function table */
+    void CheckCanOverrideVirtualFunction(const FDynamicTypeVirtualFunction* InVirtualFunction) const;
+    /** Replaces the entries of the virtual function table and publishes the new table, then propagates the entries to the child types that inherit them */
+    void WriteVirtualFunctionTableEntries(const std::vector<std::pair<int64_t, GenericFunctionPtr>>& Entries);
+    /** Recalculates the implementation shared by all the types having the virtual function after it has been overridden */
+    void UpdateDevirtualizedFunction(const FDynamicTypeVirtualFunction* InVirtualFunction) const;
+
     static void PureVirtualFunctionCalled();
 };
+
+/**
+ * Member that carries layout hints for the layouts that reorder members, such as PackedTypeLayout
+ * Alignment override can be used to place the member on it's own cache line to avoid false sharing
+ */
+class DTL_API FHintedDynamicTypeMember : public FDynamicTypeMember
+{
+protected:
+    EMemberLayoutHint LayoutHint{EMemberLayoutHint::Default};
+    size_t AlignmentOverride{0};
+public:
+    FHintedDynamicTypeMember(const FDynamicTypeName& InMemberName, IMemberTypeDescriptor* InMemberType, bool bInIsOptional = false, EMemberLayoutHint InLayoutHint = EMemberLayoutHint::Default, size_t InAlignmentOverride = 0, int32_t InArrayDim = 1) :
+        FDynamicTypeMember(InMemberName, InMemberType, bInIsOptional, InArrayDim), LayoutHint(InLayoutHint), AlignmentOverride(InAlignmentOverride) {}
+
+    [[nodiscard]] EMemberLayoutHint GetLayoutHint() const override { return LayoutHint; }
+    [[nodiscard]] size_t GetAlignmentOverride() const override { return AlignmentOverride; }
+};
+
+/**
+ * Layout that reorders the members of the type to minimize the padding between them, instead of laying them out in declaration order
+ * Hot members are placed first so they share the cache lines right after the parent type, followed by default members and then cold members
+ * Within each group members are sorted by alignment, and padding holes are filled with smaller members of the same group that fit into them
+ * Members with the alignment override are padded to the end of their aligned block, so the cache line aligned members do not share their cache line with the members that follow
+ * Note that the layout of the parent type is not changed, members are only reordered within the type that uses this layout
+ */
+class DTL_API PackedTypeLayout : public AutoTypeLayout {
+protected:
+    size_t DeclarationOrderSize{0};
+public:
+    using AutoTypeLayout::AutoTypeLayout;
+
+    static uintptr_t StaticTypeIdToken();
+    [[nodiscard]] uintptr_t GetTypeIdToken() const override { return StaticTypeIdToken(); }
+    [[nodiscard]] bool IsSameOrChildOfTypeId(const uintptr_t TypeIdToken) const override { return TypeIdToken == StaticTypeIdToken() || AutoTypeLayout::IsSameOrChildOfTypeId(TypeIdToken); }
+
+    /** Returns the size this type would have if the members were laid out in declaration order */
+    [[nodiscard]] size_t GetDeclarationOrderSize() const { return DeclarationOrderSize; }
+    /** Returns the number of bytes saved by reordering the members compared to the declaration order. Can be negative if the hints forced a worse order */
+    [[nodiscard]] int64_t GetSavedBytes() const { return static_cast<int64_t>(DeclarationOrderSize) - static_cast<int64_t>(CalculatedSize); }
+protected:
+    /** Cached layout skips sorting the members and filling the padding holes */
+    [[nodiscard]] bool UsesLayoutCache() const override { return true; }
+    uint64_t CalculateStructuralHash(size_t InTypeOffset, size_t InTypeAlignment) const override;
+    void LayoutTypeMembers(size_t& InOutTypeOffset, size_t& InOutTypeAlignment) override;
+    bool ApplyCachedLayout(const FCachedTypeLayout& CachedLayout, size_t InTypeOffset, size_t InTypeAlignment) override;
+private:
+    /** Calculates the size the type would have if the members were laid out in declaration order, starting at the provided offset */
+    void CalculateDeclarationOrderSize(size_t InTypeOffset, size_t InTypeAlignment);
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "DynamicTypeDefs.h"
+#include "DynamicTypeMappedFile.h"
+
+class PackedTypeLayout;
+
+/** Offset of the member of the cached type, along with the index of the member in the declaration order */
+struct FCachedMemberLayout
+{
+    int64_t Offset{-1};
+    uint32_t MemberIndex{0};
+    uint32_t Reserved{0};
+};
+
+/**
+ * Computed layout of the type stored in the layout cache file, keyed by the structural hash of the type (see AutoTypeLayout::CalculateStructuralHash)
+ * Followed in the file by the member layouts sorted by their offset, so the entry can be validated with a single pass over the members
+ */
+struct FCachedTypeLayout
+{
+    uint64_t StructuralHash{0};
+    uint64_t Size{0};
+    uint64_t Alignment{0};
+    int64_t VirtualFunctionTableDisplacement{-1};
+    int64_t TrailingArrayNumOffset{-1};
+    uint32_t NumMembers{0};
+    uint32_t Reserved{0};
+
+    [[nodiscard]] const FCachedMemberLayout* GetMembers() const { return reinterpret_cast<const FCachedMemberLayout*>(this + 1); }
+};
+
+/**
+ * Cache of the computed type layouts, saved to a binary file by one run and memory-mapped by the next one
+ * Packed types whose structural hash is found in the cache take their member offsets, size and alignment from it instead of running the member layout, which skips sorting the members
+ * and filling the padding holes. Declaration order layouts are cheaper to compute than to look up, so they never consult the cache, and no type calculates it's hash unless a cache is loaded.
+ * Entries are validated before they are used, and rejected entries fall back to computing the layout, so the cache only needs to be rebuilt for speed, not correctness.
+ * Members are still collected and the lifecycle plan is still compiled, since both hold pointers that are only valid in this run.
+ * Cache can be loaded at any time, but only the types initialized after that use it. Lookups are lock-free and can be done from any thread, concurrently with loading the cache
+ */
+class DTL_API FDynamicTypeLayoutCache
+{
+    struct FCacheIndexEntry;
+
+    /** Mapped cache file along with the entries of it's sorted index */
+    struct FLoadedCacheFile
+    {
+        FMappedFile MappedFile;
+        const FCacheIndexEntry* IndexEntries{};
+        uint32_t NumIndexEntries{0};
+    };
+
+    /** Serializes loading the cache files */
+    std::mutex LoadMutex;
+    /**
+     * Cache files loaded so far, the last one being the current one unless the last load has failed. Replaced files are never unmapped,
+     * since the threads that have looked up the layouts in them might still be reading them
+     */
+    std::vector<std::unique_ptr<FLoadedCacheFile>> LoadedCacheFiles;
+    /** Currently loaded cache file, or nullptr if no cache has been loaded */
+    std::atomic<const FLoadedCacheFile*> CurrentCacheFile{};
+    mutable std::atomic<uint32_t> NumCacheHits{0};
+    mutable std::atomic<uint32_t> NumCacheMisses{0};
+
+    FDynamicTypeLayoutCache() = default;
+public:
+    FDynamicTypeLayoutCache(const FDynamicTypeLayoutCache&) = delete;
+    FDynamicTypeLayoutCache& operator=(const FDynamicTypeLayoutCache&) = delete;
+
+    /** Returns the global layout cache used by AutoTypeLayout::InitializeDynamicType */
+    static FDynamicTypeLayoutCache& Get();
+
+    /** Maps the cache file written by SaveToFile, replacing the previously loaded one. Returns false if the file does not exist or is not a valid cache, in which case the cache stays empty */
+    bool LoadFromFile(const std::filesystem::path& FilePath);
+    /** Writes the layouts of all registered packed type layouts to the file, initializing the types that have not been initialized yet */
+    static void SaveToFile(const std::filesystem::path& FilePath);
+    /** Writes the layouts of the provided initialized types to the file. Types with the same structural hash share the entry */
+    static void SaveToFile(const std::filesystem::path& FilePath, const std::vector<const PackedTypeLayout*>& TypeLayouts);
+
+    /** Returns the cached layout of the type with the provided structural hash, or nullptr if it is not in the cache. Returned layout stays valid until the program exits */
+    [[nodiscard]] const FCachedTypeLayout* FindTypeLayout(uint64_t StructuralHash) const;
+    [[nodiscard]] uint32_t GetNumTypes() const;
+    /** Whenever the cache file has been loaded successfully */
+    [[nodiscard]] bool IsLoaded() const { return CurrentCacheFile.load(std::memory_order_acquire) != nullptr; }
+
+    /** Number of types that have been initialized from the cache, and the number of types that have not been found in it or whose entry has been rejected */
+    [[nodiscard]] uint32_t GetNumCacheHits() const { return NumCacheHits.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint32_t GetNumCacheMisses() const { return NumCacheMisses.load(std::memory_order_relaxed); }
+    /** Updates the statistics of the cache. Called by AutoTypeLayout::InitializeDynamicType */
+    void Internal_RecordLookup(const bool bCacheHit) const { (bCacheHit ? NumCacheHits : NumCacheMisses).fetch_add(1, std::memory_order_relaxed); }
+};
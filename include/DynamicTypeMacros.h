@@ -2,8 +2,10 @@
 
 #include "DynamicTypeDefs.h"
 #include "DynamicTypeTraits.h"
+#include "DynamicTypeExternalLayout.h"
 
 /// Declares a dynamic type without any members. This can be used to declare a minimal dynamic type
+/// Type is named after the class name without it's namespace, and the names must be unique across the whole program (see FDynamicTypeRegistry::RegisterType)
 #define DECLARE_DYNAMIC_TYPE( __TYPE_NAME__, __PARENT_TYPE__, __API_MACRO__ ) \
     public:                                                               \
         static constexpr bool IsDynamicType = true;                       \
@@ -16,70 +18,71 @@
         __TYPE_NAME__( const __TYPE_NAME__& ) = delete;                   \
         __TYPE_NAME__( __TYPE_NAME__&& ) = delete;                        \
         \
-        /** @return the dynamic type corresponding to this class */       \
+        /** @return the initialized dynamic type corresponding to this class */ \
         static __API_MACRO__ IDynamicTypeLayout* StaticType();         \
+        /** @return the registered dynamic type corresponding to this class, without initializing it */ \
+        static __API_MACRO__ IDynamicTypeLayout* GetPrivateStaticType(); \
         static const DTL_CHAR* StaticTypeName() { return DTL_TEXT(#__TYPE_NAME__); } \
         \
         /** Define copy assignment operator for this type and also for the Dyn reference to this type for convenience */ \
         ThisClass& operator=(const ThisClass& Other) { AssignDynamicType(*this, Other); return *this; } \
         ThisClass& operator=(const Dyn<ThisClass>& Other) { AssignDynamicType(*this, *Other); return *this; } \
 
+/// Tag selecting the step of the member collection chain generated by the macros. Each member and virtual function declares an overload of __CollectDynamicMembers
+/// taking the tag with it's own __COUNTER__ value, which collects it and calls the overload of the next counter value, until the one declared by DYNAMIC_TYPE_END
+template<uint64_t MemberIndex>
+using TDynamicMemberIndex = std::integral_constant<uint64_t, MemberIndex>;
+
 /// Declares a dynamic type with the specified parameters. Has to be followed by END_DYNAMIC_TYPE
 #define DYNAMIC_TYPE_BODY( __TYPE_NAME__, __PARENT_TYPE__, __API_MACRO__ )     \
         DECLARE_DYNAMIC_TYPE( __TYPE_NAME__, __PARENT_TYPE__, __API_MACRO__ ); \
         private:                                                               \
             static constexpr uint64_t FirstMemberIndex = __COUNTER__;          \
-            template<uint64_t MemberIndex>                                     \
-            static void __CollectDynamicMembers(std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
-                {                                                              \
-                    abort(); /** This function should NEVER be called directly as a non-specialized variant */ \
-                }                                                              \
-            template<>                                                         \
-            void __CollectDynamicMembers<FirstMemberIndex>(std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
+            static void __CollectDynamicMembers(TDynamicMemberIndex<FirstMemberIndex>, std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
                 {                                                              \
-                    __CollectDynamicMembers<FirstMemberIndex + 1>(OutMembers, OutVirtualFunctions); /** On the first function we just call the first real member */ \
+                    __CollectDynamicMembers(TDynamicMemberIndex<FirstMemberIndex + 1>{}, OutMembers, OutVirtualFunctions); /** On the first function we just call the first real member */ \
                 }                                                              \
 
 /// Closes the dynamic type declared using BEGIN_DYNAMIC_TYPE
 #define DYNAMIC_TYPE_END   \
         private:           \
             static constexpr uint64_t LastMemberIndex = __COUNTER__; \
-            template<>     \
-            static void __CollectDynamicMembers<LastMemberIndex>(std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
+            static void __CollectDynamicMembers(TDynamicMemberIndex<LastMemberIndex>, std::vector<FDynamicTypeMember*>&, std::vector<FDynamicTypeVirtualFunction*>&) \
             {              \
                 /** This one is the last one called and does not need to add anything */ \
             }              \
             static void CollectDynamicMembers(std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
             {              \
-                __CollectDynamicMembers<FirstMemberIndex>(OutMembers, OutVirtualFunctions); \
+                __CollectDynamicMembers(TDynamicMemberIndex<FirstMemberIndex>{}, OutMembers, OutVirtualFunctions); \
             }              \
 
 // This one does declare most of the boilerplate for the dynamic member, but does not define ConstructDynamicMember_MemberName
 #define DEFINE_DYNAMIC_MEMBER_BOILERPLATE( __MEMBER_NAME__ ) \
         private:                                             \
             static constexpr uint64_t MemberIndex_##__MEMBER_NAME__ = __COUNTER__; \
-            template<>     \
-            static void __CollectDynamicMembers<MemberIndex_##__MEMBER_NAME__>(std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
+            static void __CollectDynamicMembers(TDynamicMemberIndex<MemberIndex_##__MEMBER_NAME__>, std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
             {              \
                 OutMembers.push_back(ConstructDynamicMember_##__MEMBER_NAME__());       \
-                __CollectDynamicMembers<MemberIndex_##__MEMBER_NAME__ + 1>(OutMembers, OutVirtualFunctions); \
+                __CollectDynamicMembers(TDynamicMemberIndex<MemberIndex_##__MEMBER_NAME__ + 1>{}, OutMembers, OutVirtualFunctions); \
             }                                                \
 
 #define DEFINE_DYNAMIC_VIRTUAL_FUNCTION_BOILERPLATE( __VIRTUAL_FUNCTION_NAME__ ) \
         private:                                             \
             static constexpr uint64_t MemberIndex_##__VIRTUAL_FUNCTION_NAME__ = __COUNTER__; \
-            template<>     \
-            static void __CollectDynamicMembers<MemberIndex_##__VIRTUAL_FUNCTION_NAME__>(std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
+            static void __CollectDynamicMembers(TDynamicMemberIndex<MemberIndex_##__VIRTUAL_FUNCTION_NAME__>, std::vector<FDynamicTypeMember*>& OutMembers, std::vector<FDynamicTypeVirtualFunction*>& OutVirtualFunctions) \
             {              \
             OutVirtualFunctions.push_back(ConstructDynamicVirtualFunction_##__VIRTUAL_FUNCTION_NAME__());       \
-            __CollectDynamicMembers<MemberIndex_##__VIRTUAL_FUNCTION_NAME__ + 1>(OutMembers, OutVirtualFunctions); \
+            __CollectDynamicMembers(TDynamicMemberIndex<MemberIndex_##__VIRTUAL_FUNCTION_NAME__ + 1>{}, OutMembers, OutVirtualFunctions); \
             }                                                \
 
 #define DEFINE_DYNAMIC_TYPE_MEMBER( __MEMBER_CLASS__, __MEMBER_NAME__, ... ) \
         private:                                                             \
+            /** Offset of the member, written by the type layout when the type is initialized. Instances cannot exist before that, so accessors can read it directly */ \
+            static inline int64_t CachedMemberOffset_##__MEMBER_NAME__ = -1; \
             static FDynamicTypeMember* ConstructDynamicMember_##__MEMBER_NAME__() \
             {                                                                \
                 static __MEMBER_CLASS__ StaticMemberInstance{ DTL_TEXT( #__MEMBER_NAME__ ), __VA_ARGS__ };     \
+                StaticMemberInstance.Internal_BindCachedMemberOffset(&CachedMemberOffset_##__MEMBER_NAME__); \
                 return &StaticMemberInstance;                                \
             }                                                                \
                                                                              \
@@ -110,11 +113,11 @@
     __ACCESS_SPECIFIER__:                                                                                                 \
         __MEMBER_TYPE__* Get##__MEMBER_NAME__##Ptr()                                                                      \
         {                                                                                                                 \
-            return GetDynamicMember_##__MEMBER_NAME__()->ContainerPtrToValuePtr<__MEMBER_TYPE__>(this);                   \
+            return CachedMemberOffset_##__MEMBER_NAME__ >= 0 ? FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__) : nullptr; \
         }                                                                                                                 \
         const __MEMBER_TYPE__* Get##__MEMBER_NAME__##Ptr() const                                                          \
         {                                                                                                                 \
-            return GetDynamicMember_##__MEMBER_NAME__()->ContainerPtrToValuePtr<__MEMBER_TYPE__>(this);                   \
+            return CachedMemberOffset_##__MEMBER_NAME__ >= 0 ? FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__) : nullptr; \
         }                                                                                                                 \
 
 #define DEFINE_OPTIONAL_TYPE_MEMBER( __MEMBER_TYPE__, __MEMBER_NAME__, ... ) \
@@ -131,11 +134,11 @@
     __ACCESS_SPECIFIER__:                                                                                             \
         __MEMBER_TYPE__& Get##__MEMBER_NAME__()                                                                       \
         {                                                                                                             \
-            return *GetDynamicMember_##__MEMBER_NAME__()->ContainerPtrToValuePtr<__MEMBER_TYPE__>(this);              \
+            return *FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__);              \
         }                                                                                                             \
         const __MEMBER_TYPE__& Get##__MEMBER_NAME__() const                                                           \
         {                                                                                                             \
-            return *GetDynamicMember_##__MEMBER_NAME__()->ContainerPtrToValuePtr<__MEMBER_TYPE__>(this);              \
+            return *FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__);              \
         }                                                                                                             \
 
 #define DEFINE_TYPE_MEMBER_BY_VAL_FULL( __ACCESS_SPECIFIER__, __MEMBER_CLASS__, __MEMBER_TYPE__, __MEMBER_NAME__, ... ) \
@@ -143,11 +146,11 @@
     __ACCESS_SPECIFIER__:                                                                                             \
         __MEMBER_TYPE__ Get##__MEMBER_NAME__() const                                                                  \
         {                                                                                                             \
-            return *GetDynamicMember_##__MEMBER_NAME__()->ContainerPtrToValuePtr<__MEMBER_TYPE__>(this);              \
+            return *FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__);              \
         }                                                                                                             \
         void Set##__MEMBER_NAME__(__MEMBER_TYPE__ InNewValue)                                                         \
         {                                                                                                             \
-            *GetDynamicMember_##__MEMBER_NAME__()->ContainerPtrToValuePtr<__MEMBER_TYPE__>(this) = InNewValue;        \
+            *FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__) = InNewValue;        \
         }                                                                                                             \
 
 #define DEFINE_TYPE_MEMBER_REF( __MEMBER_TYPE__, __MEMBER_NAME__, ... ) \
@@ -168,6 +171,63 @@
 #define DEFINE_TYPE_MEMBER_VAL_PROTECTED( __MEMBER_TYPE__, __MEMBER_NAME__, ... ) \
     DEFINE_TYPE_MEMBER_BY_VAL_FULL( protected, FDynamicTypeMember, __MEMBER_TYPE__, __MEMBER_NAME__, false )
 
+/// Declares a fixed-size array member. Generates accessors for the pointer to the first element and for the element at the index
+#define DEFINE_TYPE_MEMBER_ARRAY_FULL( __ACCESS_SPECIFIER__, __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ ) \
+        DEFINE_DYNAMIC_TYPE_MEMBER( FDynamicTypeMember, __MEMBER_NAME__, StaticMemberType<__MEMBER_TYPE__>( DTL_TEXT( #__MEMBER_TYPE__ ) ), false, __ARRAY_DIM__ ) \
+    __ACCESS_SPECIFIER__:                                                                                             \
+        static constexpr int32_t __MEMBER_NAME__##Num = __ARRAY_DIM__;                                                \
+        __MEMBER_TYPE__* Get##__MEMBER_NAME__()                                                                       \
+        {                                                                                                             \
+            return FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__); \
+        }                                                                                                             \
+        const __MEMBER_TYPE__* Get##__MEMBER_NAME__() const                                                           \
+        {                                                                                                             \
+            return FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__); \
+        }                                                                                                             \
+        __MEMBER_TYPE__& Get##__MEMBER_NAME__(const int32_t ArrayIndex)                                               \
+        {                                                                                                             \
+            return Get##__MEMBER_NAME__()[ArrayIndex];                                                                \
+        }                                                                                                             \
+        const __MEMBER_TYPE__& Get##__MEMBER_NAME__(const int32_t ArrayIndex) const                                   \
+        {                                                                                                             \
+            return Get##__MEMBER_NAME__()[ArrayIndex];                                                                \
+        }                                                                                                             \
+
+/// Declares the variable-length array at the end of the type. Number of elements is chosen when the instance is constructed with WithTrailingArray
+#define DEFINE_TYPE_MEMBER_TRAILING_ARRAY_FULL( __ACCESS_SPECIFIER__, __MEMBER_TYPE__, __MEMBER_NAME__ ) \
+        DEFINE_DYNAMIC_TYPE_MEMBER( FDynamicTypeMember, __MEMBER_NAME__, StaticMemberType<__MEMBER_TYPE__>( DTL_TEXT( #__MEMBER_TYPE__ ) ), false, FDynamicTypeMember::TrailingArrayDim ) \
+    __ACCESS_SPECIFIER__:                                                                                             \
+        __MEMBER_TYPE__* Get##__MEMBER_NAME__()                                                                       \
+        {                                                                                                             \
+            return FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__); \
+        }                                                                                                             \
+        const __MEMBER_TYPE__* Get##__MEMBER_NAME__() const                                                           \
+        {                                                                                                             \
+            return FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<__MEMBER_TYPE__>(this, CachedMemberOffset_##__MEMBER_NAME__); \
+        }                                                                                                             \
+        size_t Get##__MEMBER_NAME__##Num() const                                                                      \
+        {                                                                                                             \
+            return StaticType()->GetTrailingArrayNum(this);                                                           \
+        }                                                                                                             \
+
+#define DEFINE_TYPE_MEMBER_ARRAY( __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ ) \
+    DEFINE_TYPE_MEMBER_ARRAY_FULL( public, __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ )
+
+#define DEFINE_TYPE_MEMBER_ARRAY_PRIVATE( __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ ) \
+    DEFINE_TYPE_MEMBER_ARRAY_FULL( private, __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ )
+
+#define DEFINE_TYPE_MEMBER_ARRAY_PROTECTED( __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ ) \
+    DEFINE_TYPE_MEMBER_ARRAY_FULL( protected, __MEMBER_TYPE__, __MEMBER_NAME__, __ARRAY_DIM__ )
+
+#define DEFINE_TYPE_MEMBER_TRAILING_ARRAY( __MEMBER_TYPE__, __MEMBER_NAME__ ) \
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY_FULL( public, __MEMBER_TYPE__, __MEMBER_NAME__ )
+
+#define DEFINE_TYPE_MEMBER_TRAILING_ARRAY_PRIVATE( __MEMBER_TYPE__, __MEMBER_NAME__ ) \
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY_FULL( private, __MEMBER_TYPE__, __MEMBER_NAME__ )
+
+#define DEFINE_TYPE_MEMBER_TRAILING_ARRAY_PROTECTED( __MEMBER_TYPE__, __MEMBER_NAME__ ) \
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY_FULL( protected, __MEMBER_TYPE__, __MEMBER_NAME__ )
+
 #define PASTE_VIRTUAL_FUNCTION_ARGUMENTS_DECL_()
 #define PASTE_VIRTUAL_FUNCTION_ARGUMENTS_DECL_1(Type1, Value1) Type1 Value1
 #define PASTE_VIRTUAL_FUNCTION_ARGUMENTS_DECL_2(Type1, Value1, Type2, Value2) Type1 Value1, Type2 Value2
@@ -194,7 +254,7 @@
         TMemberVirtualFunctionReturnTypeProvider<__RETURN_TYPE__>::ReturnValueType __VIRTUAL_FUNCTION_NAME__(PASTE_VIRTUAL_FUNCTION_ARGUMENTS_DECL(__VA_ARGS__)) __FUNCTION_MODIFIERS__ \
         { \
             static FDynamicTypeVirtualFunction* StaticVirtualFunction = GetDynamicVirtualFunction_##__VIRTUAL_FUNCTION_NAME__(); \
-            GenericFunctionPtr VirtualFunctionPointer = StaticVirtualFunction->ContainerPtrToVirtualFunctionPtr(this); \
+            GenericFunctionPtr VirtualFunctionPointer = ResolveDynamicVirtualFunction<ThisClass>(StaticVirtualFunction, this); \
             if constexpr(!std::is_void_v<__RETURN_TYPE__>) \
             { \
                 return TMemberVirtualFunctionInvoker<decltype(&ThisClass::__VIRTUAL_FUNCTION_NAME__)>::Invoke(VirtualFunctionPointer, this __VA_OPT__(,) PASTE_VIRTUAL_FUNCTION_ARGUMENTS(__VA_ARGS__)); \
@@ -203,6 +263,16 @@
             { \
                 TMemberVirtualFunctionInvoker<decltype(&ThisClass::__VIRTUAL_FUNCTION_NAME__)>::Invoke(VirtualFunctionPointer, this __VA_OPT__(,) PASTE_VIRTUAL_FUNCTION_ARGUMENTS(__VA_ARGS__)); \
             } \
+        } \
+        /** Variant for functions returning dynamic types. Constructs the return value into the provided storage instead of allocating it, and returns the pointer to it */ \
+        /** Function type is a template parameter so that the invoker is only looked up when the variant is used. Other invokers have no InvokeInto */ \
+        template<typename InReturnValueType = __RETURN_TYPE__, typename InFunctionType = decltype(&ThisClass::__VIRTUAL_FUNCTION_NAME__)> \
+        requires(TIsDynamicTypeValue<InReturnValueType>) \
+        InReturnValueType* __VIRTUAL_FUNCTION_NAME__##Into(InReturnValueType* ReturnValueStorage __VA_OPT__(,) PASTE_VIRTUAL_FUNCTION_ARGUMENTS_DECL(__VA_ARGS__)) __FUNCTION_MODIFIERS__ \
+        { \
+            static FDynamicTypeVirtualFunction* StaticVirtualFunction = GetDynamicVirtualFunction_##__VIRTUAL_FUNCTION_NAME__(); \
+            GenericFunctionPtr VirtualFunctionPointer = ResolveDynamicVirtualFunction<ThisClass>(StaticVirtualFunction, this); \
+            return TMemberVirtualFunctionInvoker<InFunctionType>::InvokeInto(VirtualFunctionPointer, this, ReturnValueStorage __VA_OPT__(,) PASTE_VIRTUAL_FUNCTION_ARGUMENTS(__VA_ARGS__)); \
         }
 
 #define DEFINE_VIRTUAL_FUNCTION( __VIRTUAL_FUNCTION_NAME__, __RETURN_TYPE__, ... ) DEFINE_VIRTUAL_FUNCTION_FULL(public, , __VIRTUAL_FUNCTION_NAME__, __RETURN_TYPE__, __VA_ARGS__)
@@ -212,15 +282,48 @@
 #define DEFINE_CONST_VIRTUAL_FUNCTION_PRIVATE( __VIRTUAL_FUNCTION_NAME__, __RETURN_TYPE__, ... ) DEFINE_VIRTUAL_FUNCTION_FULL(private, const, __VIRTUAL_FUNCTION_NAME__, __RETURN_TYPE__, __VA_ARGS__)
 #define DEFINE_CONST_VIRTUAL_FUNCTION_PROTECTED( __VIRTUAL_FUNCTION_NAME__, __RETURN_TYPE__, ... ) DEFINE_VIRTUAL_FUNCTION_FULL(protected, const, __VIRTUAL_FUNCTION_NAME__, __RETURN_TYPE__, __VA_ARGS__)
 
+#define DTL_CONCAT_INNER( __A__, __B__ ) __A__##__B__
+#define DTL_CONCAT( __A__, __B__ ) DTL_CONCAT_INNER( __A__, __B__ )
+
+#if DTL_EAGER_TYPE_REGISTRATION
+/// Registers the type during the static initialization, so that it can be found by name and initialized by FDynamicTypeRegistry::InitializeAllTypes before it is first used
+#define REGISTER_DYNAMIC_TYPE_ON_STARTUP( __TYPE_NAME__ ) \
+    [[maybe_unused]] static const bool DTL_CONCAT( bRegisteredDynamicType_, __LINE__ ) = ( __TYPE_NAME__::GetPrivateStaticType(), true );
+#else
+#define REGISTER_DYNAMIC_TYPE_ON_STARTUP( __TYPE_NAME__ )
+#endif
+
 #define IMPLEMENT_DYNAMIC_TYPE_FULL( __DYNAMIC_TYPE_CLASS__, __TYPE_NAME__, ... ) \
-    IDynamicTypeLayout* __TYPE_NAME__::StaticType()                            \
+    IDynamicTypeLayout* __TYPE_NAME__::GetPrivateStaticType()                  \
     {                                                                             \
-        static std::unique_ptr<TypeImplClass> PrivateStaticType = ConstructPrivateStaticType<__DYNAMIC_TYPE_CLASS__>(StaticTypeName(), ParentClass::StaticType(), &__TYPE_NAME__::CollectDynamicMembers, __VA_ARGS__); \                                                        \
+        static std::unique_ptr<__DYNAMIC_TYPE_CLASS__> PrivateStaticType = ConstructPrivateStaticType<__DYNAMIC_TYPE_CLASS__>(StaticTypeName(), ParentClass::GetPrivateStaticType(), &__TYPE_NAME__::CollectDynamicMembers __VA_OPT__(,) __VA_ARGS__); \
         return PrivateStaticType.get();                                                 \
-    }
+    }                                                                             \
+    IDynamicTypeLayout* __TYPE_NAME__::StaticType()                            \
+    {                                                                             \
+        IDynamicTypeLayout* DynamicType = GetPrivateStaticType();                 \
+        DynamicType->EnsureInitialized();                                         \
+        return DynamicType;                                                       \
+    }                                                                             \
+    REGISTER_DYNAMIC_TYPE_ON_STARTUP( __TYPE_NAME__ )
 
+/// Implements the dynamic type with the members laid out in the order of declaration, which is what AutoTypeLayout does
 #define IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL( __TYPE_NAME__ ) \
-    IMPLEMENT_DYNAMIC_TYPE_FULL( FSequentialLayoutDynamicType, __TYPE_NAME__, 0 )
+    IMPLEMENT_DYNAMIC_TYPE_FULL( AutoTypeLayout, __TYPE_NAME__ )
 
+/// Implements the dynamic type describing the type of the foreign binary, with the layout taken from FExternalLayoutManifest. See FExternalLayoutDynamicType
 #define IMPLEMENT_DYNAMIC_TYPE_EXTERNAL( __TYPE_NAME__ ) \
-    IMPLEMENT_DYNAMIC_TYPE_FULL( FExternalLayoutDynamicType, __TYPE_NAME__, 0 )
+    IMPLEMENT_DYNAMIC_TYPE_FULL( FExternalLayoutDynamicType, __TYPE_NAME__ )
+
+/// Implements the dynamic type whose instances, and instances of it's child types, store the pointer to their most derived type
+#define IMPLEMENT_DYNAMIC_TYPE_WITH_TYPE_HEADER( __TYPE_NAME__ ) \
+    IMPLEMENT_DYNAMIC_TYPE_FULL( AutoTypeLayout, __TYPE_NAME__, EAutoTypeLayoutFlags::InstanceTypeHeader )
+
+/// Implements the dynamic type that cannot have child types. The class must be declared final, which lets the virtual functions it declares be called without reading the instance
+#define IMPLEMENT_DYNAMIC_TYPE_FINAL( __TYPE_NAME__ ) \
+    static_assert( std::is_final_v<__TYPE_NAME__>, "Final dynamic types must be declared with the final specifier" ); \
+    IMPLEMENT_DYNAMIC_TYPE_FULL( AutoTypeLayout, __TYPE_NAME__, EAutoTypeLayoutFlags::Final )
+
+/// Implements the dynamic type with the layout that reorders the members to minimize padding. See PackedTypeLayout
+#define IMPLEMENT_DYNAMIC_TYPE_PACKED( __TYPE_NAME__ ) \
+    IMPLEMENT_DYNAMIC_TYPE_FULL( PackedTypeLayout, __TYPE_NAME__ )
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <filesystem>
+#include "DynamicTypeDefs.h"
+#include "DynamicTypeMappedFile.h"
+
+/**
+ * Read-only array of the dynamic type instances memory-mapped from the file written by SaveToFile. Instances are used in place on the mapped pages, without constructing or copying them.
+ * File stores the schema fingerprint of the type it has been written with (see FDynamicTypeSchema), so the file can only be opened by the type with the same record layout.
+ * Only trivially copyable types can be persisted this way, since their instances are valid as raw bytes and do not own any memory outside of the record
+ */
+class DTL_API FDynamicTypeMappedArray
+{
+    FMappedFile MappedArrayFile;
+    const IDynamicTypeLayout* DynamicType{};
+    const uint8_t* Instances{};
+    size_t Stride{0};
+    size_t NumInstances{0};
+public:
+    FDynamicTypeMappedArray() = default;
+
+    /** Writes Count instances of the type laid out contiguously with the stride of the type size. Throws if the type is not trivially copyable or the file cannot be written */
+    static void SaveToFile(const std::filesystem::path& FilePath, const IDynamicTypeLayout* InDynamicType, const void* TypeInstances, size_t Count);
+
+    /**
+     * Maps the file written by SaveToFile, closing the previously opened one. Returns false if the file does not exist, is not a valid instance array,
+     * or has been written with the different record layout of the type. Throws if the type is not trivially copyable
+     */
+    bool Open(const std::filesystem::path& FilePath, const IDynamicTypeLayout* InDynamicType);
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return MappedArrayFile.IsOpen(); }
+    [[nodiscard]] const IDynamicTypeLayout* GetDynamicType() const { return DynamicType; }
+    [[nodiscard]] size_t Num() const { return NumInstances; }
+    /** Returns the first instance in the mapped file. Instances are laid out contiguously with the stride of the type size */
+    [[nodiscard]] const void* GetData() const { return Instances; }
+    [[nodiscard]] const void* GetInstance(const size_t Index) const { return Instances + Index * Stride; }
+};
+
+/** Typed view over FDynamicTypeMappedArray. Instances are accessed as const references, so the accessors of the type read the mapped pages directly */
+template<typename InDynamicType>
+class TDynamicTypeMappedArray
+{
+    FDynamicTypeMappedArray MappedArray;
+public:
+    class FConstIterator
+    {
+        const uint8_t* Instance{};
+        size_t Stride{0};
+    public:
+        FConstIterator(const void* InInstance, const size_t InStride) : Instance(static_cast<const uint8_t*>(InInstance)), Stride(InStride) {}
+
+        const InDynamicType& operator*() const { return *reinterpret_cast<const InDynamicType*>(Instance); }
+        const InDynamicType* operator->() const { return reinterpret_cast<const InDynamicType*>(Instance); }
+        FConstIterator& operator++() { Instance += Stride; return *this; }
+        bool operator==(const FConstIterator& Other) const { return Instance == Other.Instance; }
+    };
+
+    /** Writes Count instances laid out contiguously, for example the elements of DynArray */
+    static void SaveToFile(const std::filesystem::path& FilePath, const InDynamicType* TypeInstances, const size_t Count)
+    {
+        FDynamicTypeMappedArray::SaveToFile(FilePath, InDynamicType::StaticType(), TypeInstances, Count);
+    }
+
+    bool Open(const std::filesystem::path& FilePath) { return MappedArray.Open(FilePath, InDynamicType::StaticType()); }
+    void Close() { MappedArray.Close(); }
+
+    [[nodiscard]] bool IsOpen() const { return MappedArray.IsOpen(); }
+    [[nodiscard]] size_t Num() const { return MappedArray.Num(); }
+
+    const InDynamicType& operator[](const size_t Index) const { return *static_cast<const InDynamicType*>(MappedArray.GetInstance(Index)); }
+
+    FConstIterator begin() const { return FConstIterator(MappedArray.GetData(), MappedArray.GetDynamicType() ? MappedArray.GetDynamicType()->GetSize() : 0); }
+    FConstIterator end() const { return FConstIterator(MappedArray.GetInstance(MappedArray.Num()), 0); }
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include "DynamicTypeDefs.h"
+
+/**
+ * Common beginning of the headers of the files mapped by FMappedFile. Header types embed it as their first member named FileHeader,
+ * so that FMappedFile::ReadHeader can reject the files written with a different format, version or pointer size
+ */
+struct FMappedFileHeader
+{
+    uint32_t Magic{0};
+    uint32_t Version{0};
+    uint32_t PointerSize{sizeof(void*)};
+};
+
+/**
+ * Read-only memory mapping of the whole file. Pages are loaded on demand by the OS and shared between the processes mapping the same file
+ * Mapping stays valid until the object is destroyed or another file is opened. On POSIX systems the file can be replaced on disk by renaming another file over it,
+ * and the mapping keeps seeing the old contents. On Windows the file cannot be replaced or deleted while any process has it mapped
+ */
+class DTL_API FMappedFile
+{
+    const uint8_t* Data{};
+    size_t Size{0};
+public:
+    FMappedFile() = default;
+    ~FMappedFile();
+
+    FMappedFile(const FMappedFile&) = delete;
+    FMappedFile& operator=(const FMappedFile&) = delete;
+    FMappedFile(FMappedFile&& Other) noexcept;
+    FMappedFile& operator=(FMappedFile&& Other) noexcept;
+
+    /** Maps the file, closing the previously mapped one. Returns false if the file does not exist, cannot be mapped or is empty */
+    bool Open(const std::filesystem::path& FilePath);
+    /** Unmaps the file */
+    void Close();
+
+    /**
+     * Copies the header at the start of the mapped file. Returns false if the file is too small to contain it,
+     * or if it's FileHeader does not match the one of the default constructed header
+     */
+    template<typename InHeaderType>
+    bool ReadHeader(InHeaderType& OutHeader) const
+    {
+        if (Size < sizeof(InHeaderType))
+        {
+            return false;
+        }
+        std::memcpy(&OutHeader, Data, sizeof(InHeaderType));
+        const FMappedFileHeader ExpectedFileHeader = InHeaderType{}.FileHeader;
+        return OutHeader.FileHeader.Magic == ExpectedFileHeader.Magic && OutHeader.FileHeader.Version == ExpectedFileHeader.Version && OutHeader.FileHeader.PointerSize == ExpectedFileHeader.PointerSize;
+    }
+
+    [[nodiscard]] bool IsOpen() const { return Data != nullptr; }
+    [[nodiscard]] const uint8_t* GetData() const { return Data; }
+    [[nodiscard]] size_t GetSize() const { return Size; }
+};
+
+/**
+ * Replaces the file with the contents written by the callback. Contents are written to the temporary file next to it first and then renamed over the file,
+ * so the file is never observed half-written and the processes mapping the old file keep seeing it's old contents. Throws if the file cannot be written or replaced
+ */
+DTL_API void WriteFileAtomically(const std::filesystem::path& FilePath, const std::function<void(std::ostream&)>& WriteFileContents);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "DynamicTypeDefs.h"
+
+class IDynamicTypeWriter;
+class IDynamicTypeReader;
+
+/**
+ * Single member of the schema. Members of the nested dynamic types are flattened into the schema of the outer type,
+ * so the members of the nested types can evolve independently of the members of the outer type
+ */
+struct FDynamicTypeSchemaMember
+{
+    /** Hash of the path to the member: names of the type declaring it and of the member, preceded by the path of the enclosing member for the flattened nested members */
+    uint64_t MemberKey{0};
+    /** Hash of the name of the member type. Members are only carried over between the schemas if the name of their type has not changed */
+    uint64_t TypeNameHash{0};
+    int64_t Offset{0};
+    uint64_t ElementSize{0};
+    int32_t ArrayDim{1};
+    /** Traits of the member type, see EMemberTypeFlags. Only the TriviallyCopyable trait is a part of the fingerprint, since the other traits do not affect the record layout */
+    uint32_t TypeFlags{0};
+    /** Whenever the member or any of it's enclosing members is optional. Does not affect the record layout, so it is not a part of the fingerprint */
+    uint32_t bIsOptional{0};
+    uint32_t Reserved{0};
+};
+
+/**
+ * Persistent description of the fixed-size record layout of the type: the size of the record and the offsets, types and sizes of all it's members, including the ones of the parent types
+ * Schema fingerprint identifies the record layout, so records can only be read as is by the type with the same fingerprint, and have to be migrated otherwise (see FDynamicTypeMigrationPlan)
+ */
+class DTL_API FDynamicTypeSchema
+{
+    uint64_t Fingerprint{0};
+    uint64_t RecordSize{0};
+    std::vector<FDynamicTypeSchemaMember> Members;
+public:
+    FDynamicTypeSchema() = default;
+
+    /** Builds the schema of the current layout of the type, initializing it if needed. Throws for the types with a trailing array, since their records are not fixed-size */
+    static FDynamicTypeSchema FromType(const IDynamicTypeLayout* DynamicType);
+
+    /** Writes the schema into the stream, so it can be stored alongside the records */
+    void Serialize(IDynamicTypeWriter& Writer) const;
+    /** Reads the schema written by Serialize. Throws if the data is not a valid schema */
+    static FDynamicTypeSchema Deserialize(IDynamicTypeReader& Reader);
+
+    [[nodiscard]] uint64_t GetFingerprint() const { return Fingerprint; }
+    [[nodiscard]] size_t GetRecordSize() const { return static_cast<size_t>(RecordSize); }
+    [[nodiscard]] const std::vector<FDynamicTypeSchemaMember>& GetMembers() const { return Members; }
+private:
+    void AppendTypeMembers(const IDynamicTypeLayout* DynamicType, int64_t BaseOffset, uint64_t BaseMemberKey, bool bIsOptional);
+    [[nodiscard]] uint64_t CalculateFingerprint() const;
+};
+
+/**
+ * Precompiled migration of the records written with one schema to the instances of the current layout of the type
+ * Members present in both schemas are copied from their old offset to the new one, with the adjacent members coalesced into a single copy. Members missing in the old schema are left
+ * default constructed if they are optional, and fail the compilation of the plan otherwise. Members removed from the type are skipped.
+ * Only trivially copyable members can be carried over from the raw records. Optional non-trivial members are left default constructed, and required ones fail the compilation of the plan
+ */
+class DTL_API FDynamicTypeMigrationPlan
+{
+    /** Copy of the byte range from the source record to the target instance */
+    struct FMigrationStep
+    {
+        int64_t SourceOffset{0};
+        int64_t TargetOffset{0};
+        size_t Size{0};
+    };
+
+    const IDynamicTypeLayout* TargetType{};
+    uint64_t SourceFingerprint{0};
+    size_t SourceRecordSize{0};
+    std::vector<FMigrationStep> Steps;
+public:
+    /** Compiles the plan for migrating the records with the source schema to the instances of the target type. Throws if a required member of the target type is missing in the source schema, has changed it's type or is not trivially copyable */
+    FDynamicTypeMigrationPlan(const FDynamicTypeSchema& SourceSchema, const IDynamicTypeLayout* InTargetType);
+
+    /** Returns the plan for the pair of the schema and the type, compiling it on first use. Plans are cached for the lifetime of the program. Thread safe */
+    static const FDynamicTypeMigrationPlan& FindOrCompile(const FDynamicTypeSchema& SourceSchema, const IDynamicTypeLayout* TargetType);
+
+    /** Constructs Count instances of the target type in the placement storage from the source records laid out contiguously with the stride of the source record size */
+    void MigrateRecords(const void* SourceRecords, size_t Count, void* PlacementStorage) const;
+
+    [[nodiscard]] const IDynamicTypeLayout* GetTargetType() const { return TargetType; }
+    [[nodiscard]] uint64_t GetSourceFingerprint() const { return SourceFingerprint; }
+    [[nodiscard]] size_t GetSourceRecordSize() const { return SourceRecordSize; }
+};
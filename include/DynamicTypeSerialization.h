@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "DynamicTypeDefs.h"
+
+/**
+ * Destination of the binary serialization of the dynamic type instances. Serializers write trivially copyable spans of the instances directly,
+ * so implementations receive large contiguous writes and should not buffer them again unless they have to
+ */
+class DTL_API IDynamicTypeWriter
+{
+public:
+    virtual ~IDynamicTypeWriter() = default;
+
+    /** Appends Size bytes to the stream. Throws if the data cannot be written */
+    virtual void Write(const void* Data, size_t Size) = 0;
+};
+
+/** Source of the binary data written by IDynamicTypeWriter */
+class DTL_API IDynamicTypeReader
+{
+public:
+    virtual ~IDynamicTypeReader() = default;
+
+    /** Reads exactly Size bytes from the stream. Throws if there is not enough data left */
+    virtual void Read(void* Data, size_t Size) = 0;
+    /** Returns the upper bound of the number of bytes left in the stream. Used to reject corrupted element counts before allocating memory for them */
+    [[nodiscard]] virtual size_t GetRemainingSize() const { return std::numeric_limits<size_t>::max(); }
+};
+
+/** Writes into the caller-provided buffer without allocating. Throws if the buffer is too small */
+class DTL_API FDynamicTypeBufferWriter final : public IDynamicTypeWriter
+{
+    uint8_t* Buffer{};
+    size_t Capacity{0};
+    size_t Offset{0};
+public:
+    FDynamicTypeBufferWriter(void* InBuffer, const size_t InCapacity) : Buffer(static_cast<uint8_t*>(InBuffer)), Capacity(InCapacity) {}
+
+    void Write(const void* Data, const size_t Size) override
+    {
+        if (Size > Capacity - Offset)
+        {
+            throw std::runtime_error("Serialization buffer is too small");
+        }
+        std::memcpy(Buffer + Offset, Data, Size);
+        Offset += Size;
+    }
+
+    /** Returns the number of bytes written so far */
+    [[nodiscard]] size_t GetWrittenSize() const { return Offset; }
+};
+
+/** Reads from the caller-provided buffer without copying it */
+class DTL_API FDynamicTypeBufferReader final : public IDynamicTypeReader
+{
+    const uint8_t* Buffer{};
+    size_t Size{0};
+    size_t Offset{0};
+public:
+    FDynamicTypeBufferReader(const void* InBuffer, const size_t InSize) : Buffer(static_cast<const uint8_t*>(InBuffer)), Size(InSize) {}
+
+    void Read(void* Data, const size_t ReadSize) override
+    {
+        if (ReadSize > Size - Offset)
+        {
+            throw std::runtime_error("Serialized data is truncated");
+        }
+        std::memcpy(Data, Buffer + Offset, ReadSize);
+        Offset += ReadSize;
+    }
+    [[nodiscard]] size_t GetRemainingSize() const override { return Size - Offset; }
+
+    /** Returns the number of bytes read so far */
+    [[nodiscard]] size_t GetReadSize() const { return Offset; }
+};
+
+/** Counts the bytes without writing them. Used to size the buffer for FDynamicTypeBufferWriter */
+class DTL_API FDynamicTypeSizeCounter final : public IDynamicTypeWriter
+{
+    size_t Size{0};
+public:
+    void Write(const void*, const size_t WriteSize) override { Size += WriteSize; }
+
+    [[nodiscard]] size_t GetSize() const { return Size; }
+};
+
+/** Writes the number of elements of the variable-length value. Always written as 64-bit integer so the data does not depend on the platform */
+inline void WriteSerializedNum(IDynamicTypeWriter& Writer, const size_t Num)
+{
+    const uint64_t SerializedNum = Num;
+    Writer.Write(&SerializedNum, sizeof(SerializedNum));
+}
+
+/** Reads the number of elements written by WriteSerializedNum. Throws if the elements of the provided minimum size cannot fit into the rest of the stream */
+inline size_t ReadSerializedNum(IDynamicTypeReader& Reader, const size_t MinElementSize)
+{
+    uint64_t SerializedNum{};
+    Reader.Read(&SerializedNum, sizeof(SerializedNum));
+    if (MinElementSize != 0 && SerializedNum > Reader.GetRemainingSize() / MinElementSize)
+    {
+        throw std::runtime_error("Serialized element count exceeds the size of the data");
+    }
+    return static_cast<size_t>(SerializedNum);
+}
+
+/**
+ * Header of the stream of serialized instances, written by WriteDynamicTypeStreamHeader. Instances themselves carry no type information,
+ * so the header records the format version and the hash of the serialized layout of the type to detect the data written by a different layout of the type
+ */
+struct FDynamicTypeStreamHeader
+{
+    static constexpr uint32_t StreamMagic = 0x53445444; // "DTDS"
+    static constexpr uint32_t StreamVersion = 1;
+
+    uint32_t Magic{StreamMagic};
+    uint32_t Version{StreamVersion};
+    uint64_t LayoutHash{0};
+    uint64_t NumInstances{0};
+};
+
+/**
+ * Returns the hash of the serialized layout of the type: names, types and array dimensions of the serialized members of the type and it's parent types in the order they are written,
+ * including the members of the nested dynamic types. Unlike the schema fingerprint it does not depend on the member offsets, which are not a part of the serialized data
+ */
+DTL_API uint64_t HashSerializedTypeLayout(const IDynamicTypeLayout* DynamicType);
+/** Writes the stream header for Count instances of the type. Instances are written after it with SerializeTypeInstance or SerializeTypeInstances */
+DTL_API void WriteDynamicTypeStreamHeader(const IDynamicTypeLayout* DynamicType, size_t Count, IDynamicTypeWriter& Writer);
+/** Reads the stream header written by WriteDynamicTypeStreamHeader and returns the number of the instances following it. Throws if the format version or the serialized layout of the type differ */
+DTL_API size_t ReadDynamicTypeStreamHeader(const IDynamicTypeLayout* DynamicType, IDynamicTypeReader& Reader);
+
+/**
+ * Serializes the values of the statically known member type for TMemberTypeDescriptor. Trivially copyable types are written as raw bytes
+ * Can be specialized for the non-trivial member types to make the dynamic types containing them serializable. Specializations must define bIsSerializable as true
+ */
+template<typename T>
+struct TMemberTypeSerializer
+{
+    static constexpr bool bIsSerializable = std::is_trivially_copyable_v<T>;
+
+    static void Serialize(const T& Value, IDynamicTypeWriter& Writer) { Writer.Write(&Value, sizeof(T)); }
+    static void Deserialize(T& Value, IDynamicTypeReader& Reader) { Reader.Read(&Value, sizeof(T)); }
+};
+
+/** Strings are written as the number of characters followed by the characters themselves */
+template<typename CharType, typename CharTraits, typename Allocator>
+struct TMemberTypeSerializer<std::basic_string<CharType, CharTraits, Allocator>>
+{
+    static constexpr bool bIsSerializable = true;
+
+    static void Serialize(const std::basic_string<CharType, CharTraits, Allocator>& Value, IDynamicTypeWriter& Writer)
+    {
+        WriteSerializedNum(Writer, Value.size());
+        Writer.Write(Value.data(), Value.size() * sizeof(CharType));
+    }
+    static void Deserialize(std::basic_string<CharType, CharTraits, Allocator>& Value, IDynamicTypeReader& Reader)
+    {
+        Value.resize(ReadSerializedNum(Reader, sizeof(CharType)));
+        Reader.Read(Value.data(), Value.size() * sizeof(CharType));
+    }
+};
+
+/** Vectors are written as the number of elements followed by the elements. Vectors of trivially copyable elements are written with a single write */
+template<typename ElementType, typename Allocator> requires (TMemberTypeSerializer<ElementType>::bIsSerializable && !std::is_same_v<ElementType, bool>)
+struct TMemberTypeSerializer<std::vector<ElementType, Allocator>>
+{
+    static constexpr bool bIsSerializable = true;
+
+    static void Serialize(const std::vector<ElementType, Allocator>& Value, IDynamicTypeWriter& Writer)
+    {
+        WriteSerializedNum(Writer, Value.size());
+        if constexpr (std::is_trivially_copyable_v<ElementType>)
+        {
+            Writer.Write(Value.data(), Value.size() * sizeof(ElementType));
+        }
+        else
+        {
+            for (const ElementType& Element : Value)
+            {
+                TMemberTypeSerializer<ElementType>::Serialize(Element, Writer);
+            }
+        }
+    }
+    static void Deserialize(std::vector<ElementType, Allocator>& Value, IDynamicTypeReader& Reader)
+    {
+        if constexpr (std::is_trivially_copyable_v<ElementType>)
+        {
+            Value.resize(ReadSerializedNum(Reader, sizeof(ElementType)));
+            Reader.Read(Value.data(), Value.size() * sizeof(ElementType));
+        }
+        else
+        {
+            // Non-trivial elements have no known minimum size, so they are appended one by one instead of trusting the count for the allocation
+            const size_t ElementNum = ReadSerializedNum(Reader, 0);
+            Value.clear();
+            for (size_t ElementIndex = 0; ElementIndex < ElementNum; ElementIndex++)
+            {
+                TMemberTypeSerializer<ElementType>::Deserialize(Value.emplace_back(), Reader);
+            }
+        }
+    }
+};
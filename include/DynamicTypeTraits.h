@@ -1,5 +1,8 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include "DynamicTypeAllocators.h"
 #include "DynamicTypeImpl.h"
 
 template<typename T>
@@ -32,10 +35,40 @@ template<typename InMemberType>
 requires(TIsDynamicTypeValue<InMemberType>)
 IMemberTypeDescriptor* StaticMemberType(const DTL_CHAR*)
 {
-    static FDynamicMemberTypeDescriptor StaticTypeDescriptor(InMemberType::StaticType());
+    // Member type is initialized together with the type owning the member, so it is only registered here
+    static FDynamicMemberTypeDescriptor StaticTypeDescriptor(InMemberType::GetPrivateStaticType());
     return &StaticTypeDescriptor;
 }
 
+/**
+ * Returns the published virtual function table slot shared by all the instances of the final type, or nullptr if the type is not final. Child types of the final type cannot be created,
+ * so the instances of the type always point to this slot and the calls can be dispatched through it without reading the instance
+ */
+inline const GenericFunctionPtr* GetFinalTypeVirtualFunctionTableSlot(IDynamicTypeLayout* DynamicType)
+{
+    const AutoTypeLayout* AutoDynamicType = CastDynamicTypeImpl<AutoTypeLayout>(DynamicType);
+    return AutoDynamicType && AutoDynamicType->IsFinalType() ? AutoDynamicType->GetPublishedVirtualFunctionTableSlot() : nullptr;
+}
+
+/**
+ * Resolves the implementation of the virtual function called on the instance of the statically known type. Used by the thunks declared by DEFINE_VIRTUAL_FUNCTION
+ * If the class is declared final and implemented with IMPLEMENT_DYNAMIC_TYPE_FINAL, the call is resolved from the table of the type without loading the virtual function table pointer of the instance.
+ * Thunks inherited from the non-final parent types still dispatch through the instance, since they only know the type that has declared the function
+ */
+template<typename InDynamicType>
+GenericFunctionPtr ResolveDynamicVirtualFunction(const FDynamicTypeVirtualFunction* VirtualFunction, const InDynamicType* TypeInstance)
+{
+    if constexpr (std::is_final_v<InDynamicType>)
+    {
+        static const GenericFunctionPtr* FinalTypeVirtualFunctionTableSlot = GetFinalTypeVirtualFunctionTableSlot(InDynamicType::StaticType());
+        if (FinalTypeVirtualFunctionTableSlot)
+        {
+            return VirtualFunction->ResolveVirtualFunctionPtrInPublishedTable(FinalTypeVirtualFunctionTableSlot);
+        }
+    }
+    return VirtualFunction->ResolveVirtualFunctionPtr(TypeInstance);
+}
+
 /** Default no-argument constructor for dynamic types. Compiles for all dynamic types, but the dynamic type has to implement EmplaceTypeInstance */
 template<typename InDynamicType>
 void EmplaceDynamicType(InDynamicType* PlacementStorage)
@@ -44,15 +77,20 @@ void EmplaceDynamicType(InDynamicType* PlacementStorage)
     StaticType->EmplaceTypeInstance(PlacementStorage);
 }
 
-/** Default copy constructor for dynamic types. Compiles for all dynamic types, but the dynamic type has to implement CopyAssignTypeInstance */
+/** Default copy constructor for dynamic types. Compiles for all dynamic types, but the dynamic type has to implement CopyConstructTypeInstance */
 template<typename InDynamicType>
 void EmplaceDynamicType(InDynamicType* PlacementStorage, const InDynamicType& Other)
 {
     static IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+    StaticType->CopyConstructTypeInstance(PlacementStorage, &Other);
+}
 
-    // Note that this implementation is not efficient, because it constructs a new instance and then immediately overwrites it with a copy
-    StaticType->EmplaceTypeInstance(PlacementStorage);
-    StaticType->CopyAssignTypeInstance(PlacementStorage, &Other);
+/** Default move constructor for dynamic types. Compiles for all dynamic types, but the dynamic type has to implement MoveConstructTypeInstance */
+template<typename InDynamicType>
+void EmplaceDynamicType(InDynamicType* PlacementStorage, InDynamicType&& Other)
+{
+    static IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+    StaticType->MoveConstructTypeInstance(PlacementStorage, &Other);
 }
 
 /** Default copy assignment operator for dynamic types. Compiles for all dynamic types, but the dynamic type has to implement CopyAssignTypeInstance */
@@ -63,32 +101,155 @@ void AssignDynamicType(InDynamicType& DynamicType, const InDynamicType& Other)
     StaticType->CopyAssignTypeInstance(&DynamicType, &Other);
 }
 
-/** Destroys the dynamic type stored at the provided pointer */
+/** Default move assignment operator for dynamic types. Compiles for all dynamic types, but the dynamic type has to implement MoveAssignTypeInstance */
+template<typename InDynamicType>
+void AssignDynamicType(InDynamicType& DynamicType, InDynamicType&& Other)
+{
+    static IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+    StaticType->MoveAssignTypeInstance(&DynamicType, &Other);
+}
+
+/** Destroys the dynamic type stored at the provided pointer. If the type has the instance type header, the pointer can point to the instance of a child type */
 template<typename InDynamicType>
 void DestroyDynamicType(InDynamicType* InTypeStorage)
 {
     static IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-    StaticType->DestructTypeInstance(InTypeStorage);
+    StaticType->GetInstanceTypeOrSelf(InTypeStorage)->DestructTypeInstance(InTypeStorage);
 }
 
+/**
+ * Casts the instance of the dynamic type to another dynamic type, returning nullptr if the instance is not of that type
+ * Upcasts always succeed. Downcasts read the most derived type of the instance from the type header (see IDynamicTypeLayout::GetInstanceType),
+ * so they are only possible from the types that have it. Downcasting from FDynamicTypeBase is rejected at compile time since the root type never has the header,
+ * and downcasting from other types without the header returns nullptr, since the type of the instance cannot be known
+ */
+template<typename InToType, typename InFromType>
+requires(TIsDynamicTypeValue<InToType> && TIsDynamicTypeValue<std::remove_const_t<InFromType>>)
+auto* CastDynamic(InFromType* Instance)
+{
+    static_assert(std::is_same_v<InToType, FDynamicTypeBase> || !std::is_same_v<std::remove_const_t<InFromType>, FDynamicTypeBase>,
+        "Cannot downcast from FDynamicTypeBase, it does not have the instance type header. Cast from the type that has it instead");
+    using ResultType = std::conditional_t<std::is_const_v<InFromType>, const InToType, InToType>;
+    if (Instance == nullptr)
+    {
+        return static_cast<ResultType*>(nullptr);
+    }
+    // Parent types are always laid out at the start of the child types, so the pointer does not need to be adjusted. Hierarchy is known before the types are initialized
+    const IDynamicTypeLayout* FromType = std::remove_const_t<InFromType>::StaticType();
+    const IDynamicTypeLayout* ToType = InToType::GetPrivateStaticType();
+    if (FromType->IsChildOf(ToType))
+    {
+        return reinterpret_cast<ResultType*>(Instance);
+    }
+    if (!FromType->HasInstanceTypeHeader())
+    {
+        return static_cast<ResultType*>(nullptr);
+    }
+    return FromType->GetInstanceType(Instance)->IsChildOf(ToType) ? reinterpret_cast<ResultType*>(Instance) : nullptr;
+}
+
+/** Tag for constructing Dyn from an already constructed instance, taking ownership of it's memory */
+enum ETakeMemoryOwnership { TakeMemoryOwnership };
+/** Tag for constructing the instance of the dynamic type with the provided number of the trailing array elements */
+enum EWithTrailingArray { WithTrailingArray };
+/** Tag for constructing the instance by the callable that receives the uninitialized storage, e.g. a function returning the dynamic type into the provided storage */
+enum EConstructInPlace { ConstructInPlace };
+
 /**
  * Dyn is a container that holds an instance of a dynamic type allocated on the heap
  * This is the type that is used when you want to construct a value of the dynamic type, and that should be used as a constructor for a dynamic type
  * There are convenience functions defined to freely convert between raw references to the dynamic type and Dyn containers
  * However, please note that this type is an indirect container, and not a type itself.
  * Note that this type always owns the memory and the data it holds, and will release both when it goes out of scope.
+ * Memory is obtained through the allocator policy, which allows placing the instances into the slab pool of the type (FDynPoolAllocator) or the arena of the current thread (FDynArenaAllocator)
+ * Instances of the types with trailing arrays are allocated with the space for their elements, and are reallocated on assignment if the number of elements differs
  */
-template<typename InDynamicType>
+template<typename InDynamicType, typename InAllocator = FDynHeapAllocator>
 class Dyn
 {
     InDynamicType* TypeStorage{};
+
+    /** Allocates uninitialized memory for the instance of the dynamic type */
+    static InDynamicType* AllocateTypeStorage(const IDynamicTypeLayout* StaticType, const size_t InstanceSize)
+    {
+        return static_cast<InDynamicType*>(InAllocator::Allocate(StaticType, InstanceSize));
+    }
+
+    /** Allocates the memory for the instance of the provided type and lets the callable construct the instance in it. Memory is released if the callable throws */
+    template<typename InConstructFunctionType>
+    static InDynamicType* ConstructTypeStorage(const IDynamicTypeLayout* InstanceType, const size_t InstanceSize, InConstructFunctionType&& ConstructFunction)
+    {
+        InDynamicType* NewTypeStorage = AllocateTypeStorage(InstanceType, InstanceSize);
+        try
+        {
+            std::forward<InConstructFunctionType>(ConstructFunction)(NewTypeStorage);
+        }
+        catch (...)
+        {
+            InAllocator::Free(InstanceType, NewTypeStorage, InstanceSize);
+            throw;
+        }
+        return NewTypeStorage;
+    }
+
+    /** Destroys the held instance and releases it's memory, leaving this container in a null-state */
+    void Reset()
+    {
+        if (TypeStorage)
+        {
+            const IDynamicTypeLayout* InstanceType = GetInstanceType(TypeStorage);
+            const size_t InstanceSize = InstanceType->GetTypeInstanceSize(TypeStorage);
+            InstanceType->DestructTypeInstance(TypeStorage);
+            InAllocator::Free(InstanceType, TypeStorage, InstanceSize);
+            TypeStorage = nullptr;
+        }
+    }
+
+    /** Returns the most derived type of the instance. Types without the instance type header are always of the static type of the container */
+    static const IDynamicTypeLayout* GetInstanceType(const InDynamicType* Instance)
+    {
+        return InDynamicType::StaticType()->GetInstanceTypeOrSelf(Instance);
+    }
+
+    /** Returns true if the held instance can be assigned the other instance in place. Instances of different types or with different number of trailing array elements have different sizes */
+    bool CanAssignInPlace(const IDynamicTypeLayout* OtherInstanceType, const InDynamicType& Other) const
+    {
+        return TypeStorage && GetInstanceType(TypeStorage) == OtherInstanceType &&
+            (!OtherInstanceType->HasTrailingArray() || OtherInstanceType->GetTrailingArrayNum(TypeStorage) == OtherInstanceType->GetTrailingArrayNum(&Other));
+    }
 public:
+    using AllocatorType = InAllocator;
+
     /** Constructs a new default-initialized instance of the dynamic type */
     Dyn()
     {
         const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-        TypeStorage = malloc(StaticType->GetSize());
-        StaticType->EmplaceTypeInstance(TypeStorage);
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSize(), [&](InDynamicType* NewTypeStorage) { StaticType->EmplaceTypeInstance(NewTypeStorage); });
+    }
+
+    /** Constructs a new instance of the dynamic type with the provided number of default-initialized trailing array elements */
+    template<std::integral InNumType>
+    Dyn(EWithTrailingArray, const InNumType InTrailingArrayNum)
+    {
+        const size_t TrailingArrayNum = static_cast<size_t>(InTrailingArrayNum);
+        const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSizeWithTrailingArray(TrailingArrayNum), [&](InDynamicType* NewTypeStorage)
+        {
+            StaticType->EmplaceTypeInstanceWithTrailingArray(NewTypeStorage, TrailingArrayNum);
+        });
+    }
+
+    /** Allocates the storage for the instance of the static type and lets the callable construct the instance in it. Storage is released if the callable throws */
+    template<typename InConstructFunctionType>
+    Dyn(EConstructInPlace, InConstructFunctionType&& ConstructFunction)
+    {
+        const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSize(), std::forward<InConstructFunctionType>(ConstructFunction));
+    }
+
+    /** Takes ownership of the already constructed instance. Memory must have been allocated with the allocator policy of this Dyn */
+    Dyn(InDynamicType* InTypeStorage, ETakeMemoryOwnership) : TypeStorage(InTypeStorage)
+    {
     }
 
     /** Move constructor for Dyn instance. Leaves other type in an invalid null-state */
@@ -101,37 +262,53 @@ public:
     /** Destructor for Dyn. Will call the destructor of the underlying type and free the memory */
     ~Dyn()
     {
-        if (TypeStorage)
-        {
-            DestroyDynamicType(TypeStorage);
-            free(TypeStorage);
-        }
+        Reset();
     }
 
-    /** Copy constructor for the Dyn instance */
-    Dyn(const Dyn& Other) : Dyn()
+    /** Copy constructor for the Dyn instance. Copy of the Dyn in a null-state is also in a null-state */
+    Dyn(const Dyn& Other)
     {
         if (Other.TypeStorage)
         {
-            const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-            StaticType->CopyAssignTypeInstance(TypeStorage, Other.TypeStorage);
+            const IDynamicTypeLayout* InstanceType = GetInstanceType(Other.TypeStorage);
+            TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(Other.TypeStorage), [&](InDynamicType* NewTypeStorage)
+            {
+                InstanceType->CopyConstructTypeInstance(NewTypeStorage, Other.TypeStorage);
+            });
         }
     }
 
     /** Constructs a Dyn instance from the raw reference to the dynamic type */
-    Dyn(const InDynamicType& Other) : Dyn()
+    Dyn(const InDynamicType& Other)
     {
-        const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-        StaticType->CopyAssignTypeInstance(TypeStorage, &Other);
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewTypeStorage)
+        {
+            InstanceType->CopyConstructTypeInstance(NewTypeStorage, &Other);
+        });
+    }
+
+    /** Constructs a Dyn instance by moving the contents of the raw reference to the dynamic type into it */
+    Dyn(InDynamicType&& Other)
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewTypeStorage)
+        {
+            InstanceType->MoveConstructTypeInstance(NewTypeStorage, &Other);
+        });
     }
 
-    /** Constructs a Dyn instance using the dynamic type-defined constructor */
+    /** Constructs a Dyn instance using the dynamic type-defined constructor. Copies from another instance or Dyn are handled by the constructors above */
     template<typename... InArgumentTypes>
-    explicit Dyn(InArgumentTypes... InArgs)
+    requires(!(sizeof...(InArgumentTypes) == 1 && (std::is_same_v<std::remove_cvref_t<InArgumentTypes>, InDynamicType> || ...)) &&
+        !(sizeof...(InArgumentTypes) == 1 && (std::is_same_v<std::remove_cvref_t<InArgumentTypes>, Dyn> || ...)))
+    explicit Dyn(InArgumentTypes&&... InArgs)
     {
         const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-        TypeStorage = malloc(StaticType->GetSize());
-        EmplaceDynamicType<InDynamicType>(TypeStorage, std::forward<InArgumentTypes>(InArgs...));
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSize(), [&](InDynamicType* NewTypeStorage)
+        {
+            EmplaceDynamicType<InDynamicType>(NewTypeStorage, std::forward<InArgumentTypes>(InArgs)...);
+        });
     }
 
     /** Move assignment operator. Will use swap semantics for the move */
@@ -141,24 +318,58 @@ public:
         return *this;
     }
 
-    /** Copy assignment operator */
+    /** Copy assignment operator. If this Dyn is in a null-state, it will be copy constructed instead */
     Dyn& operator=(const Dyn& Other)
     {
-        if (TypeStorage && Other.TypeStorage)
+        if (Other.TypeStorage)
         {
-            const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-            StaticType->CopyAssignTypeInstance(TypeStorage, Other.TypeStorage);
+            *this = *Other.TypeStorage;
         }
         return *this;
     }
 
-    /** Copy assignment operator for raw reference to a dynamic type */
+    /**
+     * Copy assignment operator for raw reference to a dynamic type. If this Dyn is in a null-state, it will be copy constructed instead
+     * Instance of a different type or size is constructed before the held one is released, so this Dyn keeps the held instance if the construction throws
+     */
     Dyn& operator=(const InDynamicType& Other)
     {
-        if (TypeStorage)
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        if (CanAssignInPlace(InstanceType, Other))
+        {
+            InstanceType->CopyAssignTypeInstance(TypeStorage, &Other);
+        }
+        else
+        {
+            InDynamicType* NewTypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewInstance)
+            {
+                InstanceType->CopyConstructTypeInstance(NewInstance, &Other);
+            });
+            Reset();
+            TypeStorage = NewTypeStorage;
+        }
+        return *this;
+    }
+
+    /**
+     * Move assignment operator for raw reference to a dynamic type. If this Dyn is in a null-state, it will be move constructed instead
+     * Instance of a different type or size is constructed before the held one is released, so this Dyn keeps the held instance if the construction throws
+     */
+    Dyn& operator=(InDynamicType&& Other)
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        if (CanAssignInPlace(InstanceType, Other))
+        {
+            InstanceType->MoveAssignTypeInstance(TypeStorage, &Other);
+        }
+        else
         {
-            const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
-            StaticType->CopyAssignTypeInstance(TypeStorage, &Other);
+            InDynamicType* NewTypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewInstance)
+            {
+                InstanceType->MoveConstructTypeInstance(NewInstance, &Other);
+            });
+            Reset();
+            TypeStorage = NewTypeStorage;
         }
         return *this;
     }
@@ -190,6 +401,286 @@ public:
     const InDynamicType* operator->() const { return TypeStorage; }
 };
 
+/**
+ * Hashes the instances of the dynamic type with the layout of their most derived type (see IDynamicTypeLayout::HashTypeInstance)
+ * Together with TDynamicTypeEqualTo, allows using Dyn and the references to the dynamic types as the keys of the unordered containers
+ */
+template<typename InDynamicType>
+struct TDynamicTypeHash
+{
+    size_t operator()(const InDynamicType& Instance) const
+    {
+        return static_cast<size_t>(InDynamicType::StaticType()->GetInstanceTypeOrSelf(&Instance)->HashTypeInstance(&Instance));
+    }
+};
+
+/** Compares the instances of the dynamic type with the layout of their most derived type. Instances of different types are never equal */
+template<typename InDynamicType>
+struct TDynamicTypeEqualTo
+{
+    bool operator()(const InDynamicType& InstanceA, const InDynamicType& InstanceB) const
+    {
+        const IDynamicTypeLayout* InstanceType = InDynamicType::StaticType()->GetInstanceTypeOrSelf(&InstanceA);
+        return InstanceType == InDynamicType::StaticType()->GetInstanceTypeOrSelf(&InstanceB) && InstanceType->EqualsTypeInstance(&InstanceA, &InstanceB);
+    }
+};
+
+/**
+ * InlineDyn is a variant of Dyn that places the instance of the dynamic type into the buffer inside of the container when it fits
+ * Types that are larger than InInlineSize or require larger alignment than the buffer has fall back to the allocator policy, same as Dyn
+ * This allows small dynamic types to live on the stack or inside other containers without an allocation
+ * Note that unlike Dyn, moving the InlineDyn holding an inline instance has to move the instance itself, so prefer Dyn for large types that are moved often
+ * Since the move constructor of the type can throw, moving the InlineDyn is not noexcept, and standard containers of InlineDyn copy the elements instead of moving them when they grow
+ * Instances with trailing arrays are placed inline when the fixed part and all of the elements fit into the buffer
+ */
+template<typename InDynamicType, size_t InInlineSize = 64, typename InAllocator = FDynHeapAllocator>
+class InlineDyn
+{
+    static constexpr size_t InlineStorageAlignment = alignof(std::max_align_t);
+
+    alignas(InlineStorageAlignment) uint8_t InlineStorage[InInlineSize];
+    /** Points either to the inline storage or to the memory obtained from the allocator policy */
+    InDynamicType* TypeStorage{};
+
+    /** Returns true if the instance of the type of the provided size fits into the inline storage */
+    static bool FitsInlineStorage(const IDynamicTypeLayout* StaticType, const size_t InstanceSize)
+    {
+        return InstanceSize <= InInlineSize && StaticType->GetMinAlignment() <= InlineStorageAlignment;
+    }
+
+    /** Allocates uninitialized memory for the instance of the dynamic type, preferring the inline storage */
+    InDynamicType* AllocateTypeStorage(const IDynamicTypeLayout* StaticType, const size_t InstanceSize)
+    {
+        if (FitsInlineStorage(StaticType, InstanceSize))
+        {
+            return reinterpret_cast<InDynamicType*>(InlineStorage);
+        }
+        return static_cast<InDynamicType*>(InAllocator::Allocate(StaticType, InstanceSize));
+    }
+
+    /** Allocates the storage for the instance of the provided type, preferring the inline storage, and lets the callable construct the instance in it. Memory is released if the callable throws */
+    template<typename InConstructFunctionType>
+    InDynamicType* ConstructTypeStorage(const IDynamicTypeLayout* InstanceType, const size_t InstanceSize, InConstructFunctionType&& ConstructFunction)
+    {
+        InDynamicType* NewTypeStorage = AllocateTypeStorage(InstanceType, InstanceSize);
+        try
+        {
+            std::forward<InConstructFunctionType>(ConstructFunction)(NewTypeStorage);
+        }
+        catch (...)
+        {
+            if (NewTypeStorage != reinterpret_cast<InDynamicType*>(InlineStorage))
+            {
+                InAllocator::Free(InstanceType, NewTypeStorage, InstanceSize);
+            }
+            throw;
+        }
+        return NewTypeStorage;
+    }
+
+    /** Returns the most derived type of the instance. Types without the instance type header are always of the static type of the container */
+    static const IDynamicTypeLayout* GetInstanceType(const InDynamicType* Instance)
+    {
+        return InDynamicType::StaticType()->GetInstanceTypeOrSelf(Instance);
+    }
+
+    /** Returns true if the held instance can be assigned the other instance in place. Instances of different types or with different number of trailing array elements have different sizes */
+    bool CanAssignInPlace(const IDynamicTypeLayout* OtherInstanceType, const InDynamicType& Other) const
+    {
+        return TypeStorage && GetInstanceType(TypeStorage) == OtherInstanceType &&
+            (!OtherInstanceType->HasTrailingArray() || OtherInstanceType->GetTrailingArrayNum(TypeStorage) == OtherInstanceType->GetTrailingArrayNum(&Other));
+    }
+
+    /** Destroys the held instance and releases it's memory, leaving this container in a null-state */
+    void Reset()
+    {
+        if (TypeStorage)
+        {
+            const IDynamicTypeLayout* InstanceType = GetInstanceType(TypeStorage);
+            const size_t InstanceSize = InstanceType->GetTypeInstanceSize(TypeStorage);
+            InstanceType->DestructTypeInstance(TypeStorage);
+            if (!IsInline())
+            {
+                InAllocator::Free(InstanceType, TypeStorage, InstanceSize);
+            }
+            TypeStorage = nullptr;
+        }
+    }
+
+    /** Takes the instance from the other container. Heap instances are stolen, inline instances are moved and destroyed in the other container */
+    void MoveFrom(InlineDyn& Other)
+    {
+        if (Other.TypeStorage && !Other.IsInline())
+        {
+            TypeStorage = Other.TypeStorage;
+            Other.TypeStorage = nullptr;
+        }
+        else if (Other.TypeStorage)
+        {
+            // Storage is only taken once the instance has been constructed, so the container stays in a null-state if the move throws
+            const IDynamicTypeLayout* InstanceType = GetInstanceType(Other.TypeStorage);
+            InstanceType->MoveConstructTypeInstance(InlineStorage, Other.TypeStorage);
+            TypeStorage = reinterpret_cast<InDynamicType*>(InlineStorage);
+            Other.Reset();
+        }
+    }
+public:
+    /** Constructs a new default-initialized instance of the dynamic type */
+    InlineDyn()
+    {
+        const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSize(), [&](InDynamicType* NewTypeStorage) { StaticType->EmplaceTypeInstance(NewTypeStorage); });
+    }
+
+    /** Constructs a new instance of the dynamic type with the provided number of default-initialized trailing array elements */
+    template<std::integral InNumType>
+    InlineDyn(EWithTrailingArray, const InNumType InTrailingArrayNum)
+    {
+        const size_t TrailingArrayNum = static_cast<size_t>(InTrailingArrayNum);
+        const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSizeWithTrailingArray(TrailingArrayNum), [&](InDynamicType* NewTypeStorage)
+        {
+            StaticType->EmplaceTypeInstanceWithTrailingArray(NewTypeStorage, TrailingArrayNum);
+        });
+    }
+
+    /** Allocates the storage for the instance of the static type, preferring the inline storage, and lets the callable construct the instance in it. Storage is released if the callable throws */
+    template<typename InConstructFunctionType>
+    InlineDyn(EConstructInPlace, InConstructFunctionType&& ConstructFunction)
+    {
+        const IDynamicTypeLayout* StaticType = InDynamicType::StaticType();
+        TypeStorage = ConstructTypeStorage(StaticType, StaticType->GetSize(), std::forward<InConstructFunctionType>(ConstructFunction));
+    }
+
+    /** Move constructor for InlineDyn instance. Leaves other type in an invalid null-state. Can throw if the instance is inline and the move constructor of it's type throws */
+    InlineDyn(InlineDyn&& Other)
+    {
+        MoveFrom(Other);
+    }
+
+    /** Destructor for InlineDyn. Will call the destructor of the underlying type and free the memory if it has been allocated */
+    ~InlineDyn()
+    {
+        Reset();
+    }
+
+    /** Copy constructor for the InlineDyn instance. Copy of the InlineDyn in a null-state is also in a null-state */
+    InlineDyn(const InlineDyn& Other)
+    {
+        if (Other.TypeStorage)
+        {
+            const IDynamicTypeLayout* InstanceType = GetInstanceType(Other.TypeStorage);
+            TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(Other.TypeStorage), [&](InDynamicType* NewTypeStorage)
+            {
+                InstanceType->CopyConstructTypeInstance(NewTypeStorage, Other.TypeStorage);
+            });
+        }
+    }
+
+    /** Constructs an InlineDyn instance from the raw reference to the dynamic type */
+    InlineDyn(const InDynamicType& Other)
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewTypeStorage)
+        {
+            InstanceType->CopyConstructTypeInstance(NewTypeStorage, &Other);
+        });
+    }
+
+    /** Constructs an InlineDyn instance by moving the contents of the raw reference to the dynamic type into it */
+    InlineDyn(InDynamicType&& Other)
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewTypeStorage)
+        {
+            InstanceType->MoveConstructTypeInstance(NewTypeStorage, &Other);
+        });
+    }
+
+    /** Move assignment operator. Leaves other type in an invalid null-state. If moving the inline instance throws, this container is left in a null-state */
+    InlineDyn& operator=(InlineDyn&& Other)
+    {
+        if (this != &Other)
+        {
+            Reset();
+            MoveFrom(Other);
+        }
+        return *this;
+    }
+
+    /** Copy assignment operator. If this InlineDyn is in a null-state, it will be copy constructed instead */
+    InlineDyn& operator=(const InlineDyn& Other)
+    {
+        if (Other.TypeStorage)
+        {
+            *this = *Other.TypeStorage;
+        }
+        return *this;
+    }
+
+    /**
+     * Copy assignment operator for raw reference to a dynamic type. If this InlineDyn is in a null-state, it will be copy constructed instead
+     * Held instance is released before the instance of a different type or size is constructed, since both might need the inline storage, so this InlineDyn is left in a null-state if the construction throws
+     */
+    InlineDyn& operator=(const InDynamicType& Other)
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        if (CanAssignInPlace(InstanceType, Other))
+        {
+            InstanceType->CopyAssignTypeInstance(TypeStorage, &Other);
+        }
+        else
+        {
+            Reset();
+            TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewTypeStorage)
+            {
+                InstanceType->CopyConstructTypeInstance(NewTypeStorage, &Other);
+            });
+        }
+        return *this;
+    }
+
+    /**
+     * Move assignment operator for raw reference to a dynamic type. If this InlineDyn is in a null-state, it will be move constructed instead
+     * Held instance is released before the instance of a different type or size is constructed, since both might need the inline storage, so this InlineDyn is left in a null-state if the construction throws
+     */
+    InlineDyn& operator=(InDynamicType&& Other)
+    {
+        const IDynamicTypeLayout* InstanceType = GetInstanceType(&Other);
+        if (CanAssignInPlace(InstanceType, Other))
+        {
+            InstanceType->MoveAssignTypeInstance(TypeStorage, &Other);
+        }
+        else
+        {
+            Reset();
+            TypeStorage = ConstructTypeStorage(InstanceType, InstanceType->GetTypeInstanceSize(&Other), [&](InDynamicType* NewTypeStorage)
+            {
+                InstanceType->MoveConstructTypeInstance(NewTypeStorage, &Other);
+            });
+        }
+        return *this;
+    }
+
+    /** Returns true if the instance is stored inside of this container, and false if it has been allocated separately or there is no instance */
+    [[nodiscard]] bool IsInline() const { return TypeStorage == reinterpret_cast<const InDynamicType*>(InlineStorage); }
+
+    /** Implicit conversion operator to the reference to a dynamic type */
+    operator InDynamicType&() { return *TypeStorage; }
+    /** Implicit conversion operator to the const reference to a dynamic type */
+    operator const InDynamicType&() const { return *TypeStorage; }
+
+    /** Returns the reference to the contained dynamic type */
+    InDynamicType& operator*() { return *TypeStorage; }
+    /** Returns the reference to the contained dynamic type */
+    const InDynamicType& operator*() const { return *TypeStorage; }
+
+    /** Returns the pointer for accessing members of the contained dynamic type */
+    InDynamicType* operator->() { return TypeStorage; }
+    /** Returns the pointer for accessing members of the contained dynamic type */
+    const InDynamicType* operator->() const { return TypeStorage; }
+};
+
 template<typename T>
 struct TMemberVirtualFunctionReturnTypeProvider
 {
@@ -252,35 +743,41 @@ struct TMemberVirtualFunctionInvoker<Dyn<TReturnType>(TReceiverType::*)(TFunctio
 {
     static Dyn<TReturnType> Invoke(GenericFunctionPtr FunctionPtr, TReceiverType* Receiver, TFunctionArguments... Arguments)
     {
-        static IDynamicTypeLayout* StaticReturnType = TReturnType::StaticType();
-        using InvokeFunctionPtr = TReturnType*(*)(TReceiverType*, TReturnType*, TFunctionArguments...);
+        // Function constructs the return value directly in the storage allocated by the returned Dyn, which releases the storage if the function throws
+        return Dyn<TReturnType>(ConstructInPlace, [&](TReturnType* ReturnValueStorage)
+        {
+            InvokeInto(FunctionPtr, Receiver, ReturnValueStorage, Arguments...);
+        });
+    }
 
-        // Allocate enough memory from the system allocator to hold the return value
-        auto* ReturnValueStorage = static_cast<TReturnType*>(malloc(StaticReturnType->GetSize()));
+    /** Constructs the return value directly into the caller-provided storage, which must be at least the size of the returned type and aligned for it */
+    static TReturnType* InvokeInto(GenericFunctionPtr FunctionPtr, TReceiverType* Receiver, TReturnType* ReturnValueStorage, TFunctionArguments... Arguments)
+    {
+        using InvokeFunctionPtr = TReturnType*(*)(TReceiverType*, TReturnType*, TFunctionArguments...);
 
         // Call the function pointer and pass it reference to the memory where return value should be written
-        reinterpret_cast<InvokeFunctionPtr>(FunctionPtr)(Receiver, ReturnValueStorage, Arguments...);
-
-        // Take the ownership of the return value storage. It has already been constructed for us and placed into the allocated memory.
-        return Dyn<TReturnType>( ReturnValueStorage, TakeMemoryOwnership );
+        return reinterpret_cast<InvokeFunctionPtr>(FunctionPtr)(Receiver, ReturnValueStorage, Arguments...);
     }
 };
-/// Implementation for dynamic-type-returning non-const member functions
+/// Implementation for dynamic-type-returning const member functions
 template<typename TReceiverType, typename TReturnType, typename... TFunctionArguments>
 struct TMemberVirtualFunctionInvoker<Dyn<TReturnType>(TReceiverType::*)(TFunctionArguments...) const>
 {
     static Dyn<TReturnType> Invoke(GenericFunctionPtr FunctionPtr, const TReceiverType* Receiver, TFunctionArguments... Arguments)
     {
-        static IDynamicTypeLayout* StaticReturnType = TReturnType::StaticType();
-        using InvokeFunctionPtr = TReturnType*(*)(const TReceiverType*, TReturnType*, TFunctionArguments...);
+        // Function constructs the return value directly in the storage allocated by the returned Dyn, which releases the storage if the function throws
+        return Dyn<TReturnType>(ConstructInPlace, [&](TReturnType* ReturnValueStorage)
+        {
+            InvokeInto(FunctionPtr, Receiver, ReturnValueStorage, Arguments...);
+        });
+    }
 
-        // Allocate enough memory from the system allocator to hold the return value
-        auto* ReturnValueStorage = static_cast<TReturnType*>(malloc(StaticReturnType->GetSize()));
+    /** Constructs the return value directly into the caller-provided storage, which must be at least the size of the returned type and aligned for it */
+    static TReturnType* InvokeInto(GenericFunctionPtr FunctionPtr, const TReceiverType* Receiver, TReturnType* ReturnValueStorage, TFunctionArguments... Arguments)
+    {
+        using InvokeFunctionPtr = TReturnType*(*)(const TReceiverType*, TReturnType*, TFunctionArguments...);
 
         // Call the function pointer and pass it reference to the memory where return value should be written
-        reinterpret_cast<InvokeFunctionPtr>(FunctionPtr)(Receiver, ReturnValueStorage, Arguments...);
-
-        // Take the ownership of the return value storage. It has already been constructed for us and placed into the allocated memory.
-        return Dyn<TReturnType>( ReturnValueStorage, TakeMemoryOwnership );
+        return reinterpret_cast<InvokeFunctionPtr>(FunctionPtr)(Receiver, ReturnValueStorage, Arguments...);
     }
 };
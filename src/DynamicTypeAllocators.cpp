@@ -0,0 +1,113 @@
+#include "DynamicTypeAllocators.h"
+#include <algorithm>
+
+FDynamicTypeSlabPool::FDynamicTypeSlabPool(const size_t InBlockSize, const size_t InBlockAlignment, const size_t InBlocksPerSlab) :
+    BlockAlignment(std::max(InBlockAlignment, alignof(void*))), BlocksPerSlab(std::max<size_t>(InBlocksPerSlab, 1))
+{
+    // Free blocks hold the pointer to the next free block, so they must be at least as large as a pointer
+    BlockSize = Align(std::max(InBlockSize, sizeof(void*)), BlockAlignment);
+}
+
+FDynamicTypeSlabPool::~FDynamicTypeSlabPool()
+{
+    for (void* Slab : Slabs)
+    {
+        ::operator delete(Slab, std::align_val_t{BlockAlignment});
+    }
+}
+
+void* FDynamicTypeSlabPool::Allocate()
+{
+    std::lock_guard Lock(PoolMutex);
+
+    // Allocate a new slab and thread all of it's blocks into the free list
+    if (FreeList == nullptr)
+    {
+        uint8_t* NewSlab = static_cast<uint8_t*>(::operator new(BlockSize * BlocksPerSlab, std::align_val_t{BlockAlignment}));
+        Slabs.push_back(NewSlab);
+
+        for (size_t BlockIndex = BlocksPerSlab; BlockIndex > 0; BlockIndex--)
+        {
+            void* Block = NewSlab + (BlockIndex - 1) * BlockSize;
+            *static_cast<void**>(Block) = FreeList;
+            FreeList = Block;
+        }
+    }
+
+    void* Block = FreeList;
+    FreeList = *static_cast<void**>(Block);
+    return Block;
+}
+
+void FDynamicTypeSlabPool::Free(void* Block)
+{
+    if (Block == nullptr)
+    {
+        return;
+    }
+    std::lock_guard Lock(PoolMutex);
+    *static_cast<void**>(Block) = FreeList;
+    FreeList = Block;
+}
+
+FDynamicTypeArena::FDynamicTypeArena(const size_t InDefaultBlockSize) : DefaultBlockSize(InDefaultBlockSize)
+{
+}
+
+FDynamicTypeArena::~FDynamicTypeArena()
+{
+    for (const FArenaBlock& Block : Blocks)
+    {
+        ::operator delete(Block.Memory);
+    }
+}
+
+void* FDynamicTypeArena::Allocate(const size_t Size, const size_t Alignment)
+{
+    // Remaining space is compared as integers, since the aligned position may be past the end of the block, and forming a pointer past it is undefined
+    uintptr_t AlignedAddress = Align(reinterpret_cast<uintptr_t>(CurrentPosition), Alignment);
+    const auto FitsCurrentBlock = [&]
+    {
+        const uintptr_t BlockEndAddress = reinterpret_cast<uintptr_t>(CurrentBlockEnd);
+        return CurrentPosition != nullptr && AlignedAddress <= BlockEndAddress && BlockEndAddress - AlignedAddress >= Size;
+    };
+    while (!FitsCurrentBlock())
+    {
+        // Move to the next block, reusing the blocks retained by Reset before allocating new ones
+        const size_t NextBlockIndex = CurrentPosition == nullptr ? 0 : CurrentBlockIndex + 1;
+        if (NextBlockIndex >= Blocks.size())
+        {
+            const size_t NewBlockSize = std::max(DefaultBlockSize, Size + Alignment);
+            Blocks.push_back(FArenaBlock{static_cast<uint8_t*>(::operator new(NewBlockSize)), NewBlockSize});
+        }
+        CurrentBlockIndex = NextBlockIndex;
+        CurrentPosition = Blocks[CurrentBlockIndex].Memory;
+        CurrentBlockEnd = CurrentPosition + Blocks[CurrentBlockIndex].Size;
+        AlignedAddress = Align(reinterpret_cast<uintptr_t>(CurrentPosition), Alignment);
+    }
+
+    uint8_t* AlignedPosition = CurrentPosition + (AlignedAddress - reinterpret_cast<uintptr_t>(CurrentPosition));
+    CurrentPosition = AlignedPosition + Size;
+    return AlignedPosition;
+}
+
+void FDynamicTypeArena::Reset()
+{
+    CurrentBlockIndex = 0;
+    CurrentPosition = nullptr;
+    CurrentBlockEnd = nullptr;
+}
+
+static thread_local FDynamicTypeArena* GCurrentDynamicTypeArena = nullptr;
+
+FDynamicTypeArena* FDynamicTypeArena::GetCurrent()
+{
+    return GCurrentDynamicTypeArena;
+}
+
+FDynamicTypeArena* FDynamicTypeArena::SetCurrent(FDynamicTypeArena* NewCurrentArena)
+{
+    FDynamicTypeArena* PreviousArena = GCurrentDynamicTypeArena;
+    GCurrentDynamicTypeArena = NewCurrentArena;
+    return PreviousArena;
+}
@@ -0,0 +1,247 @@
+#include "DynamicTypeComparison.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+static constexpr uint64_t HashPrime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t HashPrime2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t HashPrime3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t HashPrime4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t HashPrime5 = 0x27D4EB2F165667C5ull;
+
+/** Reads the unaligned word from the byte range. Instances are hashed at arbitrary member offsets, so the words are never assumed to be aligned */
+template<typename T>
+static T LoadHashWord(const uint8_t* Data)
+{
+    T Word;
+    std::memcpy(&Word, Data, sizeof(T));
+    return Word;
+}
+
+static uint64_t HashRound(const uint64_t Accumulator, const uint64_t Word)
+{
+    return std::rotl(Accumulator + Word * HashPrime2, 31) * HashPrime1;
+}
+
+static uint64_t MergeHashLane(const uint64_t Hash, const uint64_t Lane)
+{
+    return (Hash ^ HashRound(0, Lane)) * HashPrime1 + HashPrime4;
+}
+
+uint64_t HashDynamicTypeBytes(const void* Data, const size_t Size, const uint64_t Seed)
+{
+    const uint8_t* Current = static_cast<const uint8_t*>(Data);
+    const uint8_t* End = Current + Size;
+    uint64_t Hash;
+
+    if (Size >= 32)
+    {
+        // Lanes do not depend on each other, so the rounds of the different lanes execute in parallel
+        uint64_t Lanes[4] = {Seed + HashPrime1 + HashPrime2, Seed + HashPrime2, Seed, Seed - HashPrime1};
+        for (; End - Current >= 32; Current += 32)
+        {
+            for (int32_t LaneIndex = 0; LaneIndex < 4; LaneIndex++)
+            {
+                Lanes[LaneIndex] = HashRound(Lanes[LaneIndex], LoadHashWord<uint64_t>(Current + LaneIndex * 8));
+            }
+        }
+        Hash = std::rotl(Lanes[0], 1) + std::rotl(Lanes[1], 7) + std::rotl(Lanes[2], 12) + std::rotl(Lanes[3], 18);
+        for (const uint64_t Lane : Lanes)
+        {
+            Hash = MergeHashLane(Hash, Lane);
+        }
+    }
+    else
+    {
+        Hash = Seed + HashPrime5;
+    }
+    Hash += Size;
+
+    // Tail of the range that does not fill a whole block
+    for (; End - Current >= 8; Current += 8)
+    {
+        Hash = std::rotl(Hash ^ HashRound(0, LoadHashWord<uint64_t>(Current)), 27) * HashPrime1 + HashPrime4;
+    }
+    if (End - Current >= 4)
+    {
+        Hash = std::rotl(Hash ^ LoadHashWord<uint32_t>(Current) * HashPrime1, 23) * HashPrime2 + HashPrime3;
+        Current += 4;
+    }
+    for (; Current != End; Current++)
+    {
+        Hash = std::rotl(Hash ^ *Current * HashPrime5, 11) * HashPrime1;
+    }
+
+    Hash ^= Hash >> 33;
+    Hash *= HashPrime2;
+    Hash ^= Hash >> 29;
+    Hash *= HashPrime3;
+    Hash ^= Hash >> 32;
+    return Hash;
+}
+
+bool IMemberTypeDescriptor::EqualsValue(const void* DataA, const void* DataB) const
+{
+    if (!IsBitwiseComparable())
+    {
+        throw std::runtime_error("Member type does not support comparison");
+    }
+    return std::memcmp(DataA, DataB, GetMemberSize()) == 0;
+}
+
+int32_t IMemberTypeDescriptor::CompareValue(const void*, const void*) const
+{
+    throw std::runtime_error("Member type does not support ordering");
+}
+
+uint64_t IMemberTypeDescriptor::HashValue(const void* Data) const
+{
+    if (!IsBitwiseComparable())
+    {
+        throw std::runtime_error("Member type does not support hashing");
+    }
+    return HashDynamicTypeBytes(Data, GetMemberSize());
+}
+
+bool IDynamicTypeLayout::EqualsTypeInstance(const void* TypeInstanceA, const void* TypeInstanceB) const
+{
+    if (ParentType && !ParentType->EqualsTypeInstance(TypeInstanceA, TypeInstanceB))
+    {
+        return false;
+    }
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        // Unresolved optional members have no storage in the instance
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+        {
+            if (!Member->GetType()->EqualsValue(Member->ContainerPtrToValuePtr<void>(TypeInstanceA, ElementIndex), Member->ContainerPtrToValuePtr<void>(TypeInstanceB, ElementIndex)))
+            {
+                return false;
+            }
+        }
+    }
+    return !HasTrailingArray() || EqualsTrailingArray(TypeInstanceA, TypeInstanceB);
+}
+
+uint64_t IDynamicTypeLayout::HashTypeInstance(const void* TypeInstance) const
+{
+    uint64_t Hash = ParentType ? ParentType->HashTypeInstance(TypeInstance) : 0;
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+        {
+            Hash = CombineDynamicTypeHash(Hash, Member->GetType()->HashValue(Member->ContainerPtrToValuePtr<void>(TypeInstance, ElementIndex)));
+        }
+    }
+    return HasTrailingArray() ? HashTrailingArray(TypeInstance, Hash) : Hash;
+}
+
+int32_t IDynamicTypeLayout::CompareTypeInstance(const void* TypeInstanceA, const void* TypeInstanceB) const
+{
+    if (ParentType)
+    {
+        if (const int32_t ParentResult = ParentType->CompareTypeInstance(TypeInstanceA, TypeInstanceB); ParentResult != 0)
+        {
+            return ParentResult;
+        }
+    }
+    // Members are walked in the order of declaration, so the ordering does not depend on how the layout has placed them
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+        {
+            if (const int32_t MemberResult = Member->GetType()->CompareValue(Member->ContainerPtrToValuePtr<void>(TypeInstanceA, ElementIndex), Member->ContainerPtrToValuePtr<void>(TypeInstanceB, ElementIndex)); MemberResult != 0)
+            {
+                return MemberResult;
+            }
+        }
+    }
+    return HasTrailingArray() ? CompareTrailingArray(TypeInstanceA, TypeInstanceB) : 0;
+}
+
+bool IDynamicTypeLayout::EqualsTrailingArray(const void* TypeInstanceA, const void* TypeInstanceB) const
+{
+    const FDynamicTypeMember* TrailingArrayMember = GetTrailingArrayMember();
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    const size_t TrailingArrayNum = GetTrailingArrayNum(TypeInstanceA);
+
+    if (GetTrailingArrayNum(TypeInstanceB) != TrailingArrayNum)
+    {
+        return false;
+    }
+    if (TrailingArrayNum == 0)
+    {
+        return true;
+    }
+    // Elements are laid out contiguously without padding between them, so bitwise comparable elements are compared with a single memcmp
+    if (ElementType->IsBitwiseComparable())
+    {
+        return std::memcmp(TrailingArrayMember->ContainerPtrToValuePtr<void>(TypeInstanceA, 0), TrailingArrayMember->ContainerPtrToValuePtr<void>(TypeInstanceB, 0), ElementType->GetMemberSize() * TrailingArrayNum) == 0;
+    }
+    const uint8_t* TrailingArrayDataA = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstanceA);
+    const uint8_t* TrailingArrayDataB = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstanceB);
+    for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+    {
+        if (!ElementType->EqualsValue(TrailingArrayDataA + ElementIndex * ElementType->GetMemberSize(), TrailingArrayDataB + ElementIndex * ElementType->GetMemberSize()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t IDynamicTypeLayout::HashTrailingArray(const void* TypeInstance, uint64_t Hash) const
+{
+    const FDynamicTypeMember* TrailingArrayMember = GetTrailingArrayMember();
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    const size_t TrailingArrayNum = GetTrailingArrayNum(TypeInstance);
+
+    Hash = CombineDynamicTypeHash(Hash, TrailingArrayNum);
+    if (TrailingArrayNum == 0)
+    {
+        return Hash;
+    }
+    if (ElementType->IsBitwiseComparable())
+    {
+        return HashDynamicTypeBytes(TrailingArrayMember->ContainerPtrToValuePtr<void>(TypeInstance, 0), ElementType->GetMemberSize() * TrailingArrayNum, Hash);
+    }
+    const uint8_t* TrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstance);
+    for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+    {
+        Hash = CombineDynamicTypeHash(Hash, ElementType->HashValue(TrailingArrayData + ElementIndex * ElementType->GetMemberSize()));
+    }
+    return Hash;
+}
+
+int32_t IDynamicTypeLayout::CompareTrailingArray(const void* TypeInstanceA, const void* TypeInstanceB) const
+{
+    const FDynamicTypeMember* TrailingArrayMember = GetTrailingArrayMember();
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    const size_t TrailingArrayNumA = GetTrailingArrayNum(TypeInstanceA);
+    const size_t TrailingArrayNumB = GetTrailingArrayNum(TypeInstanceB);
+
+    const uint8_t* TrailingArrayDataA = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstanceA);
+    const uint8_t* TrailingArrayDataB = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstanceB);
+    const size_t CommonNum = std::min(TrailingArrayNumA, TrailingArrayNumB);
+    for (size_t ElementIndex = 0; ElementIndex < CommonNum; ElementIndex++)
+    {
+        if (const int32_t ElementResult = ElementType->CompareValue(TrailingArrayDataA + ElementIndex * ElementType->GetMemberSize(), TrailingArrayDataB + ElementIndex * ElementType->GetMemberSize()); ElementResult != 0)
+        {
+            return ElementResult;
+        }
+    }
+    return TrailingArrayNumA < TrailingArrayNumB ? -1 : (TrailingArrayNumB < TrailingArrayNumA ? 1 : 0);
+}
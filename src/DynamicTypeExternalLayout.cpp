@@ -0,0 +1,323 @@
+#include "DynamicTypeExternalLayout.h"
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+/** Header of the layout manifest file. Files written by the builds with a different format or pointer size are rejected */
+struct FManifestFileHeader
+{
+    static constexpr uint32_t ManifestFileMagic = 0x4D4C5444; // "DTLM"
+    static constexpr uint32_t ManifestFileVersion = 2;
+
+    FMappedFileHeader FileHeader{ManifestFileMagic, ManifestFileVersion};
+    uint32_t NumEntries{0};
+};
+
+/** Entry of the index following the header, sorted by the type name hash. Points to the type layout relative to the start of the file */
+struct FExternalLayoutManifest::FManifestIndexEntry
+{
+    uint64_t TypeNameHash{0};
+    uint64_t LayoutOffset{0};
+};
+
+/** Finds the layout with the provided name in the range sorted by the name hash. Hashes are unique within the range, so only the matching entry has it's name compared */
+static const FExternalMemberLayout* FindMemberLayout(const FExternalTypeLayout& TypeLayout, const FExternalMemberLayout* First, const uint32_t Num, const dtl_string_view Name)
+{
+    const uint64_t NameHash = HashDynamicTypeName(Name);
+    const FExternalMemberLayout* Last = First + Num;
+    const FExternalMemberLayout* MemberLayout = std::lower_bound(First, Last, NameHash, [](const FExternalMemberLayout& Layout, const uint64_t Hash)
+    {
+        return Layout.NameHash < Hash;
+    });
+    return MemberLayout != Last && MemberLayout->NameHash == NameHash && TypeLayout.GetMemberName(*MemberLayout) == Name ? MemberLayout : nullptr;
+}
+
+dtl_string_view FExternalTypeLayout::GetMemberName(const FExternalMemberLayout& MemberLayout) const
+{
+    // Name data itself is validated when the manifest is loaded, but the names within it are only checked when they are looked up
+    if (MemberLayout.NameOffset > NameDataLength || NameDataLength - MemberLayout.NameOffset < MemberLayout.NameLength)
+    {
+        return {};
+    }
+    return dtl_string_view(GetNameData() + MemberLayout.NameOffset, MemberLayout.NameLength);
+}
+
+const FExternalMemberLayout* FExternalTypeLayout::FindMember(const dtl_string_view Name) const
+{
+    return FindMemberLayout(*this, GetMembers(), NumMembers, Name);
+}
+
+const FExternalMemberLayout* FExternalTypeLayout::FindVirtualFunction(const dtl_string_view Name) const
+{
+    return FindMemberLayout(*this, GetVirtualFunctions(), NumVirtualFunctions, Name);
+}
+
+FExternalLayoutManifest& FExternalLayoutManifest::Get()
+{
+    static FExternalLayoutManifest LayoutManifest;
+    return LayoutManifest;
+}
+
+bool FExternalLayoutManifest::LoadFromFile(const std::filesystem::path& FilePath)
+{
+    IndexEntries = nullptr;
+    NumIndexEntries = 0;
+    if (!MappedManifestFile.Open(FilePath))
+    {
+        return false;
+    }
+    const uint8_t* FileData = MappedManifestFile.GetData();
+    const size_t FileSize = MappedManifestFile.GetSize();
+
+    FManifestFileHeader Header;
+    if (!MappedManifestFile.ReadHeader(Header) || Header.NumEntries > (FileSize - sizeof(FManifestFileHeader)) / sizeof(FManifestIndexEntry))
+    {
+        MappedManifestFile.Close();
+        return false;
+    }
+
+    // Validate all the entries once, so that the lookups can trust the file contents. Offsets within the types are validated when the types are initialized
+    const FManifestIndexEntry* LoadedIndexEntries = reinterpret_cast<const FManifestIndexEntry*>(FileData + sizeof(FManifestFileHeader));
+    for (uint32_t EntryIndex = 0; EntryIndex < Header.NumEntries; EntryIndex++)
+    {
+        const FManifestIndexEntry& IndexEntry = LoadedIndexEntries[EntryIndex];
+        if (IndexEntry.LayoutOffset % alignof(FExternalTypeLayout) != 0 || IndexEntry.LayoutOffset > FileSize || FileSize - IndexEntry.LayoutOffset < sizeof(FExternalTypeLayout))
+        {
+            MappedManifestFile.Close();
+            return false;
+        }
+        // Member layouts and the name data following them must fit into the file, and the type name must fit into the name data
+        const FExternalTypeLayout* TypeLayout = reinterpret_cast<const FExternalTypeLayout*>(FileData + IndexEntry.LayoutOffset);
+        const uint64_t RemainingSize = FileSize - IndexEntry.LayoutOffset - sizeof(FExternalTypeLayout);
+        const uint64_t MemberLayoutsSize = (static_cast<uint64_t>(TypeLayout->NumMembers) + TypeLayout->NumVirtualFunctions) * sizeof(FExternalMemberLayout);
+        if (TypeLayout->TypeNameHash != IndexEntry.TypeNameHash || MemberLayoutsSize > RemainingSize || (RemainingSize - MemberLayoutsSize) / sizeof(DTL_CHAR) < TypeLayout->NameDataLength ||
+            TypeLayout->TypeNameLength > TypeLayout->NameDataLength)
+        {
+            MappedManifestFile.Close();
+            return false;
+        }
+    }
+    IndexEntries = LoadedIndexEntries;
+    NumIndexEntries = Header.NumEntries;
+    return true;
+}
+
+void FExternalLayoutManifest::SaveToFile(const std::filesystem::path& FilePath, const std::vector<FExternalTypeLayoutDesc>& TypeLayouts)
+{
+    std::vector<FManifestIndexEntry> NewIndexEntries;
+    std::vector<uint8_t> LayoutData;
+
+    for (const FExternalTypeLayoutDesc& TypeLayoutDesc : TypeLayouts)
+    {
+        // Name data starts with the type name, followed by the names of the members and the virtual functions
+        dtl_string NameData = TypeLayoutDesc.TypeName;
+        const auto ToMemberLayouts = [&NameData](const std::vector<std::pair<dtl_string, int64_t>>& Offsets)
+        {
+            std::vector<FExternalMemberLayout> MemberLayouts;
+            MemberLayouts.reserve(Offsets.size());
+            for (const auto& [Name, Offset] : Offsets)
+            {
+                MemberLayouts.push_back(FExternalMemberLayout{HashDynamicTypeName(Name), Offset, static_cast<uint32_t>(NameData.size()), static_cast<uint32_t>(Name.size())});
+                NameData += Name;
+            }
+            std::ranges::sort(MemberLayouts, {}, &FExternalMemberLayout::NameHash);
+            if (std::ranges::adjacent_find(MemberLayouts, {}, &FExternalMemberLayout::NameHash) != MemberLayouts.end())
+            {
+                throw std::runtime_error("Layout manifest cannot describe the same member or virtual function of the type more than once");
+            }
+            return MemberLayouts;
+        };
+
+        // Member layouts are followed by the virtual function layouts, so both are written as a single array
+        std::vector<FExternalMemberLayout> MemberLayouts = ToMemberLayouts(TypeLayoutDesc.MemberOffsets);
+        const std::vector<FExternalMemberLayout> VirtualFunctionLayouts = ToMemberLayouts(TypeLayoutDesc.VirtualFunctionOffsets);
+
+        FExternalTypeLayout TypeLayout;
+        TypeLayout.TypeNameHash = HashDynamicTypeName(TypeLayoutDesc.TypeName);
+        TypeLayout.Size = TypeLayoutDesc.Size;
+        TypeLayout.Alignment = TypeLayoutDesc.Alignment;
+        TypeLayout.VirtualFunctionTableDisplacement = TypeLayoutDesc.VirtualFunctionTableDisplacement;
+        TypeLayout.NumMembers = static_cast<uint32_t>(MemberLayouts.size());
+        TypeLayout.NumVirtualFunctions = static_cast<uint32_t>(VirtualFunctionLayouts.size());
+        TypeLayout.TypeNameLength = static_cast<uint32_t>(TypeLayoutDesc.TypeName.size());
+        TypeLayout.NameDataLength = static_cast<uint32_t>(NameData.size());
+        MemberLayouts.insert(MemberLayouts.end(), VirtualFunctionLayouts.begin(), VirtualFunctionLayouts.end());
+
+        // Offsets of the layouts are relative to the start of the layout data for now, and are rebased once the size of the index is known.
+        // Name data is padded, so that the next layout starts at it's alignment
+        NewIndexEntries.push_back(FManifestIndexEntry{TypeLayout.TypeNameHash, LayoutData.size()});
+        const size_t LayoutOffset = LayoutData.size();
+        const size_t MemberLayoutsOffset = LayoutOffset + sizeof(FExternalTypeLayout);
+        const size_t NameDataOffset = MemberLayoutsOffset + MemberLayouts.size() * sizeof(FExternalMemberLayout);
+        const size_t NameDataSize = NameData.size() * sizeof(DTL_CHAR);
+        LayoutData.resize((NameDataOffset + NameDataSize + alignof(FExternalTypeLayout) - 1) / alignof(FExternalTypeLayout) * alignof(FExternalTypeLayout));
+        std::memcpy(LayoutData.data() + LayoutOffset, &TypeLayout, sizeof(FExternalTypeLayout));
+        if (!MemberLayouts.empty())
+        {
+            std::memcpy(LayoutData.data() + MemberLayoutsOffset, MemberLayouts.data(), MemberLayouts.size() * sizeof(FExternalMemberLayout));
+        }
+        if (!NameData.empty())
+        {
+            std::memcpy(LayoutData.data() + NameDataOffset, NameData.data(), NameDataSize);
+        }
+    }
+
+    std::ranges::sort(NewIndexEntries, {}, &FManifestIndexEntry::TypeNameHash);
+    if (std::ranges::adjacent_find(NewIndexEntries, {}, &FManifestIndexEntry::TypeNameHash) != NewIndexEntries.end())
+    {
+        throw std::runtime_error("Layout manifest cannot describe the same type more than once");
+    }
+
+    FManifestFileHeader Header;
+    Header.NumEntries = static_cast<uint32_t>(NewIndexEntries.size());
+    const uint64_t LayoutDataOffset = sizeof(FManifestFileHeader) + NewIndexEntries.size() * sizeof(FManifestIndexEntry);
+    for (FManifestIndexEntry& IndexEntry : NewIndexEntries)
+    {
+        IndexEntry.LayoutOffset += LayoutDataOffset;
+    }
+
+    WriteFileAtomically(FilePath, [&](std::ostream& ManifestFile)
+    {
+        ManifestFile.write(reinterpret_cast<const char*>(&Header), sizeof(FManifestFileHeader));
+        ManifestFile.write(reinterpret_cast<const char*>(NewIndexEntries.data()), static_cast<std::streamsize>(NewIndexEntries.size() * sizeof(FManifestIndexEntry)));
+        ManifestFile.write(reinterpret_cast<const char*>(LayoutData.data()), static_cast<std::streamsize>(LayoutData.size()));
+    });
+}
+
+const FExternalTypeLayout* FExternalLayoutManifest::FindTypeLayout(const dtl_string_view TypeName) const
+{
+    const uint64_t TypeNameHash = HashDynamicTypeName(TypeName);
+    const FManifestIndexEntry* IndexEnd = IndexEntries + NumIndexEntries;
+    const FManifestIndexEntry* IndexEntry = std::lower_bound(IndexEntries, IndexEnd, TypeNameHash, [](const FManifestIndexEntry& Entry, const uint64_t Hash)
+    {
+        return Entry.TypeNameHash < Hash;
+    });
+    if (IndexEntry == IndexEnd || IndexEntry->TypeNameHash != TypeNameHash)
+    {
+        return nullptr;
+    }
+    // Different type with the colliding name hash is not the one we are looking for
+    const FExternalTypeLayout* TypeLayout = reinterpret_cast<const FExternalTypeLayout*>(MappedManifestFile.GetData() + IndexEntry->LayoutOffset);
+    return TypeLayout->GetTypeName() == TypeName ? TypeLayout : nullptr;
+}
+
+uintptr_t FExternalLayoutDynamicType::StaticTypeIdToken()
+{
+    static uint8_t StaticTypeIdToken;
+    return reinterpret_cast<uintptr_t>(&StaticTypeIdToken);
+}
+
+void FExternalLayoutDynamicType::InitializeDynamicType()
+{
+    IDynamicTypeLayout::InitializeDynamicType();
+
+    // Offsets in the manifest are relative to the start of the foreign object, so the parent types have to describe the same object
+    if (ParentType && ParentType->GetSize() != 0 && CastDynamicTypeImpl<FExternalLayoutDynamicType>(ParentType) == nullptr)
+    {
+        throw std::runtime_error("External types can only derive from other external types");
+    }
+    const FExternalTypeLayout* ExternalLayout = FExternalLayoutManifest::Get().FindTypeLayout(GetTypeName());
+    if (ExternalLayout == nullptr)
+    {
+        throw std::runtime_error("Layout of the external type has not been found in the layout manifest");
+    }
+    const bool bValidAlignment = ExternalLayout->Alignment != 0 && (ExternalLayout->Alignment & (ExternalLayout->Alignment - 1)) == 0;
+    const bool bValidVirtualFunctionTable = ExternalLayout->VirtualFunctionTableDisplacement < 0 ||
+        (ExternalLayout->Size >= sizeof(GenericFunctionPtr) && static_cast<uint64_t>(ExternalLayout->VirtualFunctionTableDisplacement) <= ExternalLayout->Size - sizeof(GenericFunctionPtr));
+    if (!bValidAlignment || !bValidVirtualFunctionTable || (ParentType && ExternalLayout->Size < ParentType->GetSize()))
+    {
+        throw std::runtime_error("Layout of the external type in the layout manifest is invalid");
+    }
+    ExternalSize = static_cast<size_t>(ExternalLayout->Size);
+    ExternalAlignment = static_cast<size_t>(ExternalLayout->Alignment);
+    VirtualFunctionTableDisplacement = ExternalLayout->VirtualFunctionTableDisplacement;
+
+    for (FDynamicTypeMember* Member : TypeMembers)
+    {
+        // Foreign objects have a fixed size, there is no space for the trailing array after them
+        if (Member->IsTrailingArray())
+        {
+            throw std::runtime_error("External types cannot have a trailing array");
+        }
+        const FExternalMemberLayout* MemberLayout = ExternalLayout->FindMember(Member->GetName());
+        if (MemberLayout == nullptr)
+        {
+            if (!Member->IsOptionalMember())
+            {
+                throw std::runtime_error("Required member of the external type is missing in the layout manifest");
+            }
+            continue;
+        }
+        if (MemberLayout->Offset < 0 || static_cast<uint64_t>(MemberLayout->Offset) > ExternalSize || ExternalSize - MemberLayout->Offset < Member->GetMemberStorageSize())
+        {
+            throw std::runtime_error("Member of the external type is placed outside of the type in the layout manifest");
+        }
+        // Accessors reference the member directly in the foreign memory, so it has to be aligned within the instance, and the instance has to be aligned at least as strictly as the member
+        const size_t MemberAlignment = Member->GetType()->GetMemberAlignment();
+        if (MemberLayout->Offset % static_cast<int64_t>(MemberAlignment) != 0 || MemberAlignment > ExternalAlignment)
+        {
+            throw std::runtime_error("Member of the external type is misaligned in the layout manifest");
+        }
+        // Writing such member would overwrite the virtual function table pointer of the foreign object
+        const uint64_t MemberOffset = static_cast<uint64_t>(MemberLayout->Offset);
+        if (VirtualFunctionTableDisplacement >= 0 && MemberOffset < static_cast<uint64_t>(VirtualFunctionTableDisplacement) + sizeof(GenericFunctionPtr) &&
+            static_cast<uint64_t>(VirtualFunctionTableDisplacement) < MemberOffset + Member->GetMemberStorageSize())
+        {
+            throw std::runtime_error("Member of the external type overlaps the virtual function table pointer in the layout manifest");
+        }
+        Member->Internal_SetupMemberOffset(MemberLayout->Offset);
+    }
+
+    for (FDynamicTypeVirtualFunction* VirtualFunction : VirtualFunctions)
+    {
+        const FExternalMemberLayout* VirtualFunctionLayout = ExternalLayout->FindVirtualFunction(VirtualFunction->GetName());
+        if (VirtualFunctionLayout == nullptr || VirtualFunctionTableDisplacement < 0)
+        {
+            if (!VirtualFunction->IsOptionalVirtualFunction())
+            {
+                throw std::runtime_error("Required virtual function of the external type is missing in the layout manifest");
+            }
+            continue;
+        }
+        if (VirtualFunctionLayout->Offset < 0 || VirtualFunctionLayout->Offset % static_cast<int64_t>(sizeof(GenericFunctionPtr)) != 0)
+        {
+            throw std::runtime_error("Virtual function of the external type has an invalid offset in the layout manifest");
+        }
+        // Implementations live in the virtual function table of the foreign binary, so the functions are never devirtualized and always dispatch through the instance
+        VirtualFunction->Internal_SetupFunctionOffsetAndDisplacement(VirtualFunctionTableDisplacement, VirtualFunctionLayout->Offset);
+    }
+
+    // Nothing is known about the foreign type beyond it's members, so all operations have to go through the layout
+    TypeFlags = EMemberTypeFlags::None;
+}
+
+void FExternalLayoutDynamicType::EmplaceTypeInstance(void*) const
+{
+    throw std::runtime_error("Instances of the external types are owned by the foreign binary and cannot be constructed");
+}
+
+void FExternalLayoutDynamicType::DestructTypeInstance(void*) const
+{
+    throw std::runtime_error("Instances of the external types are owned by the foreign binary and cannot be destroyed");
+}
+
+void FExternalLayoutDynamicType::CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance) const
+{
+    if (ParentType)
+    {
+        ParentType->CopyAssignTypeInstance(DestInstance, SrcInstance);
+    }
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        // Optional members missing in the manifest have no storage in the foreign object
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+        {
+            Member->GetType()->CopyAssignValue(Member->ContainerPtrToValuePtr<void>(DestInstance, ElementIndex), Member->ContainerPtrToValuePtr<void>(SrcInstance, ElementIndex));
+        }
+    }
+}
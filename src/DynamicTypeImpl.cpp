@@ -1,19 +1,29 @@
 #include "DynamicTypeImpl.h"
+#include "DynamicTypeAllocators.h"
+#include "DynamicTypeLayoutCache.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <mutex>
 #include <stdexcept>
 
 /** Empty type is a type with no members */
 class DTL_API EmptyDynamicType : public IDynamicTypeLayout
 {
 public:
-    EmptyDynamicType(const dtl_string& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions) : IDynamicTypeLayout(InTypeName, InParentType, InTypeMembers, InVirtualFunctions) {}
+    EmptyDynamicType(const FDynamicTypeName& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions) : IDynamicTypeLayout(InTypeName, InParentType, InTypeMembers, InVirtualFunctions)
+    {
+        // Empty type has no state, so all operations on it are trivial
+        TypeFlags = EMemberTypeFlags::AllTraits;
+    }
 
     static uintptr_t StaticTypeIdToken();
     [[nodiscard]] uintptr_t GetTypeIdToken() const override { return StaticTypeIdToken(); }
-    void EmplaceTypeInstance(void* Instance, int32_t InternalFlags) const override {}
-    void DestructTypeInstance(void* Instance, int32_t InternalFlags) const override {}
-    void CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance, int32_t InternalFlags) const override {}
-    [[nodiscard]] int32_t GetSize() const override { return 0; }
-    [[nodiscard]] int32_t GetMinAlignment() const override { return 1; }
+    void EmplaceTypeInstance(void*) const override {}
+    void DestructTypeInstance(void*) const override {}
+    void CopyAssignTypeInstance(void*, const void*) const override {}
+    [[nodiscard]] size_t GetSize() const override { return 0; }
+    [[nodiscard]] size_t GetMinAlignment() const override { return 1; }
 };
 
 uintptr_t EmptyDynamicType::StaticTypeIdToken()
@@ -22,19 +32,148 @@ uintptr_t EmptyDynamicType::StaticTypeIdToken()
     return reinterpret_cast<uintptr_t>(&StaticTypeIdToken);
 }
 
-IDynamicTypeLayout* FDynamicTypeBase::StaticType()
+IDynamicTypeLayout* FDynamicTypeBase::GetPrivateStaticType()
 {
     static EmptyDynamicType EmptyDynamicType(StaticTypeName(), nullptr, {}, {});
+    [[maybe_unused]] static const bool bRegisteredEmptyDynamicType = (FDynamicTypeRegistry::Get().RegisterType(&EmptyDynamicType), true);
     return &EmptyDynamicType;
 }
 
-IDynamicTypeLayout::IDynamicTypeLayout(const dtl_string& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions)
+IDynamicTypeLayout* FDynamicTypeBase::StaticType()
+{
+    IDynamicTypeLayout* DynamicType = GetPrivateStaticType();
+    DynamicType->EnsureInitialized();
+    return DynamicType;
+}
+
+IDynamicTypeLayout::IDynamicTypeLayout(const FDynamicTypeName& InTypeName, IDynamicTypeLayout* InParentType, const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions)
     : TypeName(InTypeName), TypeMembers(InTypeMembers), VirtualFunctions(InVirtualFunctions), ParentType(InParentType)
 {
+    // Parent type is always fully constructed before the child type, so it's ancestors can be extended directly
+    if (ParentType)
+    {
+        InheritanceDepth = ParentType->InheritanceDepth + 1;
+        AncestorTypes.reserve(ParentType->AncestorTypes.size() + 1);
+        AncestorTypes.assign(ParentType->AncestorTypes.begin(), ParentType->AncestorTypes.end());
+    }
+    AncestorTypes.push_back(this);
+}
+
+IDynamicTypeLayout::~IDynamicTypeLayout()
+{
+    delete InstancePool.load();
+}
+
+FDynamicTypeSlabPool* IDynamicTypeLayout::GetInstancePool() const
+{
+    FDynamicTypeSlabPool* CurrentInstancePool = InstancePool.load(std::memory_order_acquire);
+    if (CurrentInstancePool == nullptr)
+    {
+        // Multiple threads can race to create the pool, only one of them will win and the others will discard their pools
+        FDynamicTypeSlabPool* NewInstancePool = new FDynamicTypeSlabPool(GetSize(), GetMinAlignment());
+        if (InstancePool.compare_exchange_strong(CurrentInstancePool, NewInstancePool, std::memory_order_acq_rel))
+        {
+            return NewInstancePool;
+        }
+        delete NewInstancePool;
+    }
+    return CurrentInstancePool;
+}
+
+void IDynamicTypeLayout::InitializeDynamicType()
+{
+    size_t NumHierarchyMembers = 0;
+    size_t NumHierarchyVirtualFunctions = 0;
+    for (const IDynamicTypeLayout* CurrentType = this; CurrentType != nullptr; CurrentType = CurrentType->ParentType)
+    {
+        NumHierarchyMembers += CurrentType->TypeMembers.size();
+        NumHierarchyVirtualFunctions += CurrentType->VirtualFunctions.size();
+    }
+
+    // Walk the hierarchy from this type to the root type, so the members of the child types shadow the members of their parents
+    MemberIndex.Reset(NumHierarchyMembers);
+    VirtualFunctionIndex.Reset(NumHierarchyVirtualFunctions);
+    for (const IDynamicTypeLayout* CurrentType = this; CurrentType != nullptr; CurrentType = CurrentType->ParentType)
+    {
+        for (FDynamicTypeMember* Member : CurrentType->TypeMembers)
+        {
+            MemberIndex.Add(Member, CurrentType == this);
+        }
+        for (FDynamicTypeVirtualFunction* VirtualFunction : CurrentType->VirtualFunctions)
+        {
+            VirtualFunctionIndex.Add(VirtualFunction, CurrentType == this);
+        }
+    }
+}
+
+void IDynamicTypeLayout::InitializeWithDependencies() const
+{
+    // Types being initialized by this thread. Dependencies are initialized before taking the lock of the type, so finding the type here again means
+    // that it depends on itself. Other threads can initialize the same types concurrently, they only wait for each other on the type locks
+    thread_local std::vector<const IDynamicTypeLayout*> TypesBeingInitialized;
+    if (std::ranges::find(TypesBeingInitialized, this) != TypesBeingInitialized.end())
+    {
+        throw std::runtime_error("Cyclic dependency between dynamic types detected");
+    }
+    TypesBeingInitialized.push_back(this);
+    struct FInitializationScope
+    {
+        ~FInitializationScope() { TypesBeingInitialized.pop_back(); }
+    } InitializationScope;
+
+    IDynamicTypeLayout* MutableThis = const_cast<IDynamicTypeLayout*>(this);
+    {
+        // Members have to be collected first, since their types are the dependencies of this type
+        std::lock_guard Lock(InitializationMutex);
+        if (DeferredCollectTypeMembers)
+        {
+            DeferredCollectTypeMembers(MutableThis->TypeMembers, MutableThis->VirtualFunctions);
+            MutableThis->DeferredCollectTypeMembers = nullptr;
+        }
+    }
+
+    // Layout of this type depends on the final layouts of the parent type and the dynamic types of the members
+    if (ParentType)
+    {
+        ParentType->EnsureInitialized();
+    }
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        if (const IDynamicTypeLayout* MemberDynamicType = Member->GetType()->GetDynamicType())
+        {
+            MemberDynamicType->EnsureInitialized();
+        }
+    }
+
+    std::lock_guard Lock(InitializationMutex);
+    if (InitializationState.load(std::memory_order_relaxed) == EDynamicTypeInitializationState::Uninitialized)
+    {
+        try
+        {
+            MutableThis->InitializeDynamicType();
+        }
+        catch (...)
+        {
+            MutableThis->InitializationState.store(EDynamicTypeInitializationState::Failed, std::memory_order_relaxed);
+            throw;
+        }
+        // Release store publishes the layout to the threads that observe the type as initialized without taking the lock
+        MutableThis->InitializationState.store(EDynamicTypeInitializationState::Initialized, std::memory_order_release);
+    }
+    if (InitializationState.load(std::memory_order_relaxed) == EDynamicTypeInitializationState::Failed)
+    {
+        throw std::runtime_error("Dynamic type has failed to initialize");
+    }
 }
 
-FDynamicTypeMember* IDynamicTypeLayout::FindTypeMember(const dtl_string& MemberName) const
+FDynamicTypeMember* IDynamicTypeLayout::FindTypeMember(const dtl_string_view MemberName) const
 {
+    EnsureInitialized();
+    if (!MemberIndex.IsEmpty())
+    {
+        return MemberIndex.Find(MemberName, false);
+    }
+    // Index has not been built, fall back to the linear search
     for (FDynamicTypeMember* Member : TypeMembers)
     {
         if (Member->GetName() == MemberName)
@@ -45,8 +184,13 @@ FDynamicTypeMember* IDynamicTypeLayout::FindTypeMember(const dtl_string& MemberN
     return nullptr;
 }
 
-FDynamicTypeVirtualFunction* IDynamicTypeLayout::FindVirtualFunction(const dtl_string& VirtualFunctionName) const
+FDynamicTypeVirtualFunction* IDynamicTypeLayout::FindVirtualFunction(const dtl_string_view VirtualFunctionName) const
 {
+    EnsureInitialized();
+    if (!VirtualFunctionIndex.IsEmpty())
+    {
+        return VirtualFunctionIndex.Find(VirtualFunctionName, false);
+    }
     for (FDynamicTypeVirtualFunction* VirtualFunction : VirtualFunctions)
     {
         if (VirtualFunction->GetName() == VirtualFunctionName)
@@ -57,31 +201,188 @@ FDynamicTypeVirtualFunction* IDynamicTypeLayout::FindVirtualFunction(const dtl_s
     return nullptr;
 }
 
-AutoTypeLayout::AutoTypeLayout(const dtl_string& InTypeName, IDynamicTypeLayout* InParentType,
-    const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions) :
-    IDynamicTypeLayout(InTypeName, InParentType, InTypeMembers, InVirtualFunctions)
+FDynamicTypeMember* IDynamicTypeLayout::FindTypeMemberRecursive(const dtl_string_view MemberName) const
+{
+    EnsureInitialized();
+    if (!MemberIndex.IsEmpty())
+    {
+        return MemberIndex.Find(MemberName, true);
+    }
+    for (const IDynamicTypeLayout* CurrentType = this; CurrentType != nullptr; CurrentType = CurrentType->ParentType)
+    {
+        if (FDynamicTypeMember* Member = CurrentType->FindTypeMember(MemberName))
+        {
+            return Member;
+        }
+    }
+    return nullptr;
+}
+
+FDynamicTypeVirtualFunction* IDynamicTypeLayout::FindVirtualFunctionRecursive(const dtl_string_view VirtualFunctionName) const
+{
+    EnsureInitialized();
+    if (!VirtualFunctionIndex.IsEmpty())
+    {
+        return VirtualFunctionIndex.Find(VirtualFunctionName, true);
+    }
+    for (const IDynamicTypeLayout* CurrentType = this; CurrentType != nullptr; CurrentType = CurrentType->ParentType)
+    {
+        if (FDynamicTypeVirtualFunction* VirtualFunction = CurrentType->FindVirtualFunction(VirtualFunctionName))
+        {
+            return VirtualFunction;
+        }
+    }
+    return nullptr;
+}
+
+void IDynamicTypeLayout::EmplaceTypeInstanceWithTrailingArray(void* PlacementStorage, const size_t TrailingArrayNum) const
+{
+    if (TrailingArrayNum != 0)
+    {
+        throw std::runtime_error("EmplaceTypeInstanceWithTrailingArray called with non-zero number of elements on the type without the trailing array");
+    }
+    EmplaceTypeInstance(PlacementStorage);
+}
+
+/** Constructs the instances one by one with the provided function, destroying the already constructed instances in reverse order if one of them throws */
+template<typename InConstructFunction>
+static void ConstructTypeInstancesOrRollback(const IDynamicTypeLayout* DynamicType, void* PlacementStorage, const size_t Count, InConstructFunction&& ConstructFunction)
+{
+    const size_t Stride = DynamicType->GetSize();
+    size_t InstanceIndex = 0;
+    try
+    {
+        for (; InstanceIndex < Count; InstanceIndex++)
+        {
+            ConstructFunction(static_cast<uint8_t*>(PlacementStorage) + InstanceIndex * Stride, InstanceIndex * Stride);
+        }
+    }
+    catch (...)
+    {
+        while (InstanceIndex-- > 0)
+        {
+            DynamicType->DestructTypeInstance(static_cast<uint8_t*>(PlacementStorage) + InstanceIndex * Stride);
+        }
+        throw;
+    }
+}
+
+void IDynamicTypeLayout::EmplaceTypeInstances(void* PlacementStorage, const size_t Count) const
+{
+    ConstructTypeInstancesOrRollback(this, PlacementStorage, Count, [&](void* Instance, size_t)
+    {
+        EmplaceTypeInstance(Instance);
+    });
+}
+
+void IDynamicTypeLayout::DestructTypeInstances(void* TypeInstances, const size_t Count) const
+{
+    const size_t Stride = GetSize();
+    for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+    {
+        DestructTypeInstance(static_cast<uint8_t*>(TypeInstances) + InstanceIndex * Stride);
+    }
+}
+
+void IDynamicTypeLayout::CopyAssignTypeInstances(void* DestInstances, const void* SrcInstances, const size_t Count) const
+{
+    const size_t Stride = GetSize();
+    for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+    {
+        CopyAssignTypeInstance(static_cast<uint8_t*>(DestInstances) + InstanceIndex * Stride, static_cast<const uint8_t*>(SrcInstances) + InstanceIndex * Stride);
+    }
+}
+
+void IDynamicTypeLayout::CopyConstructTypeInstances(void* PlacementStorage, const void* SrcInstances, const size_t Count) const
+{
+    ConstructTypeInstancesOrRollback(this, PlacementStorage, Count, [&](void* Instance, const size_t InstanceOffset)
+    {
+        CopyConstructTypeInstance(Instance, static_cast<const uint8_t*>(SrcInstances) + InstanceOffset);
+    });
+}
+
+void IDynamicTypeLayout::MoveConstructTypeInstances(void* PlacementStorage, void* SrcInstances, const size_t Count) const
+{
+    ConstructTypeInstancesOrRollback(this, PlacementStorage, Count, [&](void* Instance, const size_t InstanceOffset)
+    {
+        MoveConstructTypeInstance(Instance, static_cast<uint8_t*>(SrcInstances) + InstanceOffset);
+    });
+}
+
+void IDynamicTypeLayout::CopyConstructTypeInstance(void* PlacementStorage, const void* SrcInstance) const
+{
+    EmplaceTypeInstance(PlacementStorage);
+    try
+    {
+        CopyAssignTypeInstance(PlacementStorage, SrcInstance);
+    }
+    catch (...)
+    {
+        DestructTypeInstance(PlacementStorage);
+        throw;
+    }
+}
+
+void IDynamicTypeLayout::MoveConstructTypeInstance(void* PlacementStorage, void* SrcInstance) const
+{
+    CopyConstructTypeInstance(PlacementStorage, SrcInstance);
+}
+
+void IDynamicTypeLayout::MoveAssignTypeInstance(void* DestInstance, void* SrcInstance) const
+{
+    CopyAssignTypeInstance(DestInstance, SrcInstance);
+}
+
+/**
+ * Guards the virtual function tables of all auto type layouts against concurrent writers, along with their child type lists and the implementation tracking of the virtual functions.
+ * Types having the same function can be initialized and overridden on different threads. Readers calling the functions never take this lock
+ */
+static std::mutex& GetVirtualFunctionTableMutex()
+{
+    static std::mutex VirtualFunctionTableMutex;
+    return VirtualFunctionTableMutex;
+}
+
+AutoTypeLayout::AutoTypeLayout(const FDynamicTypeName& InTypeName, IDynamicTypeLayout* InParentType,
+    const std::vector<FDynamicTypeMember*>& InTypeMembers, const std::vector<FDynamicTypeVirtualFunction*>& InVirtualFunctions, const EAutoTypeLayoutFlags InLayoutFlags) :
+    IDynamicTypeLayout(InTypeName, InParentType, InTypeMembers, InVirtualFunctions), LayoutFlags(InLayoutFlags)
 {
 }
 
 uintptr_t AutoTypeLayout::StaticTypeIdToken()
 {
+    static uint8_t StaticTypeIdToken;
+    return reinterpret_cast<uintptr_t>(&StaticTypeIdToken);
 }
 
 void AutoTypeLayout::InitializeDynamicType()
 {
+    IDynamicTypeLayout::InitializeDynamicType();
+
+    // Trailing array is placed after the end of the instance, so the members of the child type would overlap with it
+    if (ParentType && ParentType->HasTrailingArray())
+    {
+        throw std::runtime_error("Types with a trailing array cannot have child types");
+    }
+    if (ParentType && ParentType->IsFinalType())
+    {
+        throw std::runtime_error("Final types cannot have child types");
+    }
+
     size_t CurrentTypeOffset = ParentType ? ParentType->GetSize() : 0;
     size_t CurrentTypeAlignment = ParentType ? ParentType->GetMinAlignment() : 1;
 
     // If our parent type is also an auto type layout, retrieve data from it
     if (const AutoTypeLayout* ParentAutoTypeLayout = CastDynamicTypeImpl<AutoTypeLayout>(ParentType))
     {
-        // Copy virtual function table displacement and vtable itself from the parent type
+        // Copy virtual function table displacement and vtable itself from the parent type. Parent type entries might be overridden concurrently
+        std::lock_guard Lock(GetVirtualFunctionTableMutex());
         VirtualFunctionTableDisplacement = ParentAutoTypeLayout->VirtualFunctionTableDisplacement;
         VirtualFunctionTable = ParentAutoTypeLayout->VirtualFunctionTable;
     }
 
-    // If we have virtual functions for this type, but do not have a virtual function table yet, allocate one
-    if (VirtualFunctionTableDisplacement == -1 && !VirtualFunctions.empty())
+    // If we have virtual functions for this type or need the instance type header, but do not have a virtual function table yet, allocate one
+    if (VirtualFunctionTableDisplacement == -1 && (!VirtualFunctions.empty() || EnumHasAnyFlags(LayoutFlags, EAutoTypeLayoutFlags::InstanceTypeHeader)))
     {
         constexpr size_t VirtualFunctionTableAlignment = alignof(const GenericFunctionPtr**);
         constexpr size_t VirtualFunctionTableSize = sizeof(const GenericFunctionPtr**);
@@ -94,107 +395,1451 @@ void AutoTypeLayout::InitializeDynamicType()
         CurrentTypeOffset += VirtualFunctionTableSize;
         CurrentTypeAlignment = std::max(CurrentTypeAlignment, VirtualFunctionTableAlignment);
     }
+    InstanceTypeHeaderDisplacement = VirtualFunctionTableDisplacement;
+    // Instances point to the published table slot, which is preceded by the type owning it
+    InstanceTableHeader[0] = static_cast<IDynamicTypeLayout*>(this);
 
     // Layout virtual functions in the virtual function table. They should not be in the vtable yet, so just append them to the end
     for (FDynamicTypeVirtualFunction* VirtualFunction : VirtualFunctions)
     {
         const size_t VirtualFunctionTableOffset = sizeof(GenericFunctionPtr) * VirtualFunctionTable.size();
-        VirtualFunction->Internal_SetupFunctionOffsetAndDisplacement(VirtualFunctionTableDisplacement, static_cast<int64_t>(VirtualFunctionTableOffset));
-        VirtualFunctionTable.push_back(&PureVirtualFunctionCalled);
+        VirtualFunction->Internal_SetupFunctionOffsetAndDisplacement(VirtualFunctionTableDisplacement, static_cast<int64_t>(VirtualFunctionTableOffset), true);
+        VirtualFunctionTable.push_back(reinterpret_cast<GenericFunctionPtr>(&PureVirtualFunctionCalled));
+    }
+
+    // Type is as trivial as it's parent and all of it's members are. Virtual function table pointer has to be written on construction,
+    // and must not be copied, but it can be relocated along with the rest of the instance and does not need to be destroyed
+    TypeFlags = ParentType ? ParentType->GetTypeFlags() : EMemberTypeFlags::AllTraits;
+    if (VirtualFunctionTableDisplacement != -1)
+    {
+        TypeFlags &= ~(EMemberTypeFlags::TriviallyDefaultConstructible | EMemberTypeFlags::ZeroConstructible | EMemberTypeFlags::TriviallyCopyable);
     }
 
-    // Layout members in memory after the parent class
     for (FDynamicTypeMember* Member : TypeMembers)
     {
-        const size_t MemberAlignment = Member->GetType()->GetMemberAlignment();
-        const size_t MemberSize = Member->GetType()->GetMemberSize();
+        TypeFlags &= Member->GetType()->GetTypeFlags();
 
-        // Make sure the current offset is aligned to the minimum alignment of this member
-        CurrentTypeOffset = Align(CurrentTypeOffset, MemberAlignment);
-        // Assign the offset to the member
-        Member->Internal_SetupMemberOffset(static_cast<int64_t>(CurrentTypeOffset));
+        // Nested instances are always allocated with their fixed size, so there is no space for the trailing array
+        if (Member->GetType()->GetDynamicType() && Member->GetType()->GetDynamicType()->HasTrailingArray())
+        {
+            throw std::runtime_error("Types with a trailing array cannot be used as members of other types");
+        }
+        if (Member->IsTrailingArray())
+        {
+            if (TrailingArrayMember)
+            {
+                throw std::runtime_error("Type cannot have more than one trailing array");
+            }
+            TrailingArrayMember = Member;
+        }
+    }
 
-        // Increment the offset to account for the member size, and take the maximum alignment between current type alignment and member alignment
-        CurrentTypeOffset += MemberSize;
-        CurrentTypeAlignment = std::max(CurrentTypeAlignment, MemberAlignment);
+    // Instances are not all of the same size anymore, so operations on whole instances cannot be done with a single memset or memcpy of the fixed size
+    if (TrailingArrayMember)
+    {
+        TypeFlags &= EMemberTypeFlags::TriviallyDestructible;
+    }
+
+    // Take the layout from the cache if it has been computed by the previous run from the same inputs. Entries that fail the validation are treated as missing.
+    // Hash is only calculated when there is a cache to look it up in, so the types that do not use the cache pay nothing for it
+    MemberLayoutOffset = CurrentTypeOffset;
+    MemberLayoutAlignment = CurrentTypeAlignment;
+    bool bAppliedCachedLayout = false;
+    if (const FDynamicTypeLayoutCache& LayoutCache = FDynamicTypeLayoutCache::Get(); UsesLayoutCache() && LayoutCache.IsLoaded())
+    {
+        const FCachedTypeLayout* CachedLayout = LayoutCache.FindTypeLayout(GetStructuralHash());
+        bAppliedCachedLayout = CachedLayout && ApplyCachedLayout(*CachedLayout, CurrentTypeOffset, CurrentTypeAlignment);
+        LayoutCache.Internal_RecordLookup(bAppliedCachedLayout);
+    }
+
+    if (!bAppliedCachedLayout)
+    {
+        // Layout members in memory after the parent class
+        LayoutTypeMembers(CurrentTypeOffset, CurrentTypeAlignment);
+
+        if (TrailingArrayMember)
+        {
+            // Number of the trailing array elements is stored in a hidden field in the fixed part of the instance
+            CurrentTypeOffset = Align(CurrentTypeOffset, alignof(size_t));
+            TrailingArrayNumOffset = static_cast<int64_t>(CurrentTypeOffset);
+            CurrentTypeOffset += sizeof(size_t);
+            CurrentTypeAlignment = std::max({CurrentTypeAlignment, alignof(size_t), GetEffectiveMemberAlignment(TrailingArrayMember)});
+        }
+
+        // Assign calculated size and alignment of the structure. Note that type size must always be a multiple of it's alignment
+        CurrentTypeOffset = Align(CurrentTypeOffset, CurrentTypeAlignment);
+        CalculatedSize = CurrentTypeOffset;
+        CalculatedAlignment = CurrentTypeAlignment;
+
+        // Trailing array starts right after the fixed part of the instance. Type alignment includes the alignment of the elements, so the start is always aligned
+        if (TrailingArrayMember)
+        {
+            TrailingArrayMember->Internal_SetupMemberOffset(static_cast<int64_t>(CalculatedSize));
+        }
+    }
+
+    // Now that the layout is known, flatten the hierarchy into the lifecycle plan
+    CompileLifecyclePlan();
+
+    // Padding and the virtual function table pointer are not a part of the value, so the whole instance can only be compared with memcmp if it has neither
+    if (!LifecyclePlan.IsComparedAsSingleByteRange(CalculatedSize))
+    {
+        TypeFlags &= ~EMemberTypeFlags::BitwiseComparable;
     }
 
-    // Assign calculated size and alignment of the structure. Note that type size must always be a multiple of it's alignment
-    CurrentTypeOffset = Align(CurrentTypeOffset, CurrentTypeAlignment);
-    CalculatedSize = CurrentTypeOffset;
-    CalculatedAlignment = CurrentTypeAlignment;
+    // Type cannot fail initialization anymore, so it can be linked to it's parent type to receive it's overrides
+    PublishVirtualFunctionTable();
 }
 
-void AutoTypeLayout::RegisterVirtualFunctionOverride(const FDynamicTypeVirtualFunction* InVirtualFunction, GenericFunctionPtr NewFunctionPointer)
+void AutoTypeLayout::PublishVirtualFunctionTable()
 {
-    // Find the virtual function table entry for this function
-    if (InVirtualFunction->GetVirtualFunctionTableDisplacement() != VirtualFunctionTableDisplacement)
+    if (VirtualFunctionTableDisplacement == -1)
     {
-        throw std::runtime_error("RegisterVirtualFunctionOverride called with invalid virtual function (displacement does not match the class displacement)");
+        return;
     }
-    const int64_t VirtualFunctionIndex = InVirtualFunction->GetVirtualFunctionTableOffset() / static_cast<int64_t>(sizeof(GenericFunctionPtr));
-    if (VirtualFunctionIndex < 0 || VirtualFunctionIndex >= VirtualFunctionTable.size())
+    std::lock_guard Lock(GetVirtualFunctionTableMutex());
+    OverriddenVirtualFunctionTableEntries.assign(VirtualFunctionTable.size(), false);
+
+    if (AutoTypeLayout* ParentAutoTypeLayout = CastDynamicTypeImpl<AutoTypeLayout>(ParentType); ParentAutoTypeLayout && ParentAutoTypeLayout->VirtualFunctionTableDisplacement == VirtualFunctionTableDisplacement)
     {
-        throw std::runtime_error("RegisterVirtualFunctionOverride called with invalid virtual function (virtual function offset is invalid)");
+        // Parent type might have been overridden since we have copied it's table, so pick up it's current entries before linking to it
+        for (size_t EntryIndex = 0; EntryIndex < ParentAutoTypeLayout->VirtualFunctionTable.size(); EntryIndex++)
+        {
+            VirtualFunctionTable[EntryIndex] = ParentAutoTypeLayout->VirtualFunctionTable[EntryIndex];
+        }
+        ParentAutoTypeLayout->ChildTypeLayouts.push_back(this);
+    }
+    PublishVirtualFunctionTableCopy();
+
+    // Let every virtual function in our table know about the implementation this type has, so calls can be devirtualized while all types agree on it
+    for (const IDynamicTypeLayout* CurrentType : AncestorTypes)
+    {
+        for (FDynamicTypeVirtualFunction* VirtualFunction : CurrentType->GetVirtualFunctions())
+        {
+            if (VirtualFunction->GetVirtualFunctionTableDisplacement() == VirtualFunctionTableDisplacement)
+            {
+                VirtualFunction->Internal_AddImplementation(VirtualFunctionTable[GetVirtualFunctionTableIndex(VirtualFunction)]);
+            }
+        }
     }
-    VirtualFunctionTable[VirtualFunctionIndex] = NewFunctionPointer;
 }
 
-__declspec(noinline) void AutoTypeLayout::PureVirtualFunctionCalled()
+void AutoTypeLayout::PublishVirtualFunctionTableCopy()
 {
-    __debugbreak();
-    abort();
+    std::unique_ptr<GenericFunctionPtr[]> NewVirtualFunctionTable = std::make_unique<GenericFunctionPtr[]>(VirtualFunctionTable.size());
+    std::ranges::copy(VirtualFunctionTable, NewVirtualFunctionTable.get());
+
+    // Release store publishes the whole table at once. Replaced tables are kept alive, since concurrent callers might still be reading them
+    std::atomic_ref(InstanceTableHeader[1]).store(NewVirtualFunctionTable.get(), std::memory_order_release);
+    PublishedVirtualFunctionTables.push_back(std::move(NewVirtualFunctionTable));
 }
 
-void AutoTypeLayout::EmplaceTypeInstance(void* Instance) const
+uint64_t AutoTypeLayout::CalculateStructuralHash(const size_t InTypeOffset, const size_t InTypeAlignment) const
 {
-    // Parent type starts at offset 0
+    FDynamicTypeHashBuilder HashBuilder;
+    HashBuilder.Add(TypeName.GetHash()).Add(LayoutFlags).Add(InTypeOffset).Add(InTypeAlignment).Add(VirtualFunctionTableDisplacement).Add(VirtualFunctions.size()).Add(TypeMembers.size());
     if (ParentType)
     {
-        ParentType->EmplaceTypeInstance(Instance);
+        // Parent type has been initialized already, so it's layout can be described by it's name and it's final size
+        HashBuilder.Add(ParentType->GetInternedTypeName().GetHash()).Add(ParentType->GetSize()).Add(ParentType->GetMinAlignment());
+    }
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        HashBuilder.Add(Member->GetInternedName().GetHash()).Add(Member->GetArrayDim()).Add(Member->GetLayoutHint()).Add(Member->GetAlignmentOverride());
+        HashBuilder.Add(Member->GetType()->GetMemberSize()).Add(Member->GetType()->GetMemberAlignment());
     }
+    return HashBuilder.GetHash();
+}
 
-    // Override the virtual table at it's offset if we have a virtual function table
-    if (VirtualFunctionTableDisplacement != -1)
+bool AutoTypeLayout::IsValidCachedLayout(const FCachedTypeLayout& CachedLayout, const size_t InTypeOffset, const size_t InTypeAlignment) const
+{
+    // Entry has to agree with the parts of the layout we have computed already
+    if (CachedLayout.NumMembers != TypeMembers.size() || CachedLayout.VirtualFunctionTableDisplacement != VirtualFunctionTableDisplacement)
+    {
+        return false;
+    }
+    // Type alignment must be a power of two covering the alignment the members are laid out from, and the size must be a multiple of it
+    const uint64_t CachedAlignment = CachedLayout.Alignment;
+    const uint64_t CachedSize = CachedLayout.Size;
+    if (CachedAlignment == 0 || (CachedAlignment & (CachedAlignment - 1)) != 0 || CachedAlignment < InTypeAlignment || CachedSize < InTypeOffset || CachedSize % CachedAlignment != 0)
     {
-        // This assumes that this type layout will never be moved, which is a reasonable assumption to make
-        const auto** VirtualFunctionTablePtr = reinterpret_cast<const GenericFunctionPtr**>(static_cast<uint8_t*>(Instance) + VirtualFunctionTableDisplacement);
-        *VirtualFunctionTablePtr = VirtualFunctionTable.data();
+        return false;
     }
 
-    // Our type members follow
-    for (const FDynamicTypeMember* Member : TypeMembers)
+    // Members are stored sorted by their offset, so they do not overlap if each one starts after the end of the previous one
+    std::vector<bool> VisitedMembers(TypeMembers.size(), false);
+    uint64_t PreviousMemberEnd = InTypeOffset;
+    const FCachedMemberLayout* CachedMembers = CachedLayout.GetMembers();
+    for (uint32_t CachedMemberIndex = 0; CachedMemberIndex < CachedLayout.NumMembers; CachedMemberIndex++)
+    {
+        const FCachedMemberLayout& CachedMember = CachedMembers[CachedMemberIndex];
+        if (CachedMember.MemberIndex >= TypeMembers.size() || VisitedMembers[CachedMember.MemberIndex] || CachedMember.Offset < 0)
+        {
+            return false;
+        }
+        VisitedMembers[CachedMember.MemberIndex] = true;
+
+        const FDynamicTypeMember* Member = TypeMembers[CachedMember.MemberIndex];
+        const uint64_t MemberOffset = static_cast<uint64_t>(CachedMember.Offset);
+        const size_t MemberAlignment = GetEffectiveMemberAlignment(Member);
+        if (MemberAlignment > CachedAlignment)
+        {
+            return false;
+        }
+        // Trailing array starts right after the fixed part of the instance, and does not occupy any of it
+        if (Member->IsTrailingArray())
+        {
+            if (MemberOffset != CachedSize)
+            {
+                return false;
+            }
+            continue;
+        }
+        if (MemberOffset < PreviousMemberEnd || MemberOffset % MemberAlignment != 0 || Member->GetMemberStorageSize() > CachedSize - MemberOffset)
+        {
+            return false;
+        }
+        PreviousMemberEnd = MemberOffset + Member->GetMemberStorageSize();
+    }
+
+    // Number of the trailing array elements is placed after all the members of the fixed part of the instance
+    if (TrailingArrayMember == nullptr)
     {
-        Member->GetType()->EmplaceValue(Member->ContainerPtrToValuePtr<void>(Instance));
+        return CachedLayout.TrailingArrayNumOffset == -1;
     }
+    const uint64_t TrailingArrayNumOffsetValue = static_cast<uint64_t>(CachedLayout.TrailingArrayNumOffset);
+    return CachedLayout.TrailingArrayNumOffset >= 0 && TrailingArrayNumOffsetValue >= PreviousMemberEnd && TrailingArrayNumOffsetValue % alignof(size_t) == 0 &&
+        sizeof(size_t) <= CachedSize - TrailingArrayNumOffsetValue && CachedAlignment >= alignof(size_t);
 }
 
-void AutoTypeLayout::DestructTypeInstance(void* Instance) const
+bool AutoTypeLayout::ApplyCachedLayout(const FCachedTypeLayout& CachedLayout, const size_t InTypeOffset, const size_t InTypeAlignment)
 {
-    // Parent type starts at offset 0
-    if (ParentType)
+    if (!IsValidCachedLayout(CachedLayout, InTypeOffset, InTypeAlignment))
     {
-        ParentType->DestructTypeInstance(Instance);
+        return false;
     }
+    const FCachedMemberLayout* CachedMembers = CachedLayout.GetMembers();
+    for (uint32_t CachedMemberIndex = 0; CachedMemberIndex < CachedLayout.NumMembers; CachedMemberIndex++)
+    {
+        TypeMembers[CachedMembers[CachedMemberIndex].MemberIndex]->Internal_SetupMemberOffset(CachedMembers[CachedMemberIndex].Offset);
+    }
+    TrailingArrayNumOffset = CachedLayout.TrailingArrayNumOffset;
+    CalculatedSize = CachedLayout.Size;
+    CalculatedAlignment = CachedLayout.Alignment;
+    return true;
+}
 
-    // Our type members follow
-    for (const FDynamicTypeMember* Member : TypeMembers)
+void AutoTypeLayout::LayoutTypeMembers(size_t& InOutTypeOffset, size_t& InOutTypeAlignment)
+{
+    for (FDynamicTypeMember* Member : TypeMembers)
+    {
+        // Trailing array is placed by InitializeDynamicType after the fixed part of the instance
+        if (Member->IsTrailingArray())
+        {
+            continue;
+        }
+        const size_t MemberAlignment = GetEffectiveMemberAlignment(Member);
+        const size_t MemberSize = Member->GetMemberStorageSize();
+
+        // Make sure the current offset is aligned to the minimum alignment of this member
+        InOutTypeOffset = Align(InOutTypeOffset, MemberAlignment);
+        // Assign the offset to the member
+        Member->Internal_SetupMemberOffset(static_cast<int64_t>(InOutTypeOffset));
+
+        // Increment the offset to account for the member size, and take the maximum alignment between current type alignment and member alignment
+        InOutTypeOffset += MemberSize;
+        InOutTypeAlignment = std::max(InOutTypeAlignment, MemberAlignment);
+    }
+}
+
+size_t AutoTypeLayout::GetEffectiveMemberAlignment(const FDynamicTypeMember* Member)
+{
+    const size_t AlignmentOverride = Member->GetAlignmentOverride();
+    if ((AlignmentOverride & (AlignmentOverride - 1)) != 0)
     {
-        Member->GetType()->DestructValue(Member->ContainerPtrToValuePtr<void>(Instance));
+        throw std::runtime_error("Member alignment override must be a power of two");
     }
+    return std::max(Member->GetType()->GetMemberAlignment(), Member->GetAlignmentOverride());
 }
 
-void AutoTypeLayout::CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance) const
+void AutoTypeLayout::CompileLifecyclePlan()
 {
-    // Parent type starts at offset 0
-    if (ParentType)
+    LifecyclePlan.Reset();
+
+    // Parent type starts at offset 0. If it is an auto type layout, it's plan is already flattened and can be inlined directly
+    if (const AutoTypeLayout* ParentAutoTypeLayout = CastDynamicTypeImpl<AutoTypeLayout>(ParentType))
+    {
+        LifecyclePlan.AppendPlan(ParentAutoTypeLayout->LifecyclePlan, 0);
+    }
+    else if (ParentType)
     {
-        ParentType->CopyAssignTypeInstance(DestInstance, SrcInstance);
+        LifecyclePlan.AppendOpaqueType(ParentType, 0);
     }
 
-    // Our type members follow
-    for (const FDynamicTypeMember* Member : TypeMembers)
+    // Install our own virtual function table. If the parent already had one, it is written at the same displacement and needs to be replaced
+    if (VirtualFunctionTableDisplacement != -1)
+    {
+        LifecyclePlan.ReplaceVirtualFunctionTable(&InstanceTableHeader[1], VirtualFunctionTableDisplacement);
+    }
+
+    // Our type members follow. Visit them in memory order so adjacent byte ranges can be merged even if the layout reordered the members
+    std::vector<const FDynamicTypeMember*> MembersInMemoryOrder(TypeMembers.begin(), TypeMembers.end());
+    std::ranges::sort(MembersInMemoryOrder, {}, &FDynamicTypeMember::GetMemberOffset);
+
+    for (const FDynamicTypeMember* Member : MembersInMemoryOrder)
+    {
+        if (!Member->IsTrailingArray())
+        {
+            LifecyclePlan.AppendMember(Member->GetType(), Member->GetMemberOffset(), Member->GetArrayDim());
+        }
+    }
+
+    // Hidden number of the trailing array elements is copied along with the rest of the fixed part. Elements themselves are handled separately
+    if (TrailingArrayMember)
     {
-        Member->GetType()->CopyAssignValue(Member->ContainerPtrToValuePtr<void>(DestInstance), Member->ContainerPtrToValuePtr<void>(SrcInstance));
+        // It is not serialized as a part of the fixed part though, since deserialization cannot resize the instance. See SerializeTrailingArray
+        LifecyclePlan.AppendMember(TMemberTypeDescriptor<size_t>::StaticDescriptor(DTL_TEXT("size_t")), TrailingArrayNumOffset, 1, true);
+    }
+}
+
+size_t AutoTypeLayout::GetTrailingArrayNum(const void* TypeInstance) const
+{
+    return TrailingArrayMember ? *FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<size_t>(TypeInstance, TrailingArrayNumOffset) : 0;
+}
+
+size_t AutoTypeLayout::GetSizeWithTrailingArray(const size_t TrailingArrayNum) const
+{
+    if (TrailingArrayMember == nullptr)
+    {
+        return CalculatedSize;
+    }
+    return Align(CalculatedSize + TrailingArrayNum * TrailingArrayMember->GetType()->GetMemberSize(), CalculatedAlignment);
+}
+
+/** Destroys the first Num elements of the array in reverse order. Used to roll back the construction of the array that has thrown part way through */
+static void DestructArrayElements(const IMemberTypeDescriptor* ElementType, uint8_t* ArrayData, const size_t Num)
+{
+    for (size_t ElementIndex = Num; ElementIndex-- > 0;)
+    {
+        ElementType->DestructValue(ArrayData + ElementIndex * ElementType->GetMemberSize());
+    }
+}
+
+void AutoTypeLayout::EmplaceTypeInstanceWithTrailingArray(void* PlacementStorage, const size_t TrailingArrayNum) const
+{
+    if (TrailingArrayMember == nullptr)
+    {
+        IDynamicTypeLayout::EmplaceTypeInstanceWithTrailingArray(PlacementStorage, TrailingArrayNum);
+        return;
+    }
+    EmplaceTypeInstance(PlacementStorage);
+    *FDynamicTypeMember::ContainerPtrToValuePtrAtOffset<size_t>(PlacementStorage, TrailingArrayNumOffset) = TrailingArrayNum;
+
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    uint8_t* TrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(PlacementStorage);
+    if (ElementType->IsZeroConstructible())
+    {
+        std::memset(TrailingArrayData, 0, TrailingArrayNum * ElementType->GetMemberSize());
+        return;
+    }
+    size_t ElementIndex = 0;
+    try
+    {
+        for (; ElementIndex < TrailingArrayNum; ElementIndex++)
+        {
+            ElementType->EmplaceValue(TrailingArrayData + ElementIndex * ElementType->GetMemberSize());
+        }
+    }
+    catch (...)
+    {
+        DestructArrayElements(ElementType, TrailingArrayData, ElementIndex);
+        LifecyclePlan.DestructInstance(PlacementStorage);
+        throw;
+    }
+}
+
+void AutoTypeLayout::DestructTrailingArray(void* Instance) const
+{
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    if (ElementType->IsTriviallyDestructible())
+    {
+        return;
+    }
+    uint8_t* TrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(Instance);
+    const size_t TrailingArrayNum = GetTrailingArrayNum(Instance);
+    for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+    {
+        ElementType->DestructValue(TrailingArrayData + ElementIndex * ElementType->GetMemberSize());
+    }
+}
+
+void AutoTypeLayout::CopyConstructTrailingArray(void* DestInstance, const void* SrcInstance) const
+{
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    uint8_t* DestTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(DestInstance);
+    const uint8_t* SrcTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(SrcInstance);
+    const size_t TrailingArrayNum = GetTrailingArrayNum(SrcInstance);
+    if (ElementType->IsTriviallyCopyable())
+    {
+        std::memcpy(DestTrailingArrayData, SrcTrailingArrayData, TrailingArrayNum * ElementType->GetMemberSize());
+        return;
+    }
+    size_t ElementIndex = 0;
+    try
+    {
+        for (; ElementIndex < TrailingArrayNum; ElementIndex++)
+        {
+            ElementType->CopyConstructValue(DestTrailingArrayData + ElementIndex * ElementType->GetMemberSize(), SrcTrailingArrayData + ElementIndex * ElementType->GetMemberSize());
+        }
+    }
+    catch (...)
+    {
+        // Fixed part of the instance has been constructed by the caller already, so it is destroyed along with the elements
+        DestructArrayElements(ElementType, DestTrailingArrayData, ElementIndex);
+        LifecyclePlan.DestructInstance(DestInstance);
+        throw;
+    }
+}
+
+void AutoTypeLayout::MoveConstructTrailingArray(void* DestInstance, void* SrcInstance) const
+{
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    uint8_t* DestTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(DestInstance);
+    uint8_t* SrcTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(SrcInstance);
+    const size_t TrailingArrayNum = GetTrailingArrayNum(SrcInstance);
+    if (ElementType->IsTriviallyCopyable())
+    {
+        std::memcpy(DestTrailingArrayData, SrcTrailingArrayData, TrailingArrayNum * ElementType->GetMemberSize());
+        return;
+    }
+    size_t ElementIndex = 0;
+    try
+    {
+        for (; ElementIndex < TrailingArrayNum; ElementIndex++)
+        {
+            ElementType->MoveConstructValue(DestTrailingArrayData + ElementIndex * ElementType->GetMemberSize(), SrcTrailingArrayData + ElementIndex * ElementType->GetMemberSize());
+        }
+    }
+    catch (...)
+    {
+        // Fixed part of the instance has been constructed by the caller already, so it is destroyed along with the elements
+        DestructArrayElements(ElementType, DestTrailingArrayData, ElementIndex);
+        LifecyclePlan.DestructInstance(DestInstance);
+        throw;
+    }
+}
+
+void AutoTypeLayout::CheckTrailingArrayNumMatches(const void* DestInstance, const void* SrcInstance) const
+{
+    if (GetTrailingArrayNum(DestInstance) != GetTrailingArrayNum(SrcInstance))
+    {
+        throw std::runtime_error("Cannot assign instances with different number of trailing array elements");
+    }
+}
+
+void AutoTypeLayout::SerializeTypeInstance(const void* TypeInstance, IDynamicTypeWriter& Writer) const
+{
+    LifecyclePlan.SerializeInstances(TypeInstance, 1, 0, Writer);
+    if (TrailingArrayMember)
+    {
+        SerializeTrailingArray(TypeInstance, Writer);
+    }
+}
+
+void AutoTypeLayout::DeserializeTypeInstance(void* TypeInstance, IDynamicTypeReader& Reader) const
+{
+    LifecyclePlan.DeserializeInstances(TypeInstance, 1, 0, Reader);
+    if (TrailingArrayMember)
+    {
+        DeserializeTrailingArray(TypeInstance, Reader);
+    }
+}
+
+void AutoTypeLayout::SerializeTypeInstances(const void* TypeInstances, const size_t Count, IDynamicTypeWriter& Writer) const
+{
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::SerializeTypeInstances(TypeInstances, Count, Writer);
+        return;
+    }
+    // Instances without padding, virtual function table and non-trivial members are written with a single write for the whole batch
+    if (LifecyclePlan.IsSerializedAsSingleByteRange(CalculatedSize))
+    {
+        Writer.Write(TypeInstances, CalculatedSize * Count);
+        return;
+    }
+    LifecyclePlan.SerializeInstances(TypeInstances, Count, CalculatedSize, Writer);
+}
+
+void AutoTypeLayout::DeserializeTypeInstances(void* TypeInstances, const size_t Count, IDynamicTypeReader& Reader) const
+{
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::DeserializeTypeInstances(TypeInstances, Count, Reader);
+        return;
+    }
+    if (LifecyclePlan.IsSerializedAsSingleByteRange(CalculatedSize))
+    {
+        Reader.Read(TypeInstances, CalculatedSize * Count);
+        return;
+    }
+    LifecyclePlan.DeserializeInstances(TypeInstances, Count, CalculatedSize, Reader);
+}
+
+bool AutoTypeLayout::EqualsTypeInstance(const void* TypeInstanceA, const void* TypeInstanceB) const
+{
+    if (!LifecyclePlan.EqualsInstance(TypeInstanceA, TypeInstanceB))
+    {
+        return false;
+    }
+    return !TrailingArrayMember || EqualsTrailingArray(TypeInstanceA, TypeInstanceB);
+}
+
+uint64_t AutoTypeLayout::HashTypeInstance(const void* TypeInstance) const
+{
+    const uint64_t Hash = LifecyclePlan.HashInstance(TypeInstance);
+    return TrailingArrayMember ? HashTrailingArray(TypeInstance, Hash) : Hash;
+}
+
+void AutoTypeLayout::RegisterVirtualFunctionOverride(const FDynamicTypeVirtualFunction* InVirtualFunction, GenericFunctionPtr NewFunctionPointer)
+{
+    RegisterVirtualFunctionOverrides({FVirtualFunctionOverride{InVirtualFunction, NewFunctionPointer}});
+}
+
+void AutoTypeLayout::RegisterVirtualFunctionOverrides(const std::vector<FVirtualFunctionOverride>& InOverrides)
+{
+    for (const FVirtualFunctionOverride& Override : InOverrides)
+    {
+        CheckCanOverrideVirtualFunction(Override.VirtualFunction);
+    }
+
+    std::lock_guard Lock(GetVirtualFunctionTableMutex());
+    // Devirtualized implementations are dropped before the new tables are published, so the calls starting after this point read the table instead of the cached old implementation.
+    // Calls that have already loaded the devirtualized implementation can still complete with the old one
+    for (const FVirtualFunctionOverride& Override : InOverrides)
+    {
+        const_cast<FDynamicTypeVirtualFunction*>(Override.VirtualFunction)->Internal_UpdateDevirtualizedFunction(nullptr);
+    }
+    std::vector<std::pair<int64_t, GenericFunctionPtr>> Entries;
+    for (const FVirtualFunctionOverride& Override : InOverrides)
+    {
+        const int64_t EntryIndex = GetVirtualFunctionTableIndex(Override.VirtualFunction);
+        OverriddenVirtualFunctionTableEntries[EntryIndex] = true;
+        Entries.emplace_back(EntryIndex, Override.FunctionPointer);
+    }
+    WriteVirtualFunctionTableEntries(Entries);
+    for (const FVirtualFunctionOverride& Override : InOverrides)
+    {
+        UpdateDevirtualizedFunction(Override.VirtualFunction);
+    }
+}
+
+void AutoTypeLayout::CheckCanOverrideVirtualFunction(const FDynamicTypeVirtualFunction* InVirtualFunction) const
+{
+    if (VirtualFunctionTableDisplacement == -1 || InVirtualFunction->GetVirtualFunctionTableDisplacement() != VirtualFunctionTableDisplacement)
+    {
+        throw std::runtime_error("RegisterVirtualFunctionOverride called with invalid virtual function (displacement does not match the class displacement)");
+    }
+    const int64_t EntryIndex = GetVirtualFunctionTableIndex(InVirtualFunction);
+    if (InVirtualFunction->GetVirtualFunctionTableOffset() < 0 || EntryIndex >= static_cast<int64_t>(VirtualFunctionTable.size()))
+    {
+        throw std::runtime_error("RegisterVirtualFunctionOverride called with invalid virtual function (virtual function offset is invalid)");
+    }
+    // Functions of the unrelated types can share the displacement and the offset, so check that the function actually belongs to our hierarchy
+    const bool bDeclaredInHierarchy = std::ranges::any_of(AncestorTypes, [&](const IDynamicTypeLayout* CurrentType)
+    {
+        return std::ranges::find(CurrentType->GetVirtualFunctions(), InVirtualFunction) != CurrentType->GetVirtualFunctions().end();
+    });
+    if (!bDeclaredInHierarchy)
+    {
+        throw std::runtime_error("RegisterVirtualFunctionOverride called with invalid virtual function (function is not declared by this type or it's parent types)");
+    }
+}
+
+void AutoTypeLayout::WriteVirtualFunctionTableEntries(const std::vector<std::pair<int64_t, GenericFunctionPtr>>& Entries)
+{
+    // Instances read the published copy of the table, so all the entries are written first and then published together
+    for (const auto& [EntryIndex, FunctionPointer] : Entries)
+    {
+        VirtualFunctionTable[EntryIndex] = FunctionPointer;
+    }
+    PublishVirtualFunctionTableCopy();
+
+    // Child types only receive the entries they have not overridden themselves, and skip publishing a new table if that leaves nothing
+    for (AutoTypeLayout* ChildTypeLayout : ChildTypeLayouts)
+    {
+        std::vector<std::pair<int64_t, GenericFunctionPtr>> InheritedEntries;
+        std::ranges::copy_if(Entries, std::back_inserter(InheritedEntries), [&](const std::pair<int64_t, GenericFunctionPtr>& Entry)
+        {
+            return !ChildTypeLayout->OverriddenVirtualFunctionTableEntries[Entry.first];
+        });
+        if (!InheritedEntries.empty())
+        {
+            ChildTypeLayout->WriteVirtualFunctionTableEntries(InheritedEntries);
+        }
+    }
+}
+
+void AutoTypeLayout::UpdateDevirtualizedFunction(const FDynamicTypeVirtualFunction* InVirtualFunction) const
+{
+    // Function is shared by the whole subtree of the type declaring it, so walk it and check whenever all the types still agree on the implementation
+    const AutoTypeLayout* DeclaringTypeLayout = this;
+    for (const IDynamicTypeLayout* CurrentType : AncestorTypes)
+    {
+        if (std::ranges::find(CurrentType->GetVirtualFunctions(), InVirtualFunction) != CurrentType->GetVirtualFunctions().end())
+        {
+            DeclaringTypeLayout = CastDynamicTypeImpl<const AutoTypeLayout>(const_cast<IDynamicTypeLayout*>(CurrentType));
+            break;
+        }
+    }
+    // Subtree of the declaring type can only be walked if it has been laid out by AutoTypeLayout, otherwise the function is conservatively left without the devirtualized implementation
+    if (DeclaringTypeLayout == nullptr)
+    {
+        const_cast<FDynamicTypeVirtualFunction*>(InVirtualFunction)->Internal_UpdateDevirtualizedFunction(nullptr);
+        return;
+    }
+
+    const int64_t EntryIndex = GetVirtualFunctionTableIndex(InVirtualFunction);
+    GenericFunctionPtr SharedImplementation = DeclaringTypeLayout->VirtualFunctionTable[EntryIndex];
+    std::vector<const AutoTypeLayout*> PendingTypeLayouts{DeclaringTypeLayout};
+    while (!PendingTypeLayouts.empty() && SharedImplementation != nullptr)
+    {
+        const AutoTypeLayout* CurrentTypeLayout = PendingTypeLayouts.back();
+        PendingTypeLayouts.pop_back();
+        if (CurrentTypeLayout->VirtualFunctionTable[EntryIndex] != SharedImplementation)
+        {
+            SharedImplementation = nullptr;
+        }
+        PendingTypeLayouts.insert(PendingTypeLayouts.end(), CurrentTypeLayout->ChildTypeLayouts.begin(), CurrentTypeLayout->ChildTypeLayouts.end());
+    }
+    const_cast<FDynamicTypeVirtualFunction*>(InVirtualFunction)->Internal_UpdateDevirtualizedFunction(SharedImplementation);
+}
+
+int64_t AutoTypeLayout::GetVirtualFunctionTableIndex(const FDynamicTypeVirtualFunction* VirtualFunction)
+{
+    return VirtualFunction->GetVirtualFunctionTableOffset() / static_cast<int64_t>(sizeof(GenericFunctionPtr));
+}
+
+void FDynamicTypeVirtualFunction::Internal_AddImplementation(const GenericFunctionPtr Implementation)
+{
+    // Called with the virtual function table mutex held
+    if (NumImplementingTypes++ == 0)
+    {
+        DevirtualizedFunctionPtr.store(Implementation, std::memory_order_release);
+    }
+    else if (DevirtualizedFunctionPtr.load(std::memory_order_relaxed) != Implementation)
+    {
+        DevirtualizedFunctionPtr.store(nullptr, std::memory_order_release);
+    }
+}
+
+void FDynamicTypeVirtualFunction::Internal_UpdateDevirtualizedFunction(const GenericFunctionPtr SharedImplementation)
+{
+    DevirtualizedFunctionPtr.store(SharedImplementation, std::memory_order_release);
+}
+
+DTL_NOINLINE void AutoTypeLayout::PureVirtualFunctionCalled()
+{
+    DTL_DEBUG_BREAK();
+    abort();
+}
+
+void AutoTypeLayout::EmplaceTypeInstance(void* Instance) const
+{
+    // Fast path for types that are entirely zero constructible
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::ZeroConstructible))
+    {
+        std::memset(Instance, 0, CalculatedSize);
+        return;
+    }
+    LifecyclePlan.EmplaceInstance(Instance);
+}
+
+void AutoTypeLayout::DestructTypeInstance(void* Instance) const
+{
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyDestructible))
+    {
+        return;
+    }
+    if (TrailingArrayMember)
+    {
+        DestructTrailingArray(Instance);
+    }
+    LifecyclePlan.DestructInstance(Instance);
+}
+
+void AutoTypeLayout::CopyAssignTypeInstance(void* DestInstance, const void* SrcInstance) const
+{
+    // Fast path for types that are entirely trivially copyable
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(DestInstance, SrcInstance, CalculatedSize);
+        return;
+    }
+    if (TrailingArrayMember)
+    {
+        CheckTrailingArrayNumMatches(DestInstance, SrcInstance);
+        const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+        uint8_t* DestTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(DestInstance);
+        const uint8_t* SrcTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(SrcInstance);
+        const size_t TrailingArrayNum = GetTrailingArrayNum(SrcInstance);
+        for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+        {
+            ElementType->CopyAssignValue(DestTrailingArrayData + ElementIndex * ElementType->GetMemberSize(), SrcTrailingArrayData + ElementIndex * ElementType->GetMemberSize());
+        }
+    }
+    LifecyclePlan.CopyAssignInstance(DestInstance, SrcInstance);
+}
+
+void AutoTypeLayout::CopyConstructTypeInstance(void* PlacementStorage, const void* SrcInstance) const
+{
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(PlacementStorage, SrcInstance, CalculatedSize);
+        return;
+    }
+    LifecyclePlan.CopyConstructInstance(PlacementStorage, SrcInstance);
+    if (TrailingArrayMember)
+    {
+        CopyConstructTrailingArray(PlacementStorage, SrcInstance);
+    }
+}
+
+void AutoTypeLayout::MoveConstructTypeInstance(void* PlacementStorage, void* SrcInstance) const
+{
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(PlacementStorage, SrcInstance, CalculatedSize);
+        return;
+    }
+    LifecyclePlan.MoveConstructInstance(PlacementStorage, SrcInstance);
+    if (TrailingArrayMember)
+    {
+        MoveConstructTrailingArray(PlacementStorage, SrcInstance);
+    }
+}
+
+void AutoTypeLayout::MoveAssignTypeInstance(void* DestInstance, void* SrcInstance) const
+{
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(DestInstance, SrcInstance, CalculatedSize);
+        return;
+    }
+    if (TrailingArrayMember)
+    {
+        CheckTrailingArrayNumMatches(DestInstance, SrcInstance);
+        const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+        uint8_t* DestTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(DestInstance);
+        uint8_t* SrcTrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(SrcInstance);
+        const size_t TrailingArrayNum = GetTrailingArrayNum(SrcInstance);
+        for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+        {
+            ElementType->MoveAssignValue(DestTrailingArrayData + ElementIndex * ElementType->GetMemberSize(), SrcTrailingArrayData + ElementIndex * ElementType->GetMemberSize());
+        }
+    }
+    LifecyclePlan.MoveAssignInstance(DestInstance, SrcInstance);
+}
+
+void AutoTypeLayout::EmplaceTypeInstances(void* PlacementStorage, const size_t Count) const
+{
+    // Instances with trailing arrays have to go through the single instance operations to handle the elements. Only instances without elements can be laid out contiguously
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::EmplaceTypeInstances(PlacementStorage, Count);
+        return;
+    }
+    // Contiguous zero constructible instances can be initialized with a single memset
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::ZeroConstructible))
+    {
+        std::memset(PlacementStorage, 0, CalculatedSize * Count);
+        return;
+    }
+    LifecyclePlan.EmplaceInstances(PlacementStorage, Count, CalculatedSize);
+}
+
+void AutoTypeLayout::DestructTypeInstances(void* TypeInstances, const size_t Count) const
+{
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::DestructTypeInstances(TypeInstances, Count);
+        return;
+    }
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyDestructible))
+    {
+        return;
+    }
+    LifecyclePlan.DestructInstances(TypeInstances, Count, CalculatedSize);
+}
+
+void AutoTypeLayout::CopyAssignTypeInstances(void* DestInstances, const void* SrcInstances, const size_t Count) const
+{
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::CopyAssignTypeInstances(DestInstances, SrcInstances, Count);
+        return;
+    }
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(DestInstances, SrcInstances, CalculatedSize * Count);
+        return;
+    }
+    LifecyclePlan.CopyAssignInstances(DestInstances, SrcInstances, Count, CalculatedSize);
+}
+
+void AutoTypeLayout::CopyConstructTypeInstances(void* PlacementStorage, const void* SrcInstances, const size_t Count) const
+{
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::CopyConstructTypeInstances(PlacementStorage, SrcInstances, Count);
+        return;
+    }
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(PlacementStorage, SrcInstances, CalculatedSize * Count);
+        return;
+    }
+    LifecyclePlan.CopyConstructInstances(PlacementStorage, SrcInstances, Count, CalculatedSize);
+}
+
+void AutoTypeLayout::MoveConstructTypeInstances(void* PlacementStorage, void* SrcInstances, const size_t Count) const
+{
+    if (TrailingArrayMember)
+    {
+        IDynamicTypeLayout::MoveConstructTypeInstances(PlacementStorage, SrcInstances, Count);
+        return;
+    }
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        std::memcpy(PlacementStorage, SrcInstances, CalculatedSize * Count);
+        return;
+    }
+    LifecyclePlan.MoveConstructInstances(PlacementStorage, SrcInstances, Count, CalculatedSize);
+}
+
+void FTypeLifecyclePlan::AppendPlan(const FTypeLifecyclePlan& OtherPlan, const int64_t BaseOffset)
+{
+    const auto AppendShiftedSteps = [BaseOffset](std::vector<FLifecyclePlanStep>& Steps, const std::vector<FLifecyclePlanStep>& OtherSteps, const bool bMergeOverPadding = true)
+    {
+        for (FLifecyclePlanStep Step : OtherSteps)
+        {
+            Step.Offset += BaseOffset;
+            if (Step.Kind == ELifecyclePlanStepKind::ZeroFill || Step.Kind == ELifecyclePlanStepKind::CopyBytes)
+            {
+                AppendByteRange(Steps, Step.Kind, Step.Offset, Step.Size, bMergeOverPadding);
+            }
+            else
+            {
+                Steps.push_back(Step);
+            }
+        }
+    };
+    AppendShiftedSteps(ConstructSteps, OtherPlan.ConstructSteps);
+    AppendShiftedSteps(ConstructFromSteps, OtherPlan.ConstructFromSteps);
+    AppendShiftedSteps(DestructSteps, OtherPlan.DestructSteps);
+    AppendShiftedSteps(AssignSteps, OtherPlan.AssignSteps);
+    AppendShiftedSteps(SerializeSteps, OtherPlan.SerializeSteps, false);
+    AppendShiftedSteps(CompareSteps, OtherPlan.CompareSteps, false);
+}
+
+void FTypeLifecyclePlan::AppendMember(const IMemberTypeDescriptor* MemberType, const int64_t MemberOffset, const int32_t ArrayDim, const bool bIsTransient)
+{
+    const int64_t ElementSize = static_cast<int64_t>(MemberType->GetMemberSize());
+
+    // Nested dynamic types with automatic layout are inlined into this plan instead of being called through the descriptor
+    if (const AutoTypeLayout* NestedAutoTypeLayout = CastDynamicTypeImpl<AutoTypeLayout>(MemberType->GetDynamicType()))
+    {
+        for (int32_t ElementIndex = 0; ElementIndex < ArrayDim; ElementIndex++)
+        {
+            AppendPlan(NestedAutoTypeLayout->GetLifecyclePlan(), MemberOffset + ElementIndex * ElementSize);
+        }
+        return;
+    }
+
+    // Elements of the trivial arrays are merged into a single byte range by AppendByteRange
+    for (int32_t ElementIndex = 0; ElementIndex < ArrayDim; ElementIndex++)
+    {
+        FLifecyclePlanStep MemberStep;
+        MemberStep.Kind = ELifecyclePlanStepKind::MemberValue;
+        MemberStep.Offset = MemberOffset + ElementIndex * ElementSize;
+        MemberStep.MemberType = MemberType;
+        AppendIndirectStep(MemberStep, MemberType->GetTypeFlags(), MemberType->GetMemberSize(), bIsTransient);
+    }
+}
+
+void FTypeLifecyclePlan::AppendOpaqueType(const IDynamicTypeLayout* OpaqueType, const int64_t TypeOffset)
+{
+    // Types without any storage have no state to construct, destroy or copy
+    if (OpaqueType->GetSize() == 0)
+    {
+        return;
+    }
+
+    // Opaque types still report their traits, so trivial ones can be coalesced the same way as trivial members
+    FLifecyclePlanStep OpaqueTypeStep;
+    OpaqueTypeStep.Kind = ELifecyclePlanStepKind::OpaqueType;
+    OpaqueTypeStep.Offset = TypeOffset;
+    OpaqueTypeStep.OpaqueType = OpaqueType;
+    AppendIndirectStep(OpaqueTypeStep, OpaqueType->GetTypeFlags(), OpaqueType->GetSize(), false);
+}
+
+void FTypeLifecyclePlan::AppendVirtualFunctionTable(const GenericFunctionPtr* VirtualFunctionTable, const int64_t TableDisplacement)
+{
+    FLifecyclePlanStep VirtualFunctionTableStep;
+    VirtualFunctionTableStep.Kind = ELifecyclePlanStepKind::VirtualFunctionTable;
+    VirtualFunctionTableStep.Offset = TableDisplacement;
+    VirtualFunctionTableStep.VirtualFunctionTable = VirtualFunctionTable;
+
+    // Virtual function table pointer is only written on construction. Assignment keeps the table of the destination instance,
+    // so the step is a no-op there, but it still prevents the surrounding byte ranges from being merged over the table pointer
+    ConstructSteps.push_back(VirtualFunctionTableStep);
+    ConstructFromSteps.push_back(VirtualFunctionTableStep);
+    AssignSteps.push_back(VirtualFunctionTableStep);
+}
+
+void FTypeLifecyclePlan::ReplaceVirtualFunctionTable(const GenericFunctionPtr* NewVirtualFunctionTable, const int64_t TableDisplacement)
+{
+    bool bReplacedExistingTable = false;
+    for (std::vector<FLifecyclePlanStep>* Steps : {&ConstructSteps, &ConstructFromSteps, &AssignSteps})
+    {
+        for (FLifecyclePlanStep& Step : *Steps)
+        {
+            if (Step.Kind == ELifecyclePlanStepKind::VirtualFunctionTable && Step.Offset == TableDisplacement)
+            {
+                Step.VirtualFunctionTable = NewVirtualFunctionTable;
+                bReplacedExistingTable = true;
+            }
+        }
+    }
+    // Parent type did not write the table itself (e.g. it has an opaque layout), so we have to do it
+    if (!bReplacedExistingTable)
+    {
+        AppendVirtualFunctionTable(NewVirtualFunctionTable, TableDisplacement);
+    }
+}
+
+void FTypeLifecyclePlan::Reset()
+{
+    ConstructSteps.clear();
+    ConstructFromSteps.clear();
+    DestructSteps.clear();
+    AssignSteps.clear();
+    SerializeSteps.clear();
+    CompareSteps.clear();
+}
+
+void FTypeLifecyclePlan::AppendIndirectStep(const FLifecyclePlanStep& IndirectStep, const EMemberTypeFlags TypeFlags, const size_t Size, const bool bIsTransient)
+{
+    // Trivial values are coalesced into byte ranges, or skipped entirely for destruction
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::ZeroConstructible))
+    {
+        AppendByteRange(ConstructSteps, ELifecyclePlanStepKind::ZeroFill, IndirectStep.Offset, Size);
+    }
+    else
+    {
+        ConstructSteps.push_back(IndirectStep);
+    }
+    if (!EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyDestructible))
+    {
+        DestructSteps.push_back(IndirectStep);
+    }
+    if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+    {
+        AppendByteRange(ConstructFromSteps, ELifecyclePlanStepKind::CopyBytes, IndirectStep.Offset, Size);
+        AppendByteRange(AssignSteps, ELifecyclePlanStepKind::CopyBytes, IndirectStep.Offset, Size);
+    }
+    else
+    {
+        ConstructFromSteps.push_back(IndirectStep);
+        AssignSteps.push_back(IndirectStep);
+    }
+    if (!bIsTransient)
+    {
+        if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::TriviallyCopyable))
+        {
+            AppendByteRange(SerializeSteps, ELifecyclePlanStepKind::CopyBytes, IndirectStep.Offset, Size, false);
+        }
+        else
+        {
+            SerializeSteps.push_back(IndirectStep);
+        }
+        if (EnumHasAnyFlags(TypeFlags, EMemberTypeFlags::BitwiseComparable))
+        {
+            AppendByteRange(CompareSteps, ELifecyclePlanStepKind::CopyBytes, IndirectStep.Offset, Size, false);
+        }
+        else
+        {
+            CompareSteps.push_back(IndirectStep);
+        }
+    }
+}
+
+void FTypeLifecyclePlan::AppendByteRange(std::vector<FLifecyclePlanStep>& Steps, const ELifecyclePlanStepKind Kind, const int64_t Offset, const size_t Size, const bool bMergeOverPadding)
+{
+    if (Size == 0)
+    {
+        return;
+    }
+    // Merge with the previous range if there are no other steps in between. The gap between them can only be padding, which is safe to include into the range
+    const int64_t PreviousRangeEnd = Steps.empty() ? -1 : Steps.back().Offset + static_cast<int64_t>(Steps.back().Size);
+    if (!Steps.empty() && Steps.back().Kind == Kind && (bMergeOverPadding ? PreviousRangeEnd <= Offset : PreviousRangeEnd == Offset))
+    {
+        Steps.back().Size = static_cast<size_t>(Offset - Steps.back().Offset) + Size;
+        return;
+    }
+
+    FLifecyclePlanStep ByteRangeStep;
+    ByteRangeStep.Kind = Kind;
+    ByteRangeStep.Offset = Offset;
+    ByteRangeStep.Size = Size;
+    Steps.push_back(ByteRangeStep);
+}
+
+/**
+ * Destroys the values constructed by the steps before the one that has thrown, and by that step for the instances before the one that has thrown
+ * Values are destroyed by the destruct steps, which are matched to the construction step covering their offset, since trivial values are constructed by the byte ranges
+ */
+static void DestructConstructedValues(const std::vector<FLifecyclePlanStep>& ConstructionSteps, const std::vector<FLifecyclePlanStep>& DestructSteps, const size_t FailedStepIndex,
+    const size_t FailedInstanceIndex, uint8_t* InstancesBase, const size_t Count, const size_t Stride)
+{
+    for (auto DestructStep = DestructSteps.rbegin(); DestructStep != DestructSteps.rend(); ++DestructStep)
+    {
+        const auto ConstructsValue = [&](const FLifecyclePlanStep& ConstructionStep)
+        {
+            if (ConstructionStep.Kind == ELifecyclePlanStepKind::ZeroFill || ConstructionStep.Kind == ELifecyclePlanStepKind::CopyBytes)
+            {
+                return DestructStep->Offset >= ConstructionStep.Offset && DestructStep->Offset < ConstructionStep.Offset + static_cast<int64_t>(ConstructionStep.Size);
+            }
+            return ConstructionStep.Kind == DestructStep->Kind && ConstructionStep.Offset == DestructStep->Offset;
+        };
+        const auto FailedStep = ConstructionSteps.begin() + static_cast<std::ptrdiff_t>(FailedStepIndex);
+        const auto ConstructionStep = std::find_if(ConstructionSteps.begin(), FailedStep + 1, ConstructsValue);
+        const size_t NumConstructedInstances = ConstructionStep == FailedStep ? FailedInstanceIndex : ConstructionStep < FailedStep ? Count : 0;
+
+        uint8_t* StepData = InstancesBase + DestructStep->Offset;
+        for (size_t InstanceIndex = NumConstructedInstances; InstanceIndex-- > 0;)
+        {
+            if (DestructStep->Kind == ELifecyclePlanStepKind::MemberValue)
+            {
+                DestructStep->MemberType->DestructValue(StepData + InstanceIndex * Stride);
+            }
+            else if (DestructStep->Kind == ELifecyclePlanStepKind::OpaqueType)
+            {
+                DestructStep->OpaqueType->DestructTypeInstance(StepData + InstanceIndex * Stride);
+            }
+        }
+    }
+}
+
+void FTypeLifecyclePlan::EmplaceInstances(void* Instances, const size_t Count, const size_t Stride) const
+{
+    uint8_t* InstancesBase = static_cast<uint8_t*>(Instances);
+    // Step and instance that are being constructed, so the values constructed before them can be destroyed if the construction throws
+    size_t StepIndex = 0;
+    size_t InstanceIndex = 0;
+    try
+    {
+        for (; StepIndex < ConstructSteps.size(); StepIndex++)
+        {
+            const FLifecyclePlanStep& Step = ConstructSteps[StepIndex];
+            uint8_t* StepData = InstancesBase + Step.Offset;
+            switch (Step.Kind)
+            {
+                case ELifecyclePlanStepKind::ZeroFill:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        std::memset(StepData + InstanceIndex * Stride, 0, Step.Size);
+                    }
+                    break;
+                case ELifecyclePlanStepKind::VirtualFunctionTable:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        *reinterpret_cast<const GenericFunctionPtr**>(StepData + InstanceIndex * Stride) = Step.VirtualFunctionTable;
+                    }
+                    break;
+                case ELifecyclePlanStepKind::MemberValue:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        Step.MemberType->EmplaceValue(StepData + InstanceIndex * Stride);
+                    }
+                    break;
+                case ELifecyclePlanStepKind::OpaqueType:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        Step.OpaqueType->EmplaceTypeInstance(StepData + InstanceIndex * Stride);
+                    }
+                    break;
+                default: break;
+            }
+        }
+    }
+    catch (...)
+    {
+        DestructConstructedValues(ConstructSteps, DestructSteps, StepIndex, InstanceIndex, InstancesBase, Count, Stride);
+        throw;
+    }
+}
+
+void FTypeLifecyclePlan::DestructInstances(void* Instances, const size_t Count, const size_t Stride) const
+{
+    uint8_t* InstancesBase = static_cast<uint8_t*>(Instances);
+    for (const FLifecyclePlanStep& Step : DestructSteps)
+    {
+        uint8_t* StepData = InstancesBase + Step.Offset;
+        switch (Step.Kind)
+        {
+            case ELifecyclePlanStepKind::MemberValue:
+                for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                {
+                    Step.MemberType->DestructValue(StepData + InstanceIndex * Stride);
+                }
+                break;
+            case ELifecyclePlanStepKind::OpaqueType:
+                for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                {
+                    Step.OpaqueType->DestructTypeInstance(StepData + InstanceIndex * Stride);
+                }
+                break;
+            default: break;
+        }
+    }
+}
+
+/** Lifecycle operations that take a source instance. They share the plan steps and only differ in the indirect calls */
+enum class ELifecycleFromOperation : uint8_t
+{
+    CopyConstruct,
+    MoveConstruct,
+    CopyAssign,
+    MoveAssign,
+};
+
+/**
+ * Executes the steps for all the instances, steps in the outer loop. Constructing operations destroy the values they have constructed if one of the steps throws,
+ * while assignments leave the instances constructed, with the values before the failed one already assigned
+ */
+template<ELifecycleFromOperation Operation>
+static void ExecuteLifecycleFromPlan(const std::vector<FLifecyclePlanStep>& Steps, const std::vector<FLifecyclePlanStep>& DestructSteps, void* DestInstances, const void* SrcInstances, const size_t Count, const size_t Stride)
+{
+    constexpr bool bIsConstructing = Operation == ELifecycleFromOperation::CopyConstruct || Operation == ELifecycleFromOperation::MoveConstruct;
+    uint8_t* DestInstancesBase = static_cast<uint8_t*>(DestInstances);
+    // Move operations take the source by mutable pointer, the const is only added to share the implementation with the copy operations
+    uint8_t* SrcInstancesBase = const_cast<uint8_t*>(static_cast<const uint8_t*>(SrcInstances));
+    size_t StepIndex = 0;
+    size_t InstanceIndex = 0;
+    try
+    {
+        for (; StepIndex < Steps.size(); StepIndex++)
+        {
+            const FLifecyclePlanStep& Step = Steps[StepIndex];
+            uint8_t* DestStepData = DestInstancesBase + Step.Offset;
+            uint8_t* SrcStepData = SrcInstancesBase + Step.Offset;
+            switch (Step.Kind)
+            {
+                case ELifecyclePlanStepKind::CopyBytes:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        std::memcpy(DestStepData + InstanceIndex * Stride, SrcStepData + InstanceIndex * Stride, Step.Size);
+                    }
+                    break;
+                case ELifecyclePlanStepKind::VirtualFunctionTable:
+                    // Only constructing operations install the virtual function table, assignment keeps the one of the destination
+                    if constexpr (bIsConstructing)
+                    {
+                        for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                        {
+                            *reinterpret_cast<const GenericFunctionPtr**>(DestStepData + InstanceIndex * Stride) = Step.VirtualFunctionTable;
+                        }
+                    }
+                    break;
+                case ELifecyclePlanStepKind::MemberValue:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        uint8_t* DestValue = DestStepData + InstanceIndex * Stride;
+                        uint8_t* SrcValue = SrcStepData + InstanceIndex * Stride;
+                        if constexpr (Operation == ELifecycleFromOperation::CopyConstruct) { Step.MemberType->CopyConstructValue(DestValue, SrcValue); }
+                        else if constexpr (Operation == ELifecycleFromOperation::MoveConstruct) { Step.MemberType->MoveConstructValue(DestValue, SrcValue); }
+                        else if constexpr (Operation == ELifecycleFromOperation::CopyAssign) { Step.MemberType->CopyAssignValue(DestValue, SrcValue); }
+                        else { Step.MemberType->MoveAssignValue(DestValue, SrcValue); }
+                    }
+                    break;
+                case ELifecyclePlanStepKind::OpaqueType:
+                    for (InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+                    {
+                        uint8_t* DestValue = DestStepData + InstanceIndex * Stride;
+                        uint8_t* SrcValue = SrcStepData + InstanceIndex * Stride;
+                        if constexpr (Operation == ELifecycleFromOperation::CopyConstruct) { Step.OpaqueType->CopyConstructTypeInstance(DestValue, SrcValue); }
+                        else if constexpr (Operation == ELifecycleFromOperation::MoveConstruct) { Step.OpaqueType->MoveConstructTypeInstance(DestValue, SrcValue); }
+                        else if constexpr (Operation == ELifecycleFromOperation::CopyAssign) { Step.OpaqueType->CopyAssignTypeInstance(DestValue, SrcValue); }
+                        else { Step.OpaqueType->MoveAssignTypeInstance(DestValue, SrcValue); }
+                    }
+                    break;
+                default: break;
+            }
+        }
+    }
+    catch (...)
+    {
+        if constexpr (bIsConstructing)
+        {
+            DestructConstructedValues(Steps, DestructSteps, StepIndex, InstanceIndex, DestInstancesBase, Count, Stride);
+        }
+        throw;
+    }
+}
+
+void FTypeLifecyclePlan::CopyAssignInstances(void* DestInstances, const void* SrcInstances, const size_t Count, const size_t Stride) const
+{
+    ExecuteLifecycleFromPlan<ELifecycleFromOperation::CopyAssign>(AssignSteps, DestructSteps, DestInstances, SrcInstances, Count, Stride);
+}
+
+void FTypeLifecyclePlan::MoveAssignInstances(void* DestInstances, void* SrcInstances, const size_t Count, const size_t Stride) const
+{
+    ExecuteLifecycleFromPlan<ELifecycleFromOperation::MoveAssign>(AssignSteps, DestructSteps, DestInstances, SrcInstances, Count, Stride);
+}
+
+void FTypeLifecyclePlan::CopyConstructInstances(void* DestInstances, const void* SrcInstances, const size_t Count, const size_t Stride) const
+{
+    ExecuteLifecycleFromPlan<ELifecycleFromOperation::CopyConstruct>(ConstructFromSteps, DestructSteps, DestInstances, SrcInstances, Count, Stride);
+}
+
+void FTypeLifecyclePlan::MoveConstructInstances(void* DestInstances, void* SrcInstances, const size_t Count, const size_t Stride) const
+{
+    ExecuteLifecycleFromPlan<ELifecycleFromOperation::MoveConstruct>(ConstructFromSteps, DestructSteps, DestInstances, SrcInstances, Count, Stride);
+}
+
+void FTypeLifecyclePlan::SerializeInstances(const void* Instances, const size_t Count, const size_t Stride, IDynamicTypeWriter& Writer) const
+{
+    // Unlike the other operations, the stream has to contain the instances one after another, so the instances are iterated in the outer loop
+    for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+    {
+        const uint8_t* InstanceBase = static_cast<const uint8_t*>(Instances) + InstanceIndex * Stride;
+        for (const FLifecyclePlanStep& Step : SerializeSteps)
+        {
+            switch (Step.Kind)
+            {
+                case ELifecyclePlanStepKind::CopyBytes: Writer.Write(InstanceBase + Step.Offset, Step.Size); break;
+                case ELifecyclePlanStepKind::MemberValue: Step.MemberType->SerializeValue(InstanceBase + Step.Offset, Writer); break;
+                case ELifecyclePlanStepKind::OpaqueType: Step.OpaqueType->SerializeTypeInstance(InstanceBase + Step.Offset, Writer); break;
+                default: break;
+            }
+        }
+    }
+}
+
+void FTypeLifecyclePlan::DeserializeInstances(void* Instances, const size_t Count, const size_t Stride, IDynamicTypeReader& Reader) const
+{
+    for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+    {
+        uint8_t* InstanceBase = static_cast<uint8_t*>(Instances) + InstanceIndex * Stride;
+        for (const FLifecyclePlanStep& Step : SerializeSteps)
+        {
+            switch (Step.Kind)
+            {
+                case ELifecyclePlanStepKind::CopyBytes: Reader.Read(InstanceBase + Step.Offset, Step.Size); break;
+                case ELifecyclePlanStepKind::MemberValue: Step.MemberType->DeserializeValue(InstanceBase + Step.Offset, Reader); break;
+                case ELifecyclePlanStepKind::OpaqueType: Step.OpaqueType->DeserializeTypeInstance(InstanceBase + Step.Offset, Reader); break;
+                default: break;
+            }
+        }
+    }
+}
+
+bool FTypeLifecyclePlan::IsSerializedAsSingleByteRange(const size_t InstanceSize) const
+{
+    return SerializeSteps.size() == 1 && SerializeSteps[0].Kind == ELifecyclePlanStepKind::CopyBytes && SerializeSteps[0].Offset == 0 && SerializeSteps[0].Size == InstanceSize;
+}
+
+bool FTypeLifecyclePlan::EqualsInstance(const void* InstanceA, const void* InstanceB) const
+{
+    const uint8_t* InstanceBaseA = static_cast<const uint8_t*>(InstanceA);
+    const uint8_t* InstanceBaseB = static_cast<const uint8_t*>(InstanceB);
+    for (const FLifecyclePlanStep& Step : CompareSteps)
+    {
+        switch (Step.Kind)
+        {
+            case ELifecyclePlanStepKind::CopyBytes:
+                if (std::memcmp(InstanceBaseA + Step.Offset, InstanceBaseB + Step.Offset, Step.Size) != 0)
+                {
+                    return false;
+                }
+                break;
+            case ELifecyclePlanStepKind::MemberValue:
+                if (!Step.MemberType->EqualsValue(InstanceBaseA + Step.Offset, InstanceBaseB + Step.Offset))
+                {
+                    return false;
+                }
+                break;
+            case ELifecyclePlanStepKind::OpaqueType:
+                if (!Step.OpaqueType->EqualsTypeInstance(InstanceBaseA + Step.Offset, InstanceBaseB + Step.Offset))
+                {
+                    return false;
+                }
+                break;
+            default: break;
+        }
+    }
+    return true;
+}
+
+uint64_t FTypeLifecyclePlan::HashInstance(const void* Instance) const
+{
+    const uint8_t* InstanceBase = static_cast<const uint8_t*>(Instance);
+    uint64_t Hash = 0;
+    for (const FLifecyclePlanStep& Step : CompareSteps)
+    {
+        switch (Step.Kind)
+        {
+            // Byte ranges continue the hash instead of being combined with it, so the ranges split by the other steps cost the same as a single range
+            case ELifecyclePlanStepKind::CopyBytes: Hash = HashDynamicTypeBytes(InstanceBase + Step.Offset, Step.Size, Hash); break;
+            case ELifecyclePlanStepKind::MemberValue: Hash = CombineDynamicTypeHash(Hash, Step.MemberType->HashValue(InstanceBase + Step.Offset)); break;
+            case ELifecyclePlanStepKind::OpaqueType: Hash = CombineDynamicTypeHash(Hash, Step.OpaqueType->HashTypeInstance(InstanceBase + Step.Offset)); break;
+            default: break;
+        }
+    }
+    return Hash;
+}
+
+bool FTypeLifecyclePlan::IsComparedAsSingleByteRange(const size_t InstanceSize) const
+{
+    // Instances without any storage are trivially equal
+    if (InstanceSize == 0)
+    {
+        return CompareSteps.empty();
+    }
+    return CompareSteps.size() == 1 && CompareSteps[0].Kind == ELifecyclePlanStepKind::CopyBytes && CompareSteps[0].Offset == 0 && CompareSteps[0].Size == InstanceSize;
+}
+
+uintptr_t PackedTypeLayout::StaticTypeIdToken()
+{
+    static uint8_t StaticTypeIdToken;
+    return reinterpret_cast<uintptr_t>(&StaticTypeIdToken);
+}
+
+uint64_t PackedTypeLayout::CalculateStructuralHash(const size_t InTypeOffset, const size_t InTypeAlignment) const
+{
+    // Members are reordered, so the packed layout of the type differs from the auto layout of the same type
+    constexpr uint64_t PackedTypeLayoutSalt = HashDynamicTypeName(DTL_TEXT("PackedTypeLayout"));
+    return FDynamicTypeHashBuilder().Add(AutoTypeLayout::CalculateStructuralHash(InTypeOffset, InTypeAlignment)).Add(PackedTypeLayoutSalt).GetHash();
+}
+
+bool PackedTypeLayout::ApplyCachedLayout(const FCachedTypeLayout& CachedLayout, const size_t InTypeOffset, const size_t InTypeAlignment)
+{
+    // Cached layout skips sorting the members and filling the holes, but the declaration order size is still reported
+    if (!AutoTypeLayout::ApplyCachedLayout(CachedLayout, InTypeOffset, InTypeAlignment))
+    {
+        return false;
+    }
+    CalculateDeclarationOrderSize(InTypeOffset, InTypeAlignment);
+    return true;
+}
+
+void PackedTypeLayout::CalculateDeclarationOrderSize(const size_t InTypeOffset, const size_t InTypeAlignment)
+{
+    size_t DeclarationOrderOffset = InTypeOffset;
+    size_t DeclarationOrderAlignment = InTypeAlignment;
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        if (Member->IsTrailingArray())
+        {
+            continue;
+        }
+        const size_t MemberAlignment = GetEffectiveMemberAlignment(Member);
+        DeclarationOrderOffset = Align(DeclarationOrderOffset, MemberAlignment) + Member->GetMemberStorageSize();
+        DeclarationOrderAlignment = std::max(DeclarationOrderAlignment, MemberAlignment);
+    }
+    DeclarationOrderSize = Align(DeclarationOrderOffset, DeclarationOrderAlignment);
+}
+
+void PackedTypeLayout::LayoutTypeMembers(size_t& InOutTypeOffset, size_t& InOutTypeAlignment)
+{
+    // Calculate the size the type would have in declaration order to be able to report the savings
+    CalculateDeclarationOrderSize(InOutTypeOffset, InOutTypeAlignment);
+
+    // Hot members go first, then default ones, then cold ones. Within the group, members with larger alignment go first,
+    // which leaves no padding between them since the size of the type is always a multiple of it's alignment
+    const auto GetLayoutHintRank = [](const FDynamicTypeMember* Member)
+    {
+        switch (Member->GetLayoutHint())
+        {
+            case EMemberLayoutHint::Hot: return 0;
+            case EMemberLayoutHint::Cold: return 2;
+            default: return 1;
+        }
+    };
+    // Trailing array is placed by InitializeDynamicType after the fixed part of the instance
+    std::vector<FDynamicTypeMember*> SortedMembers;
+    std::ranges::copy_if(TypeMembers, std::back_inserter(SortedMembers), [](const FDynamicTypeMember* Member) { return !Member->IsTrailingArray(); });
+    std::ranges::stable_sort(SortedMembers, [&](const FDynamicTypeMember* A, const FDynamicTypeMember* B)
+    {
+        const int32_t RankA = GetLayoutHintRank(A);
+        const int32_t RankB = GetLayoutHintRank(B);
+        return RankA != RankB ? RankA < RankB : GetEffectiveMemberAlignment(A) > GetEffectiveMemberAlignment(B);
+    });
+
+    // Padding left behind by aligning the members (at the start of each group, or by overaligned members) is filled by the smaller members that follow.
+    // Holes are only filled by the members of the same group, otherwise cold members would end up in between the hot ones
+    struct FPaddingHole
+    {
+        size_t Offset;
+        size_t Size;
+    };
+    std::vector<FPaddingHole> PaddingHoles;
+    int32_t CurrentLayoutHintRank = -1;
+
+    for (FDynamicTypeMember* Member : SortedMembers)
+    {
+        const size_t MemberAlignment = GetEffectiveMemberAlignment(Member);
+        const size_t MemberSize = Member->GetMemberStorageSize();
+        InOutTypeAlignment = std::max(InOutTypeAlignment, MemberAlignment);
+
+        if (GetLayoutHintRank(Member) != CurrentLayoutHintRank)
+        {
+            CurrentLayoutHintRank = GetLayoutHintRank(Member);
+            PaddingHoles.clear();
+        }
+
+        // Members with the alignment override are never placed into the holes, since the holes cannot be aligned to more than the alignment of the members that left them
+        bool bPlacedIntoHole = false;
+        for (auto HoleIterator = PaddingHoles.begin(); Member->GetAlignmentOverride() == 0 && HoleIterator != PaddingHoles.end(); ++HoleIterator)
+        {
+            const FPaddingHole Hole = *HoleIterator;
+            const size_t MemberOffset = Align(Hole.Offset, MemberAlignment);
+            if (MemberOffset + MemberSize <= Hole.Offset + Hole.Size)
+            {
+                Member->Internal_SetupMemberOffset(static_cast<int64_t>(MemberOffset));
+
+                // Split the hole into the parts before and after the member
+                HoleIterator = PaddingHoles.erase(HoleIterator);
+                if (MemberOffset + MemberSize < Hole.Offset + Hole.Size)
+                {
+                    HoleIterator = PaddingHoles.insert(HoleIterator, FPaddingHole{MemberOffset + MemberSize, Hole.Offset + Hole.Size - MemberOffset - MemberSize});
+                }
+                if (MemberOffset > Hole.Offset)
+                {
+                    PaddingHoles.insert(HoleIterator, FPaddingHole{Hole.Offset, MemberOffset - Hole.Offset});
+                }
+                bPlacedIntoHole = true;
+                break;
+            }
+        }
+
+        if (!bPlacedIntoHole)
+        {
+            const size_t MemberOffset = Align(InOutTypeOffset, MemberAlignment);
+            if (MemberOffset > InOutTypeOffset)
+            {
+                PaddingHoles.push_back(FPaddingHole{InOutTypeOffset, MemberOffset - InOutTypeOffset});
+            }
+            Member->Internal_SetupMemberOffset(static_cast<int64_t>(MemberOffset));
+            InOutTypeOffset = MemberOffset + MemberSize;
+
+            // Member with the alignment override (e.g. the cache line size) owns the whole aligned block, so the members that follow do not share it and cause false sharing.
+            // Padding after the member is not registered as a hole for the same reason
+            if (Member->GetAlignmentOverride() != 0)
+            {
+                InOutTypeOffset = Align(InOutTypeOffset, MemberAlignment);
+            }
+        }
     }
 }
@@ -0,0 +1,168 @@
+#include "DynamicTypeLayoutCache.h"
+#include "DynamicTypeImpl.h"
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+/** Header of the layout cache file. Files written by the builds with a different format or pointer size are rejected */
+struct FCacheFileHeader
+{
+    static constexpr uint32_t CacheFileMagic = 0x434C5444; // "DTLC"
+    static constexpr uint32_t CacheFileVersion = 1;
+
+    FMappedFileHeader FileHeader{CacheFileMagic, CacheFileVersion};
+    uint32_t NumEntries{0};
+};
+
+/** Entry of the index following the header, sorted by the structural hash. Points to the cached layout relative to the start of the file */
+struct FDynamicTypeLayoutCache::FCacheIndexEntry
+{
+    uint64_t StructuralHash{0};
+    uint64_t LayoutOffset{0};
+};
+
+FDynamicTypeLayoutCache& FDynamicTypeLayoutCache::Get()
+{
+    static FDynamicTypeLayoutCache LayoutCache;
+    return LayoutCache;
+}
+
+bool FDynamicTypeLayoutCache::LoadFromFile(const std::filesystem::path& FilePath)
+{
+    std::lock_guard Lock(LoadMutex);
+    CurrentCacheFile.store(nullptr, std::memory_order_release);
+
+    std::unique_ptr<FLoadedCacheFile> CacheFile = std::make_unique<FLoadedCacheFile>();
+    FMappedFile& MappedCacheFile = CacheFile->MappedFile;
+    if (!MappedCacheFile.Open(FilePath))
+    {
+        return false;
+    }
+    const uint8_t* FileData = MappedCacheFile.GetData();
+    const size_t FileSize = MappedCacheFile.GetSize();
+
+    FCacheFileHeader Header;
+    if (!MappedCacheFile.ReadHeader(Header) || Header.NumEntries > (FileSize - sizeof(FCacheFileHeader)) / sizeof(FCacheIndexEntry))
+    {
+        return false;
+    }
+
+    // Validate the index once, so that the lookups can trust the file structure. Layouts themselves are validated against the members when the types are initialized
+    const FCacheIndexEntry* LoadedIndexEntries = reinterpret_cast<const FCacheIndexEntry*>(FileData + sizeof(FCacheFileHeader));
+    for (uint32_t EntryIndex = 0; EntryIndex < Header.NumEntries; EntryIndex++)
+    {
+        const FCacheIndexEntry& IndexEntry = LoadedIndexEntries[EntryIndex];
+        if (IndexEntry.LayoutOffset % alignof(FCachedTypeLayout) != 0 || IndexEntry.LayoutOffset > FileSize || FileSize - IndexEntry.LayoutOffset < sizeof(FCachedTypeLayout) ||
+            (EntryIndex != 0 && LoadedIndexEntries[EntryIndex - 1].StructuralHash >= IndexEntry.StructuralHash))
+        {
+            return false;
+        }
+        const FCachedTypeLayout* CachedLayout = reinterpret_cast<const FCachedTypeLayout*>(FileData + IndexEntry.LayoutOffset);
+        if (CachedLayout->StructuralHash != IndexEntry.StructuralHash || (FileSize - IndexEntry.LayoutOffset - sizeof(FCachedTypeLayout)) / sizeof(FCachedMemberLayout) < CachedLayout->NumMembers)
+        {
+            return false;
+        }
+    }
+    CacheFile->IndexEntries = LoadedIndexEntries;
+    CacheFile->NumIndexEntries = Header.NumEntries;
+
+    // Release store publishes the validated file at once. Replaced files stay mapped, since concurrent lookups might still be reading them
+    CurrentCacheFile.store(CacheFile.get(), std::memory_order_release);
+    LoadedCacheFiles.push_back(std::move(CacheFile));
+    return true;
+}
+
+void FDynamicTypeLayoutCache::SaveToFile(const std::filesystem::path& FilePath)
+{
+    std::vector<const PackedTypeLayout*> TypeLayouts;
+    const FDynamicTypeRegistry& TypeRegistry = FDynamicTypeRegistry::Get();
+    for (uint32_t TypeId = 0; TypeId < TypeRegistry.GetNumTypes(); TypeId++)
+    {
+        if (const PackedTypeLayout* TypeLayout = CastDynamicTypeImpl<PackedTypeLayout>(TypeRegistry.FindTypeById(TypeId)))
+        {
+            TypeLayouts.push_back(TypeLayout);
+        }
+    }
+    SaveToFile(FilePath, TypeLayouts);
+}
+
+void FDynamicTypeLayoutCache::SaveToFile(const std::filesystem::path& FilePath, const std::vector<const PackedTypeLayout*>& TypeLayouts)
+{
+    std::vector<FCacheIndexEntry> NewIndexEntries;
+    std::vector<uint8_t> LayoutData;
+
+    for (const PackedTypeLayout* TypeLayout : TypeLayouts)
+    {
+        FCachedTypeLayout CachedLayout;
+        CachedLayout.StructuralHash = TypeLayout->GetStructuralHash();
+        CachedLayout.Size = TypeLayout->CalculatedSize;
+        CachedLayout.Alignment = TypeLayout->CalculatedAlignment;
+        CachedLayout.VirtualFunctionTableDisplacement = TypeLayout->VirtualFunctionTableDisplacement;
+        CachedLayout.TrailingArrayNumOffset = TypeLayout->TrailingArrayNumOffset;
+        CachedLayout.NumMembers = static_cast<uint32_t>(TypeLayout->TypeMembers.size());
+
+        // Members are sorted by their offset, which lets the layout be validated without sorting them again when it is loaded
+        std::vector<FCachedMemberLayout> CachedMembers;
+        CachedMembers.reserve(CachedLayout.NumMembers);
+        for (uint32_t MemberIndex = 0; MemberIndex < CachedLayout.NumMembers; MemberIndex++)
+        {
+            CachedMembers.push_back(FCachedMemberLayout{TypeLayout->TypeMembers[MemberIndex]->GetMemberOffset(), MemberIndex});
+        }
+        std::ranges::stable_sort(CachedMembers, {}, &FCachedMemberLayout::Offset);
+
+        // Offsets of the layouts are relative to the start of the layout data for now, and are rebased once the size of the index is known
+        NewIndexEntries.push_back(FCacheIndexEntry{CachedLayout.StructuralHash, LayoutData.size()});
+        const size_t LayoutOffset = LayoutData.size();
+        LayoutData.resize(LayoutOffset + sizeof(FCachedTypeLayout) + CachedMembers.size() * sizeof(FCachedMemberLayout));
+        std::memcpy(LayoutData.data() + LayoutOffset, &CachedLayout, sizeof(FCachedTypeLayout));
+        if (!CachedMembers.empty())
+        {
+            std::memcpy(LayoutData.data() + LayoutOffset + sizeof(FCachedTypeLayout), CachedMembers.data(), CachedMembers.size() * sizeof(FCachedMemberLayout));
+        }
+    }
+
+    // Types with the same structural hash have the same layout, so only one entry per hash is needed
+    std::ranges::sort(NewIndexEntries, {}, &FCacheIndexEntry::StructuralHash);
+    const auto DuplicateEntries = std::ranges::unique(NewIndexEntries, {}, &FCacheIndexEntry::StructuralHash);
+    NewIndexEntries.erase(DuplicateEntries.begin(), DuplicateEntries.end());
+
+    FCacheFileHeader Header;
+    Header.NumEntries = static_cast<uint32_t>(NewIndexEntries.size());
+    const uint64_t LayoutDataOffset = sizeof(FCacheFileHeader) + NewIndexEntries.size() * sizeof(FCacheIndexEntry);
+    for (FCacheIndexEntry& IndexEntry : NewIndexEntries)
+    {
+        IndexEntry.LayoutOffset += LayoutDataOffset;
+    }
+
+    WriteFileAtomically(FilePath, [&](std::ostream& CacheFile)
+    {
+        CacheFile.write(reinterpret_cast<const char*>(&Header), sizeof(FCacheFileHeader));
+        CacheFile.write(reinterpret_cast<const char*>(NewIndexEntries.data()), static_cast<std::streamsize>(NewIndexEntries.size() * sizeof(FCacheIndexEntry)));
+        CacheFile.write(reinterpret_cast<const char*>(LayoutData.data()), static_cast<std::streamsize>(LayoutData.size()));
+    });
+}
+
+const FCachedTypeLayout* FDynamicTypeLayoutCache::FindTypeLayout(const uint64_t StructuralHash) const
+{
+    const FLoadedCacheFile* CacheFile = CurrentCacheFile.load(std::memory_order_acquire);
+    if (CacheFile == nullptr)
+    {
+        return nullptr;
+    }
+    const FCacheIndexEntry* IndexEnd = CacheFile->IndexEntries + CacheFile->NumIndexEntries;
+    const FCacheIndexEntry* IndexEntry = std::lower_bound(CacheFile->IndexEntries, IndexEnd, StructuralHash, [](const FCacheIndexEntry& Entry, const uint64_t Hash)
+    {
+        return Entry.StructuralHash < Hash;
+    });
+    if (IndexEntry == IndexEnd || IndexEntry->StructuralHash != StructuralHash)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const FCachedTypeLayout*>(CacheFile->MappedFile.GetData() + IndexEntry->LayoutOffset);
+}
+
+uint32_t FDynamicTypeLayoutCache::GetNumTypes() const
+{
+    const FLoadedCacheFile* CacheFile = CurrentCacheFile.load(std::memory_order_acquire);
+    return CacheFile ? CacheFile->NumIndexEntries : 0;
+}
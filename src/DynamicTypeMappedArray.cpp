@@ -0,0 +1,99 @@
+#include "DynamicTypeMappedArray.h"
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include "DynamicTypeSchema.h"
+
+/** Header of the mapped instance array file. Instances start at the data offset, which is aligned to the alignment of the type */
+struct FMappedArrayFileHeader
+{
+    static constexpr uint32_t MappedArrayFileMagic = 0x41445444; // "DTDA"
+    static constexpr uint32_t MappedArrayFileVersion = 1;
+    /** Minimum alignment of the instance data within the file. Mapped files start at the page boundary, so any alignment up to the page size is preserved */
+    static constexpr uint64_t MinDataAlignment = 64;
+
+    FMappedFileHeader FileHeader{MappedArrayFileMagic, MappedArrayFileVersion};
+    uint32_t Reserved{0};
+    uint64_t SchemaFingerprint{0};
+    uint64_t InstanceSize{0};
+    uint64_t InstanceAlignment{1};
+    uint64_t NumInstances{0};
+    uint64_t DataOffset{0};
+};
+
+static void CheckMappedArrayType(const IDynamicTypeLayout* DynamicType)
+{
+    DynamicType->EnsureInitialized();
+    if (!EnumHasAnyFlags(DynamicType->GetTypeFlags(), EMemberTypeFlags::TriviallyCopyable))
+    {
+        throw std::runtime_error("Only trivially copyable dynamic types can be persisted as mapped arrays");
+    }
+}
+
+void FDynamicTypeMappedArray::SaveToFile(const std::filesystem::path& FilePath, const IDynamicTypeLayout* InDynamicType, const void* TypeInstances, const size_t Count)
+{
+    CheckMappedArrayType(InDynamicType);
+
+    FMappedArrayFileHeader Header;
+    Header.SchemaFingerprint = FDynamicTypeSchema::FromType(InDynamicType).GetFingerprint();
+    Header.InstanceSize = InDynamicType->GetSize();
+    Header.InstanceAlignment = InDynamicType->GetMinAlignment();
+    Header.NumInstances = Count;
+    const uint64_t DataAlignment = std::max(Header.InstanceAlignment, FMappedArrayFileHeader::MinDataAlignment);
+    Header.DataOffset = (sizeof(FMappedArrayFileHeader) + DataAlignment - 1) / DataAlignment * DataAlignment;
+
+    WriteFileAtomically(FilePath, [&](std::ostream& MappedArrayFile)
+    {
+        const char HeaderPadding[FMappedArrayFileHeader::MinDataAlignment]{};
+        MappedArrayFile.write(reinterpret_cast<const char*>(&Header), sizeof(FMappedArrayFileHeader));
+        for (uint64_t PaddingSize = Header.DataOffset - sizeof(FMappedArrayFileHeader); PaddingSize != 0;)
+        {
+            const uint64_t PaddingChunkSize = std::min<uint64_t>(PaddingSize, sizeof(HeaderPadding));
+            MappedArrayFile.write(HeaderPadding, static_cast<std::streamsize>(PaddingChunkSize));
+            PaddingSize -= PaddingChunkSize;
+        }
+        if (Count != 0)
+        {
+            MappedArrayFile.write(static_cast<const char*>(TypeInstances), static_cast<std::streamsize>(Header.InstanceSize * Count));
+        }
+    });
+}
+
+bool FDynamicTypeMappedArray::Open(const std::filesystem::path& FilePath, const IDynamicTypeLayout* InDynamicType)
+{
+    Close();
+    CheckMappedArrayType(InDynamicType);
+    if (!MappedArrayFile.Open(FilePath))
+    {
+        return false;
+    }
+    const uint8_t* FileData = MappedArrayFile.GetData();
+    const size_t FileSize = MappedArrayFile.GetSize();
+
+    // Fingerprint covers the size and the member layout of the type, while the alignment is checked separately since it decides whenever the mapped instances can be used in place.
+    // Instances must not start inside the header, otherwise the header bytes would be read as the instance data
+    FMappedArrayFileHeader Header;
+    const size_t InstanceSize = InDynamicType->GetSize();
+    if (!MappedArrayFile.ReadHeader(Header) || Header.InstanceSize != InstanceSize || Header.InstanceAlignment != InDynamicType->GetMinAlignment() ||
+        Header.DataOffset % Header.InstanceAlignment != 0 || Header.DataOffset < sizeof(FMappedArrayFileHeader) || Header.DataOffset > FileSize ||
+        (InstanceSize != 0 && Header.NumInstances > (FileSize - Header.DataOffset) / InstanceSize) ||
+        Header.SchemaFingerprint != FDynamicTypeSchema::FromType(InDynamicType).GetFingerprint())
+    {
+        MappedArrayFile.Close();
+        return false;
+    }
+    DynamicType = InDynamicType;
+    Instances = FileData + Header.DataOffset;
+    Stride = InstanceSize;
+    NumInstances = static_cast<size_t>(Header.NumInstances);
+    return true;
+}
+
+void FDynamicTypeMappedArray::Close()
+{
+    MappedArrayFile.Close();
+    DynamicType = nullptr;
+    Instances = nullptr;
+    Stride = 0;
+    NumInstances = 0;
+}
@@ -0,0 +1,143 @@
+#include "DynamicTypeMappedFile.h"
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+FMappedFile::~FMappedFile()
+{
+    Close();
+}
+
+FMappedFile::FMappedFile(FMappedFile&& Other) noexcept : Data(std::exchange(Other.Data, nullptr)), Size(std::exchange(Other.Size, 0))
+{
+}
+
+FMappedFile& FMappedFile::operator=(FMappedFile&& Other) noexcept
+{
+    if (this != &Other)
+    {
+        Close();
+        Data = std::exchange(Other.Data, nullptr);
+        Size = std::exchange(Other.Size, 0);
+    }
+    return *this;
+}
+
+void WriteFileAtomically(const std::filesystem::path& FilePath, const std::function<void(std::ostream&)>& WriteFileContents)
+{
+    std::filesystem::path TemporaryFilePath = FilePath;
+    TemporaryFilePath += ".tmp";
+    {
+        std::ofstream TemporaryFile(TemporaryFilePath, std::ios::binary | std::ios::trunc);
+        WriteFileContents(TemporaryFile);
+        if (!TemporaryFile.flush())
+        {
+            TemporaryFile.close();
+            std::error_code RemoveError;
+            std::filesystem::remove(TemporaryFilePath, RemoveError);
+            throw std::runtime_error("Failed to write the file " + FilePath.string());
+        }
+    }
+    std::error_code RenameError;
+    std::filesystem::rename(TemporaryFilePath, FilePath, RenameError);
+    if (RenameError)
+    {
+        std::filesystem::remove(TemporaryFilePath, RenameError);
+        throw std::runtime_error("Failed to replace the file " + FilePath.string());
+    }
+}
+
+#ifdef _WIN32
+
+bool FMappedFile::Open(const std::filesystem::path& FilePath)
+{
+    Close();
+    const HANDLE FileHandle = CreateFileW(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (FileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(FileHandle, &FileSize) || FileSize.QuadPart == 0)
+    {
+        CloseHandle(FileHandle);
+        return false;
+    }
+    // View keeps the mapping object alive, so both handles can be closed right away
+    const HANDLE MappingHandle = CreateFileMappingW(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(FileHandle);
+    if (MappingHandle == nullptr)
+    {
+        return false;
+    }
+    const void* MappedView = MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(MappingHandle);
+    if (MappedView == nullptr)
+    {
+        return false;
+    }
+    Data = static_cast<const uint8_t*>(MappedView);
+    Size = static_cast<size_t>(FileSize.QuadPart);
+    return true;
+}
+
+void FMappedFile::Close()
+{
+    if (Data)
+    {
+        UnmapViewOfFile(Data);
+        Data = nullptr;
+        Size = 0;
+    }
+}
+
+#else
+
+bool FMappedFile::Open(const std::filesystem::path& FilePath)
+{
+    Close();
+    const int FileDescriptor = open(FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FileDescriptor == -1)
+    {
+        return false;
+    }
+    struct stat FileStat{};
+    if (fstat(FileDescriptor, &FileStat) != 0 || FileStat.st_size == 0)
+    {
+        close(FileDescriptor);
+        return false;
+    }
+    // Mapping keeps the file alive, so the descriptor can be closed right away
+    void* MappedView = mmap(nullptr, static_cast<size_t>(FileStat.st_size), PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+    close(FileDescriptor);
+    if (MappedView == MAP_FAILED)
+    {
+        return false;
+    }
+    Data = static_cast<const uint8_t*>(MappedView);
+    Size = static_cast<size_t>(FileStat.st_size);
+    return true;
+}
+
+void FMappedFile::Close()
+{
+    if (Data)
+    {
+        munmap(const_cast<uint8_t*>(Data), Size);
+        Data = nullptr;
+        Size = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "DynamicTypeDefs.h"
+#include <mutex>
+#include <unordered_map>
+
+struct FDynamicTypeName::FNameEntry
+{
+    dtl_string String;
+    uint64_t Hash{0};
+};
+
+const FDynamicTypeName::FNameEntry* FDynamicTypeName::FindOrAddNameEntry(const dtl_string_view InName, const bool bAddIfNotFound)
+{
+    struct FNameHash
+    {
+        size_t operator()(const dtl_string_view Name) const { return HashDynamicTypeName(Name); }
+    };
+    // Name table is a function-local static because names are interned during the static initialization of the dynamic types. Entries are never freed,
+    // so the keys can point directly to the strings owned by the entries
+    static std::mutex NameTableMutex;
+    static std::unordered_map<dtl_string_view, std::unique_ptr<FNameEntry>, FNameHash> NameTable;
+
+    // Empty string is represented by the none name
+    if (InName.empty())
+    {
+        return nullptr;
+    }
+
+    std::lock_guard Lock(NameTableMutex);
+    if (const auto ExistingEntry = NameTable.find(InName); ExistingEntry != NameTable.end())
+    {
+        return ExistingEntry->second.get();
+    }
+    if (!bAddIfNotFound)
+    {
+        return nullptr;
+    }
+    auto NewNameEntry = std::make_unique<FNameEntry>(FNameEntry{dtl_string(InName), HashDynamicTypeName(InName)});
+    const FNameEntry* NewNameEntryPtr = NewNameEntry.get();
+    NameTable.emplace(dtl_string_view(NewNameEntryPtr->String), std::move(NewNameEntry));
+    return NewNameEntryPtr;
+}
+
+FDynamicTypeName::FDynamicTypeName(const dtl_string_view InName) : NameEntry(FindOrAddNameEntry(InName, true))
+{
+}
+
+FDynamicTypeName FDynamicTypeName::Find(const dtl_string_view InName)
+{
+    return FDynamicTypeName(FindOrAddNameEntry(InName, false));
+}
+
+const dtl_string& FDynamicTypeName::ToString() const
+{
+    static const dtl_string NoneString;
+    return NameEntry ? NameEntry->String : NoneString;
+}
+
+uint64_t FDynamicTypeName::GetHash() const
+{
+    return NameEntry ? NameEntry->Hash : HashDynamicTypeName(dtl_string_view());
+}
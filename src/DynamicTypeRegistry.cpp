@@ -0,0 +1,261 @@
+#include "DynamicTypeDefs.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+/** Open addressing hash table of the registered types keyed by the type name. Slots are only ever filled, never cleared */
+struct FDynamicTypeRegistry::FTypeNameTable
+{
+    size_t IndexMask{0};
+    std::unique_ptr<std::atomic<IDynamicTypeLayout*>[]> Slots;
+
+    explicit FTypeNameTable(const size_t InCapacity) : IndexMask(InCapacity - 1), Slots(std::make_unique<std::atomic<IDynamicTypeLayout*>[]>(InCapacity))
+    {
+    }
+
+    [[nodiscard]] size_t GetCapacity() const { return IndexMask + 1; }
+
+    void Add(IDynamicTypeLayout* Type) const
+    {
+        size_t SlotIndex = Type->GetInternedTypeName().GetHash() & IndexMask;
+        while (Slots[SlotIndex].load(std::memory_order_relaxed) != nullptr)
+        {
+            SlotIndex = (SlotIndex + 1) & IndexMask;
+        }
+        // Release store publishes the fully initialized type to the readers probing this table
+        Slots[SlotIndex].store(Type, std::memory_order_release);
+    }
+
+    template<typename InPredicateType>
+    [[nodiscard]] IDynamicTypeLayout* Find(const uint64_t NameHash, InPredicateType&& Predicate) const
+    {
+        for (size_t SlotIndex = NameHash & IndexMask;; SlotIndex = (SlotIndex + 1) & IndexMask)
+        {
+            IDynamicTypeLayout* Type = Slots[SlotIndex].load(std::memory_order_acquire);
+            if (Type == nullptr || Predicate(Type))
+            {
+                return Type;
+            }
+        }
+    }
+};
+
+FDynamicTypeRegistry::FDynamicTypeRegistry() : CurrentTypeNameTable(std::make_unique<FTypeNameTable>(64))
+{
+    TypeNameTable.store(CurrentTypeNameTable.get(), std::memory_order_release);
+}
+
+FDynamicTypeRegistry::~FDynamicTypeRegistry()
+{
+    for (std::atomic<IDynamicTypeLayout**>& TypeChunk : TypeChunks)
+    {
+        delete[] TypeChunk.load(std::memory_order_relaxed);
+    }
+}
+
+FDynamicTypeRegistry& FDynamicTypeRegistry::Get()
+{
+    static FDynamicTypeRegistry TypeRegistry;
+    return TypeRegistry;
+}
+
+void FDynamicTypeRegistry::AddTypeToNameTable(IDynamicTypeLayout* Type)
+{
+    // Keep the load factor of the table below 1/2. When the table is full, a new one is populated and then published, so the readers always see a complete table
+    const uint32_t NumTypes = NumRegisteredTypes.load(std::memory_order_relaxed);
+    if ((static_cast<size_t>(NumTypes) + 1) * 2 > CurrentTypeNameTable->GetCapacity())
+    {
+        auto NewTypeNameTable = std::make_unique<FTypeNameTable>(CurrentTypeNameTable->GetCapacity() * 2);
+        for (uint32_t ExistingTypeId = 0; ExistingTypeId < NumTypes; ExistingTypeId++)
+        {
+            NewTypeNameTable->Add(FindRegisteredTypeById(ExistingTypeId));
+        }
+        TypeNameTable.store(NewTypeNameTable.get(), std::memory_order_release);
+        RetiredTypeNameTables.push_back(std::move(CurrentTypeNameTable));
+        CurrentTypeNameTable = std::move(NewTypeNameTable);
+    }
+    CurrentTypeNameTable->Add(Type);
+}
+
+/** Converts the type name for the error messages. Characters outside of ASCII are replaced, since the messages are narrow strings */
+static std::string GetTypeNameForErrorMessage(const dtl_string& TypeName)
+{
+    std::string Result;
+    Result.reserve(TypeName.size());
+    for (const DTL_CHAR Character : TypeName)
+    {
+        Result.push_back(Character >= 0x20 && Character < 0x7F ? static_cast<char>(Character) : '?');
+    }
+    return Result;
+}
+
+void FDynamicTypeRegistry::RegisterType(IDynamicTypeLayout* Type)
+{
+    std::lock_guard Lock(RegistrationMutex);
+
+    if (Type->IsRegistered())
+    {
+        throw std::runtime_error("Dynamic type has already been registered");
+    }
+    if (FindRegisteredTypeByInternedName(Type->GetInternedTypeName()) != nullptr)
+    {
+        // Names are the unqualified class names, so this is usually the same class name used in two namespaces
+        throw std::runtime_error("Dynamic type named '" + GetTypeNameForErrorMessage(Type->GetTypeName()) + "' has already been registered. Type names are not qualified by the namespace and must be unique across the whole program");
+    }
+    const uint32_t NewTypeId = NumRegisteredTypes.load(std::memory_order_relaxed);
+    const uint32_t TypeChunkIndex = NewTypeId >> TypeChunkSizeLog2;
+    if (TypeChunkIndex >= MaxTypeChunks)
+    {
+        throw std::runtime_error("Maximum number of registered dynamic types exceeded");
+    }
+
+    IDynamicTypeLayout** TypeChunk = TypeChunks[TypeChunkIndex].load(std::memory_order_relaxed);
+    if (TypeChunk == nullptr)
+    {
+        TypeChunk = new IDynamicTypeLayout*[TypeChunkSize]{};
+        TypeChunks[TypeChunkIndex].store(TypeChunk, std::memory_order_release);
+    }
+    Type->TypeId = NewTypeId;
+    TypeChunk[NewTypeId & (TypeChunkSize - 1)] = Type;
+
+    AddTypeToNameTable(Type);
+    if (Type->ParentType)
+    {
+        Type->NextSiblingType.store(Type->ParentType->FirstChildType.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        Type->ParentType->FirstChildType.store(Type, std::memory_order_release);
+    }
+    // Publishing the new number of types makes the type reachable by it's ID
+    NumRegisteredTypes.store(NewTypeId + 1, std::memory_order_release);
+}
+
+IDynamicTypeLayout* FDynamicTypeRegistry::FindRegisteredTypeById(const uint32_t TypeId) const
+{
+    if (TypeId >= NumRegisteredTypes.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+    IDynamicTypeLayout* const* TypeChunk = TypeChunks[TypeId >> TypeChunkSizeLog2].load(std::memory_order_acquire);
+    return TypeChunk[TypeId & (TypeChunkSize - 1)];
+}
+
+IDynamicTypeLayout* FDynamicTypeRegistry::FindRegisteredTypeByInternedName(const FDynamicTypeName& TypeName) const
+{
+    if (TypeName.IsNone())
+    {
+        return nullptr;
+    }
+    return TypeNameTable.load(std::memory_order_acquire)->Find(TypeName.GetHash(), [&](const IDynamicTypeLayout* Type)
+    {
+        return Type->GetInternedTypeName() == TypeName;
+    });
+}
+
+IDynamicTypeLayout* FDynamicTypeRegistry::FindTypeById(const uint32_t TypeId) const
+{
+    IDynamicTypeLayout* Type = FindRegisteredTypeById(TypeId);
+    if (Type)
+    {
+        Type->EnsureInitialized();
+    }
+    return Type;
+}
+
+IDynamicTypeLayout* FDynamicTypeRegistry::FindTypeByInternedName(const FDynamicTypeName& TypeName) const
+{
+    IDynamicTypeLayout* Type = FindRegisteredTypeByInternedName(TypeName);
+    if (Type)
+    {
+        Type->EnsureInitialized();
+    }
+    return Type;
+}
+
+IDynamicTypeLayout* FDynamicTypeRegistry::FindTypeByName(const dtl_string_view TypeName) const
+{
+    if (TypeName.empty())
+    {
+        return nullptr;
+    }
+    IDynamicTypeLayout* FoundType = TypeNameTable.load(std::memory_order_acquire)->Find(HashDynamicTypeName(TypeName), [&](const IDynamicTypeLayout* Type)
+    {
+        return Type->GetTypeName() == TypeName;
+    });
+    if (FoundType)
+    {
+        FoundType->EnsureInitialized();
+    }
+    return FoundType;
+}
+
+std::vector<IDynamicTypeLayout*> FDynamicTypeRegistry::GetChildTypes(const IDynamicTypeLayout* ParentType, const bool bRecursive)
+{
+    std::vector<IDynamicTypeLayout*> ChildTypes;
+    for (IDynamicTypeLayout* ChildType = ParentType->GetFirstChildType(); ChildType != nullptr; ChildType = ChildType->GetNextSiblingType())
+    {
+        ChildTypes.push_back(ChildType);
+    }
+    if (bRecursive)
+    {
+        // Children appended by the loop below are visited as well, so this performs a breadth-first walk of the whole subtree
+        for (size_t ChildTypeIndex = 0; ChildTypeIndex < ChildTypes.size(); ChildTypeIndex++)
+        {
+            for (IDynamicTypeLayout* ChildType = ChildTypes[ChildTypeIndex]->GetFirstChildType(); ChildType != nullptr; ChildType = ChildType->GetNextSiblingType())
+            {
+                ChildTypes.push_back(ChildType);
+            }
+        }
+    }
+    return ChildTypes;
+}
+
+void FDynamicTypeRegistry::InitializeAllTypes(const uint32_t NumThreads) const
+{
+    const uint32_t NumWorkerThreads = NumThreads != 0 ? NumThreads : std::max(std::thread::hardware_concurrency(), 1u);
+
+    // Threads claim the types by their IDs. Initializing the type might register the types of it's members, which are then claimed by the same loop.
+    // ID is only claimed once the type with that ID exists, so the types registered after a thread has found no more work are still picked up by the thread that registered them
+    std::atomic<uint32_t> NextTypeId{0};
+    std::mutex FailureMutex;
+    std::exception_ptr FirstFailure;
+    const auto InitializeTypes = [&]()
+    {
+        uint32_t TypeId = NextTypeId.load(std::memory_order_relaxed);
+        while (TypeId < GetNumTypes())
+        {
+            if (!NextTypeId.compare_exchange_weak(TypeId, TypeId + 1, std::memory_order_relaxed))
+            {
+                continue;
+            }
+            try
+            {
+                FindRegisteredTypeById(TypeId)->EnsureInitialized();
+            }
+            catch (...)
+            {
+                std::lock_guard Lock(FailureMutex);
+                if (!FirstFailure)
+                {
+                    FirstFailure = std::current_exception();
+                }
+            }
+            TypeId = NextTypeId.load(std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::jthread> WorkerThreads;
+    WorkerThreads.reserve(NumWorkerThreads - 1);
+    for (uint32_t ThreadIndex = 1; ThreadIndex < NumWorkerThreads; ThreadIndex++)
+    {
+        WorkerThreads.emplace_back(InitializeTypes);
+    }
+    // Calling thread does it's share of the work too
+    InitializeTypes();
+    WorkerThreads.clear();
+
+    if (FirstFailure)
+    {
+        std::rethrow_exception(FirstFailure);
+    }
+}
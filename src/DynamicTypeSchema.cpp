@@ -0,0 +1,239 @@
+#include "DynamicTypeSchema.h"
+#include "DynamicTypeSerialization.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+/** Header of the serialized schema, followed by the schema members */
+struct FSchemaHeader
+{
+    static constexpr uint32_t SchemaMagic = 0x53435444; // "DTCS"
+    static constexpr uint32_t SchemaVersion = 2;
+
+    uint32_t Magic{SchemaMagic};
+    uint32_t Version{SchemaVersion};
+    uint64_t Fingerprint{0};
+    uint64_t RecordSize{0};
+};
+
+FDynamicTypeSchema FDynamicTypeSchema::FromType(const IDynamicTypeLayout* DynamicType)
+{
+    DynamicType->EnsureInitialized();
+    if (DynamicType->HasTrailingArray())
+    {
+        throw std::runtime_error("Types with a trailing array do not have a fixed-size record schema");
+    }
+
+    FDynamicTypeSchema Schema;
+    Schema.RecordSize = DynamicType->GetSize();
+    Schema.AppendTypeMembers(DynamicType, 0, 0, false);
+    Schema.Fingerprint = Schema.CalculateFingerprint();
+    return Schema;
+}
+
+void FDynamicTypeSchema::AppendTypeMembers(const IDynamicTypeLayout* DynamicType, const int64_t BaseOffset, const uint64_t BaseMemberKey, const bool bIsOptional)
+{
+    if (const IDynamicTypeLayout* ParentType = DynamicType->GetParentType())
+    {
+        AppendTypeMembers(ParentType, BaseOffset, BaseMemberKey, bIsOptional);
+    }
+
+    const uint64_t TypeNameHash = HashDynamicTypeName(DynamicType->GetTypeName());
+    for (const FDynamicTypeMember* Member : DynamicType->GetTypeMembers())
+    {
+        // Unresolved optional members are not a part of the record
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        const uint64_t MemberKey = FDynamicTypeHashBuilder().Add(BaseMemberKey).Add(TypeNameHash).Add(HashDynamicTypeName(Member->GetName())).GetHash();
+        const bool bIsMemberOptional = bIsOptional || Member->IsOptionalMember();
+        const IMemberTypeDescriptor* MemberType = Member->GetType();
+
+        // Nested dynamic types are flattened, each element of the array getting it's own path
+        if (const IDynamicTypeLayout* NestedType = MemberType->GetDynamicType())
+        {
+            for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+            {
+                const int64_t ElementOffset = BaseOffset + Member->GetMemberOffset() + ElementIndex * static_cast<int64_t>(MemberType->GetMemberSize());
+                AppendTypeMembers(NestedType, ElementOffset, FDynamicTypeHashBuilder().Add(MemberKey).Add(ElementIndex).GetHash(), bIsMemberOptional);
+            }
+            continue;
+        }
+
+        FDynamicTypeSchemaMember& SchemaMember = Members.emplace_back();
+        SchemaMember.MemberKey = MemberKey;
+        SchemaMember.TypeNameHash = HashDynamicTypeName(MemberType->GetTypeName());
+        SchemaMember.Offset = BaseOffset + Member->GetMemberOffset();
+        SchemaMember.ElementSize = MemberType->GetMemberSize();
+        SchemaMember.ArrayDim = Member->GetArrayDim();
+        SchemaMember.TypeFlags = static_cast<uint32_t>(MemberType->GetTypeFlags());
+        SchemaMember.bIsOptional = bIsMemberOptional;
+    }
+}
+
+uint64_t FDynamicTypeSchema::CalculateFingerprint() const
+{
+    FDynamicTypeHashBuilder HashBuilder;
+    HashBuilder.Add(RecordSize).Add(static_cast<uint64_t>(Members.size()));
+    for (const FDynamicTypeSchemaMember& Member : Members)
+    {
+        // Only the trivial copyability decides whenever the member can be carried over from the raw record. Other traits can change without changing the record layout
+        const uint32_t TriviallyCopyableFlag = Member.TypeFlags & static_cast<uint32_t>(EMemberTypeFlags::TriviallyCopyable);
+        HashBuilder.Add(Member.MemberKey).Add(Member.TypeNameHash).Add(Member.Offset).Add(Member.ElementSize).Add(Member.ArrayDim).Add(TriviallyCopyableFlag);
+    }
+    return HashBuilder.GetHash();
+}
+
+void FDynamicTypeSchema::Serialize(IDynamicTypeWriter& Writer) const
+{
+    FSchemaHeader Header;
+    Header.Fingerprint = Fingerprint;
+    Header.RecordSize = RecordSize;
+    Writer.Write(&Header, sizeof(Header));
+    WriteSerializedNum(Writer, Members.size());
+    Writer.Write(Members.data(), Members.size() * sizeof(FDynamicTypeSchemaMember));
+}
+
+FDynamicTypeSchema FDynamicTypeSchema::Deserialize(IDynamicTypeReader& Reader)
+{
+    FSchemaHeader Header;
+    Reader.Read(&Header, sizeof(Header));
+    const FSchemaHeader ExpectedHeader;
+    if (Header.Magic != ExpectedHeader.Magic || Header.Version != ExpectedHeader.Version)
+    {
+        throw std::runtime_error("Data is not a dynamic type schema or has been written by an incompatible version");
+    }
+
+    FDynamicTypeSchema Schema;
+    Schema.RecordSize = Header.RecordSize;
+    Schema.Members.resize(ReadSerializedNum(Reader, sizeof(FDynamicTypeSchemaMember)));
+    Reader.Read(Schema.Members.data(), Schema.Members.size() * sizeof(FDynamicTypeSchemaMember));
+
+    // Migration plans trust the offsets of the schema, so the members must fit into the record and the fingerprint must match the contents
+    for (const FDynamicTypeSchemaMember& Member : Schema.Members)
+    {
+        if (Member.Offset < 0 || Member.ArrayDim < 1 || Member.ElementSize > Schema.RecordSize ||
+            static_cast<uint64_t>(Member.Offset) > Schema.RecordSize || (Schema.RecordSize - Member.Offset) / std::max<uint64_t>(Member.ElementSize, 1) < static_cast<uint64_t>(Member.ArrayDim))
+        {
+            throw std::runtime_error("Dynamic type schema is corrupted");
+        }
+    }
+    Schema.Fingerprint = Schema.CalculateFingerprint();
+    if (Schema.Fingerprint != Header.Fingerprint)
+    {
+        throw std::runtime_error("Dynamic type schema is corrupted");
+    }
+    return Schema;
+}
+
+FDynamicTypeMigrationPlan::FDynamicTypeMigrationPlan(const FDynamicTypeSchema& SourceSchema, const IDynamicTypeLayout* InTargetType) :
+    TargetType(InTargetType), SourceFingerprint(SourceSchema.GetFingerprint()), SourceRecordSize(SourceSchema.GetRecordSize())
+{
+    const FDynamicTypeSchema TargetSchema = FDynamicTypeSchema::FromType(TargetType);
+
+    std::unordered_map<uint64_t, const FDynamicTypeSchemaMember*> SourceMembers;
+    for (const FDynamicTypeSchemaMember& SourceMember : SourceSchema.GetMembers())
+    {
+        SourceMembers.emplace(SourceMember.MemberKey, &SourceMember);
+    }
+
+    for (const FDynamicTypeSchemaMember& TargetMember : TargetSchema.GetMembers())
+    {
+        const auto SourceMemberIt = SourceMembers.find(TargetMember.MemberKey);
+        if (SourceMemberIt == SourceMembers.end())
+        {
+            if (!TargetMember.bIsOptional)
+            {
+                throw std::runtime_error("Member required by the target type is missing in the source schema");
+            }
+            continue;
+        }
+        const FDynamicTypeSchemaMember& SourceMember = *SourceMemberIt->second;
+        if (SourceMember.TypeNameHash != TargetMember.TypeNameHash || SourceMember.ElementSize != TargetMember.ElementSize)
+        {
+            if (!TargetMember.bIsOptional)
+            {
+                throw std::runtime_error("Member required by the target type has changed it's type in the source schema");
+            }
+            continue;
+        }
+        // Non-trivial values cannot be restored from the raw bytes of the record, so the optional ones keep their default value
+        const bool bTriviallyCopyable = EnumHasAnyFlags(static_cast<EMemberTypeFlags>(SourceMember.TypeFlags & TargetMember.TypeFlags), EMemberTypeFlags::TriviallyCopyable);
+        if (!bTriviallyCopyable)
+        {
+            if (!TargetMember.bIsOptional)
+            {
+                throw std::runtime_error("Member required by the target type is not trivially copyable and cannot be migrated from the raw records");
+            }
+            continue;
+        }
+        // Arrays that have grown keep the default value of the new elements, and the elements removed from the arrays that have shrunk are skipped
+        const size_t NumElements = static_cast<size_t>(std::min(SourceMember.ArrayDim, TargetMember.ArrayDim));
+        Steps.push_back(FMigrationStep{SourceMember.Offset, TargetMember.Offset, static_cast<size_t>(TargetMember.ElementSize) * NumElements});
+    }
+
+    // Coalesce the members that are adjacent in both the source record and the target instance
+    std::ranges::sort(Steps, {}, &FMigrationStep::TargetOffset);
+    std::vector<FMigrationStep> CoalescedSteps;
+    for (const FMigrationStep& Step : Steps)
+    {
+        if (Step.Size == 0)
+        {
+            continue;
+        }
+        if (!CoalescedSteps.empty())
+        {
+            FMigrationStep& PreviousStep = CoalescedSteps.back();
+            if (PreviousStep.SourceOffset + static_cast<int64_t>(PreviousStep.Size) == Step.SourceOffset && PreviousStep.TargetOffset + static_cast<int64_t>(PreviousStep.Size) == Step.TargetOffset)
+            {
+                PreviousStep.Size += Step.Size;
+                continue;
+            }
+        }
+        CoalescedSteps.push_back(Step);
+    }
+    Steps = std::move(CoalescedSteps);
+}
+
+const FDynamicTypeMigrationPlan& FDynamicTypeMigrationPlan::FindOrCompile(const FDynamicTypeSchema& SourceSchema, const IDynamicTypeLayout* TargetType)
+{
+    static std::mutex MigrationPlansMutex;
+    static std::map<std::pair<uint64_t, const IDynamicTypeLayout*>, std::unique_ptr<FDynamicTypeMigrationPlan>> MigrationPlans;
+
+    std::scoped_lock Lock(MigrationPlansMutex);
+    std::unique_ptr<FDynamicTypeMigrationPlan>& MigrationPlan = MigrationPlans[{SourceSchema.GetFingerprint(), TargetType}];
+    if (!MigrationPlan)
+    {
+        // Failed compilation leaves the empty entry behind, so it is retried and throws again on the next lookup
+        MigrationPlan = std::make_unique<FDynamicTypeMigrationPlan>(SourceSchema, TargetType);
+    }
+    return *MigrationPlan;
+}
+
+void FDynamicTypeMigrationPlan::MigrateRecords(const void* SourceRecords, const size_t Count, void* PlacementStorage) const
+{
+    TargetType->EmplaceTypeInstances(PlacementStorage, Count);
+
+    const uint8_t* SourceBase = static_cast<const uint8_t*>(SourceRecords);
+    uint8_t* TargetBase = static_cast<uint8_t*>(PlacementStorage);
+    const size_t TargetStride = TargetType->GetSize();
+
+    // Records of the unchanged trivially copyable types are copied in a single memcpy for the whole batch
+    if (Steps.size() == 1 && Steps[0].SourceOffset == 0 && Steps[0].TargetOffset == 0 && Steps[0].Size == SourceRecordSize && Steps[0].Size == TargetStride)
+    {
+        std::memcpy(TargetBase, SourceBase, TargetStride * Count);
+        return;
+    }
+    for (const FMigrationStep& Step : Steps)
+    {
+        for (size_t RecordIndex = 0; RecordIndex < Count; RecordIndex++)
+        {
+            std::memcpy(TargetBase + RecordIndex * TargetStride + Step.TargetOffset, SourceBase + RecordIndex * SourceRecordSize + Step.SourceOffset, Step.Size);
+        }
+    }
+}
@@ -0,0 +1,191 @@
+#include "DynamicTypeSerialization.h"
+#include <stdexcept>
+
+void IMemberTypeDescriptor::SerializeValue(const void* Data, IDynamicTypeWriter& Writer) const
+{
+    if (!IsTriviallyCopyable())
+    {
+        throw std::runtime_error("Member type does not support serialization");
+    }
+    Writer.Write(Data, GetMemberSize());
+}
+
+void IMemberTypeDescriptor::DeserializeValue(void* Data, IDynamicTypeReader& Reader) const
+{
+    if (!IsTriviallyCopyable())
+    {
+        throw std::runtime_error("Member type does not support serialization");
+    }
+    Reader.Read(Data, GetMemberSize());
+}
+
+void IDynamicTypeLayout::SerializeTypeInstance(const void* TypeInstance, IDynamicTypeWriter& Writer) const
+{
+    if (ParentType)
+    {
+        ParentType->SerializeTypeInstance(TypeInstance, Writer);
+    }
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        // Unresolved optional members have no storage in the instance
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+        {
+            Member->GetType()->SerializeValue(Member->ContainerPtrToValuePtr<void>(TypeInstance, ElementIndex), Writer);
+        }
+    }
+    if (HasTrailingArray())
+    {
+        SerializeTrailingArray(TypeInstance, Writer);
+    }
+}
+
+void IDynamicTypeLayout::DeserializeTypeInstance(void* TypeInstance, IDynamicTypeReader& Reader) const
+{
+    if (ParentType)
+    {
+        ParentType->DeserializeTypeInstance(TypeInstance, Reader);
+    }
+    for (const FDynamicTypeMember* Member : TypeMembers)
+    {
+        // Unresolved optional members have no storage in the instance
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        for (int32_t ElementIndex = 0; ElementIndex < Member->GetArrayDim(); ElementIndex++)
+        {
+            Member->GetType()->DeserializeValue(Member->ContainerPtrToValuePtr<void>(TypeInstance, ElementIndex), Reader);
+        }
+    }
+    if (HasTrailingArray())
+    {
+        DeserializeTrailingArray(TypeInstance, Reader);
+    }
+}
+
+void IDynamicTypeLayout::SerializeTypeInstances(const void* TypeInstances, const size_t Count, IDynamicTypeWriter& Writer) const
+{
+    const size_t Stride = GetSize();
+    for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+    {
+        SerializeTypeInstance(static_cast<const uint8_t*>(TypeInstances) + InstanceIndex * Stride, Writer);
+    }
+}
+
+void IDynamicTypeLayout::DeserializeTypeInstances(void* TypeInstances, const size_t Count, IDynamicTypeReader& Reader) const
+{
+    const size_t Stride = GetSize();
+    for (size_t InstanceIndex = 0; InstanceIndex < Count; InstanceIndex++)
+    {
+        DeserializeTypeInstance(static_cast<uint8_t*>(TypeInstances) + InstanceIndex * Stride, Reader);
+    }
+}
+
+void IDynamicTypeLayout::SerializeTrailingArray(const void* TypeInstance, IDynamicTypeWriter& Writer) const
+{
+    const FDynamicTypeMember* TrailingArrayMember = GetTrailingArrayMember();
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    const size_t TrailingArrayNum = GetTrailingArrayNum(TypeInstance);
+
+    WriteSerializedNum(Writer, TrailingArrayNum);
+    if (TrailingArrayNum == 0)
+    {
+        return;
+    }
+    // Elements are laid out contiguously, so trivially copyable elements are written with a single write
+    if (ElementType->IsTriviallyCopyable())
+    {
+        Writer.Write(TrailingArrayMember->ContainerPtrToValuePtr<void>(TypeInstance, 0), ElementType->GetMemberSize() * TrailingArrayNum);
+        return;
+    }
+    const uint8_t* TrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstance);
+    for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+    {
+        ElementType->SerializeValue(TrailingArrayData + ElementIndex * ElementType->GetMemberSize(), Writer);
+    }
+}
+
+void IDynamicTypeLayout::DeserializeTrailingArray(void* TypeInstance, IDynamicTypeReader& Reader) const
+{
+    const FDynamicTypeMember* TrailingArrayMember = GetTrailingArrayMember();
+    const IMemberTypeDescriptor* ElementType = TrailingArrayMember->GetType();
+    const size_t TrailingArrayNum = GetTrailingArrayNum(TypeInstance);
+
+    if (ReadSerializedNum(Reader, 0) != TrailingArrayNum)
+    {
+        throw std::runtime_error("Serialized instance has different number of trailing array elements than the instance it is deserialized into");
+    }
+    if (TrailingArrayNum == 0)
+    {
+        return;
+    }
+    if (ElementType->IsTriviallyCopyable())
+    {
+        Reader.Read(TrailingArrayMember->ContainerPtrToValuePtr<void>(TypeInstance, 0), ElementType->GetMemberSize() * TrailingArrayNum);
+        return;
+    }
+    uint8_t* TrailingArrayData = TrailingArrayMember->ContainerPtrToValuePtr<uint8_t>(TypeInstance);
+    for (size_t ElementIndex = 0; ElementIndex < TrailingArrayNum; ElementIndex++)
+    {
+        ElementType->DeserializeValue(TrailingArrayData + ElementIndex * ElementType->GetMemberSize(), Reader);
+    }
+}
+
+/** Appends the serialized layout of the type to the hash, in the same order SerializeTypeInstance writes the members */
+static void HashSerializedTypeMembers(const IDynamicTypeLayout* DynamicType, FDynamicTypeHashBuilder& HashBuilder)
+{
+    if (const IDynamicTypeLayout* ParentType = DynamicType->GetParentType())
+    {
+        HashSerializedTypeMembers(ParentType, HashBuilder);
+    }
+    for (const FDynamicTypeMember* Member : DynamicType->GetTypeMembers())
+    {
+        // Unresolved optional members are not written, so they are not a part of the serialized layout either
+        if (Member->GetMemberOffset() < 0)
+        {
+            continue;
+        }
+        const IMemberTypeDescriptor* MemberType = Member->GetType();
+        HashBuilder.Add(HashDynamicTypeName(Member->GetName())).Add(HashDynamicTypeName(MemberType->GetTypeName())).Add(Member->GetArrayDim()).Add(static_cast<uint64_t>(MemberType->GetMemberSize()));
+        if (const IDynamicTypeLayout* NestedType = MemberType->GetDynamicType())
+        {
+            HashSerializedTypeMembers(NestedType, HashBuilder);
+        }
+    }
+}
+
+uint64_t HashSerializedTypeLayout(const IDynamicTypeLayout* DynamicType)
+{
+    DynamicType->EnsureInitialized();
+    FDynamicTypeHashBuilder HashBuilder;
+    HashSerializedTypeMembers(DynamicType, HashBuilder);
+    return HashBuilder.GetHash();
+}
+
+void WriteDynamicTypeStreamHeader(const IDynamicTypeLayout* DynamicType, const size_t Count, IDynamicTypeWriter& Writer)
+{
+    FDynamicTypeStreamHeader Header;
+    Header.LayoutHash = HashSerializedTypeLayout(DynamicType);
+    Header.NumInstances = Count;
+    Writer.Write(&Header, sizeof(Header));
+}
+
+size_t ReadDynamicTypeStreamHeader(const IDynamicTypeLayout* DynamicType, IDynamicTypeReader& Reader)
+{
+    FDynamicTypeStreamHeader Header;
+    Reader.Read(&Header, sizeof(Header));
+    const FDynamicTypeStreamHeader ExpectedHeader;
+    if (Header.Magic != ExpectedHeader.Magic || Header.Version != ExpectedHeader.Version)
+    {
+        throw std::runtime_error("Data is not a stream of dynamic type instances or has been written by an incompatible version");
+    }
+    if (Header.LayoutHash != HashSerializedTypeLayout(DynamicType))
+    {
+        throw std::runtime_error("Serialized instances have been written with a different layout of the type");
+    }
+    return static_cast<size_t>(Header.NumInstances);
+}
@@ -0,0 +1,141 @@
+#include <set>
+#include "DynamicTypeTestUtils.h"
+
+/** Value aligned stricter than the default alignment of the operator new */
+struct alignas(64) FCacheLine
+{
+    uint64_t Words[8]{};
+};
+
+class FAlignedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FAlignedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(FCacheLine, Line)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FAlignedRecord)
+
+static bool IsAligned(const void* Memory, const size_t Alignment)
+{
+    return reinterpret_cast<uintptr_t>(Memory) % Alignment == 0;
+}
+
+/** Freed blocks are handed out again before the pool allocates a new slab */
+static void TestPoolReusesFreedBlocks()
+{
+    constexpr size_t BlocksPerSlab = 4;
+    FDynamicTypeSlabPool Pool(24, 8, BlocksPerSlab);
+    DTL_TEST_CHECK(Pool.GetBlockSize() == 24);
+
+    std::set<void*> Blocks;
+    for (size_t BlockIndex = 0; BlockIndex < BlocksPerSlab; BlockIndex++)
+    {
+        void* Block = Pool.Allocate();
+        DTL_TEST_CHECK(IsAligned(Block, 8));
+        Blocks.insert(Block);
+    }
+    DTL_TEST_CHECK(Blocks.size() == BlocksPerSlab);
+
+    // Blocks are reused in the reverse order of freeing them
+    void* FirstBlock = *Blocks.begin();
+    void* LastBlock = *Blocks.rbegin();
+    Pool.Free(FirstBlock);
+    Pool.Free(LastBlock);
+    DTL_TEST_CHECK(Pool.Allocate() == LastBlock);
+    DTL_TEST_CHECK(Pool.Allocate() == FirstBlock);
+
+    // Pool is exhausted now, so the next block comes from the new slab
+    DTL_TEST_CHECK(!Blocks.contains(Pool.Allocate()));
+}
+
+/** Blocks of the pool are large enough to hold the free list pointer, and are aligned to the requested alignment */
+static void TestPoolBlockSizeAndAlignment()
+{
+    FDynamicTypeSlabPool SmallBlockPool(1, 1);
+    DTL_TEST_CHECK(SmallBlockPool.GetBlockSize() == sizeof(void*));
+
+    FDynamicTypeSlabPool AlignedBlockPool(72, 64, 3);
+    DTL_TEST_CHECK(AlignedBlockPool.GetBlockSize() == 128);
+    for (int32_t BlockIndex = 0; BlockIndex < 8; BlockIndex++)
+    {
+        DTL_TEST_CHECK(IsAligned(AlignedBlockPool.Allocate(), 64));
+    }
+}
+
+/** Allocations that do not fit into the rest of the block spill into the next one, and Reset reuses the blocks from the start */
+static void TestArenaSpillsIntoNewBlock()
+{
+    FDynamicTypeArena Arena(256);
+    uint8_t* First = static_cast<uint8_t*>(Arena.Allocate(200, 8));
+    uint8_t* Second = static_cast<uint8_t*>(Arena.Allocate(40, 8));
+    DTL_TEST_CHECK(Second == First + 200);
+
+    // Does not fit into the 16 bytes left in the first block
+    uint8_t* Spilled = static_cast<uint8_t*>(Arena.Allocate(32, 8));
+    DTL_TEST_CHECK(Spilled < First || Spilled >= First + 256);
+
+    // Larger than the default block size, so it gets a dedicated block
+    uint8_t* Large = static_cast<uint8_t*>(Arena.Allocate(1024, 16));
+    DTL_TEST_CHECK(IsAligned(Large, 16));
+
+    Arena.Reset();
+    DTL_TEST_CHECK(Arena.Allocate(200, 8) == First);
+}
+
+/** Alignment padding that would run past the end of the block moves the allocation into the next block instead */
+static void TestArenaAlignmentPastBlockEnd()
+{
+    FDynamicTypeArena Arena(128);
+    uint8_t* First = static_cast<uint8_t*>(Arena.Allocate(120, 1));
+    uint8_t* Aligned = static_cast<uint8_t*>(Arena.Allocate(1, 256));
+    DTL_TEST_CHECK(IsAligned(Aligned, 256));
+    DTL_TEST_CHECK(Aligned < First || Aligned >= First + 128);
+}
+
+/** Every allocator policy places the over-aligned type at it's alignment */
+template<typename InAllocator>
+static void CheckOverAlignedInstances()
+{
+    constexpr size_t NumInstances = 8;
+    Dyn<FAlignedRecord, InAllocator> Instances[NumInstances];
+    for (size_t InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+    {
+        Instances[InstanceIndex]->GetId() = static_cast<int32_t>(InstanceIndex);
+        DTL_TEST_CHECK(IsAligned(&*Instances[InstanceIndex], alignof(FCacheLine)));
+        DTL_TEST_CHECK(IsAligned(&Instances[InstanceIndex]->GetLine(), alignof(FCacheLine)));
+    }
+    for (size_t InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+    {
+        DTL_TEST_CHECK(Instances[InstanceIndex]->GetId() == static_cast<int32_t>(InstanceIndex));
+    }
+}
+
+static void TestOverAlignedTypes()
+{
+    DTL_TEST_CHECK(FAlignedRecord::StaticType()->GetMinAlignment() >= alignof(FCacheLine));
+    CheckOverAlignedInstances<FDynHeapAllocator>();
+    CheckOverAlignedInstances<FDynPoolAllocator>();
+
+    FDynamicTypeArena Arena(256);
+    FDynamicTypeArenaScope ArenaScope(Arena);
+    CheckOverAlignedInstances<FDynArenaAllocator>();
+}
+
+/** Arena allocator needs the arena to be current on the thread */
+static void TestArenaAllocatorWithoutArena()
+{
+    DTL_TEST_CHECK(FDynamicTypeArena::GetCurrent() == nullptr);
+    DTL_TEST_CHECK_THROWS(FDynArenaAllocator::Allocate(FAlignedRecord::StaticType(), FAlignedRecord::StaticType()->GetSize()));
+}
+
+int main()
+{
+    TestPoolReusesFreedBlocks();
+    TestPoolBlockSizeAndAlignment();
+    TestArenaSpillsIntoNewBlock();
+    TestArenaAlignmentPastBlockEnd();
+    TestOverAlignedTypes();
+    TestArenaAllocatorWithoutArena();
+    return 0;
+}
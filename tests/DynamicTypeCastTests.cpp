@@ -0,0 +1,81 @@
+#include "DynamicTypeTestUtils.h"
+
+class FActor : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FActor, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Health)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_WITH_TYPE_HEADER(FActor)
+
+class FKnight : public FActor
+{
+    DYNAMIC_TYPE_BODY(FKnight, FActor, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Armor)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FKnight)
+
+class FScout : public FActor
+{
+    DYNAMIC_TYPE_BODY(FScout, FActor, )
+    DEFINE_TYPE_MEMBER_REF(float, Speed)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FScout)
+
+class FPlainRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FPlainRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int64_t, Value)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FPlainRecord)
+
+class FPlainRecordChild : public FPlainRecord
+{
+    DYNAMIC_TYPE_BODY(FPlainRecordChild, FPlainRecord, )
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FPlainRecordChild)
+
+/** Downcasts read the most derived type of the instance from the type header of the parent type */
+static void TestDowncastUsesInstanceType()
+{
+    Dyn<FKnight> Knight;
+    FActor* Actor = CastDynamic<FActor>(&*Knight);
+    DTL_TEST_CHECK(Actor != nullptr);
+
+    DTL_TEST_CHECK(CastDynamic<FKnight>(Actor) == &*Knight);
+    DTL_TEST_CHECK(CastDynamic<FScout>(Actor) == nullptr);
+    DTL_TEST_CHECK(CastDynamic<FKnight>(static_cast<const FActor*>(Actor)) == &*Knight);
+
+    Dyn<FActor> PlainActor;
+    DTL_TEST_CHECK(CastDynamic<FKnight>(&*PlainActor) == nullptr);
+    DTL_TEST_CHECK(CastDynamic<FKnight>(static_cast<FActor*>(nullptr)) == nullptr);
+}
+
+/** Upcasts never read the instance, so they work for the types without the type header too */
+static void TestUpcastWithoutTypeHeader()
+{
+    Dyn<FPlainRecordChild> Child;
+    DTL_TEST_CHECK(CastDynamic<FPlainRecord>(&*Child) == static_cast<void*>(&*Child));
+    DTL_TEST_CHECK(CastDynamic<FDynamicTypeBase>(&*Child) == static_cast<void*>(&*Child));
+}
+
+/** Type of the instance cannot be known without the type header, so the downcast fails instead of guessing, even if the instance is of the target type */
+static void TestDowncastWithoutTypeHeaderFails()
+{
+    Dyn<FPlainRecordChild> Child;
+    FPlainRecord* Record = CastDynamic<FPlainRecord>(&*Child);
+    DTL_TEST_CHECK(CastDynamic<FPlainRecordChild>(Record) == nullptr);
+    DTL_TEST_CHECK(CastDynamic<FPlainRecordChild>(static_cast<const FPlainRecord*>(Record)) == nullptr);
+}
+
+int main()
+{
+    TestDowncastUsesInstanceType();
+    TestUpcastWithoutTypeHeader();
+    TestDowncastWithoutTypeHeaderFails();
+    return 0;
+}
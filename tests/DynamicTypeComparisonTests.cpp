@@ -0,0 +1,224 @@
+#include <functional>
+#include <string>
+#include <vector>
+#include "DynamicTypeTestUtils.h"
+
+/** Key whose equality ignores the cached value, so two keys with different bytes can still be equal */
+struct FCachedKey
+{
+    int32_t Id;
+    int32_t CachedValue;
+
+    bool operator==(const FCachedKey& Other) const { return Id == Other.Id; }
+};
+
+template<>
+struct std::hash<FCachedKey>
+{
+    size_t operator()(const FCachedKey& Key) const { return std::hash<int32_t>{}(Key.Id); }
+};
+
+struct FRawPair
+{
+    int32_t First;
+    int32_t Second;
+};
+
+static_assert(TIsBitwiseComparableType<int32_t> && TIsBitwiseComparableType<FRawPair>);
+static_assert(!TIsBitwiseComparableType<FCachedKey>, "Types with operator== must be compared through it");
+static_assert(!TIsBitwiseComparableType<float>, "Floating point values with equal bytes are not always equal");
+
+class FKeyedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FKeyedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FCachedKey, Key)
+    DEFINE_TYPE_MEMBER_REF(FRawPair, Pair)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FKeyedRecord)
+
+class FPairRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FPairRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FRawPair, Pair)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FPairRecord)
+
+class FOrderedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FOrderedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(std::string, Name)
+    DEFINE_TYPE_MEMBER_REF(int32_t, Priority)
+    DEFINE_TYPE_MEMBER_ARRAY(int16_t, Scores, 2)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FOrderedRecord)
+
+class FOrderedChildRecord : public FOrderedRecord
+{
+    DYNAMIC_TYPE_BODY(FOrderedChildRecord, FOrderedRecord, )
+    DEFINE_TYPE_MEMBER_REF(int64_t, Sequence)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FOrderedChildRecord)
+
+class FOrderedEnvelope : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FOrderedEnvelope, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FOrderedRecord, Record)
+    DEFINE_TYPE_MEMBER_REF(int32_t, Channel)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FOrderedEnvelope)
+
+class FOrderedSamples : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FOrderedSamples, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int16_t, Channel)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(int32_t, Samples)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FOrderedSamples)
+
+static Dyn<FOrderedSamples> MakeSamples(const int16_t Channel, const std::vector<int32_t>& Samples)
+{
+    Dyn<FOrderedSamples> SamplesInstance(WithTrailingArray, Samples.size());
+    SamplesInstance->GetChannel() = Channel;
+    for (size_t SampleIndex = 0; SampleIndex < Samples.size(); SampleIndex++)
+    {
+        SamplesInstance->GetSamples()[SampleIndex] = Samples[SampleIndex];
+    }
+    return SamplesInstance;
+}
+
+/** Instances that compare equal must hash equal, even if the bytes of their members differ */
+static void TestEqualInstancesHashEqual()
+{
+    const IDynamicTypeLayout* RecordType = FKeyedRecord::StaticType();
+    DTL_TEST_CHECK(!EnumHasAnyFlags(RecordType->GetTypeFlags(), EMemberTypeFlags::BitwiseComparable));
+
+    Dyn<FKeyedRecord> RecordA;
+    Dyn<FKeyedRecord> RecordB;
+    RecordA->GetKey() = {7, 100};
+    RecordB->GetKey() = {7, 200};
+    RecordA->GetPair() = {1, 2};
+    RecordB->GetPair() = {1, 2};
+
+    DTL_TEST_CHECK(RecordType->EqualsTypeInstance(&*RecordA, &*RecordB));
+    DTL_TEST_CHECK(RecordType->HashTypeInstance(&*RecordA) == RecordType->HashTypeInstance(&*RecordB));
+
+    RecordB->GetPair() = {1, 3};
+    DTL_TEST_CHECK(!RecordType->EqualsTypeInstance(&*RecordA, &*RecordB));
+}
+
+/** Records and vectors of bitwise comparable values are hashed as raw bytes, equal values must still hash equal */
+static void TestBitwiseComparableEqualValuesHashEqual()
+{
+    const IDynamicTypeLayout* RecordType = FPairRecord::StaticType();
+    DTL_TEST_CHECK(EnumHasAnyFlags(RecordType->GetTypeFlags(), EMemberTypeFlags::BitwiseComparable));
+
+    Dyn<FPairRecord> RecordA;
+    Dyn<FPairRecord> RecordB;
+    RecordA->GetPair() = {4, 5};
+    RecordB->GetPair() = {4, 5};
+    DTL_TEST_CHECK(RecordType->EqualsTypeInstance(&*RecordA, &*RecordB));
+    DTL_TEST_CHECK(RecordType->HashTypeInstance(&*RecordA) == RecordType->HashTypeInstance(&*RecordB));
+
+    const std::vector<FRawPair> Pairs{{4, 5}, {6, 7}};
+    const std::vector<FRawPair> SamePairs = Pairs;
+    DTL_TEST_CHECK(TMemberTypeComparator<std::vector<FRawPair>>::Hash(Pairs) == TMemberTypeComparator<std::vector<FRawPair>>::Hash(SamePairs));
+}
+
+/** Instances are ordered by the first member that differs in the order of declaration, and by the elements of the fixed size arrays in their order */
+static void TestInstancesOrderedByDeclaredMembers()
+{
+    const IDynamicTypeLayout* RecordType = FOrderedRecord::StaticType();
+    Dyn<FOrderedRecord> RecordA;
+    Dyn<FOrderedRecord> RecordB;
+    RecordA->GetName() = "Alpha";
+    RecordB->GetName() = "Alpha";
+    DTL_TEST_CHECK(RecordType->CompareTypeInstance(&*RecordA, &*RecordB) == 0);
+
+    // Later members only decide the order when the earlier members are equal
+    RecordA->GetPriority() = 10;
+    RecordB->GetPriority() = 2;
+    DTL_TEST_CHECK(RecordType->CompareTypeInstance(&*RecordA, &*RecordB) > 0);
+    RecordB->GetName() = "Beta";
+    DTL_TEST_CHECK(RecordType->CompareTypeInstance(&*RecordA, &*RecordB) < 0);
+    DTL_TEST_CHECK(RecordType->CompareTypeInstance(&*RecordB, &*RecordA) > 0);
+
+    RecordB->GetName() = "Alpha";
+    RecordB->GetPriority() = 10;
+    RecordA->GetScores(0) = 3;
+    RecordB->GetScores(0) = 3;
+    RecordA->GetScores(1) = 1;
+    RecordB->GetScores(1) = 2;
+    DTL_TEST_CHECK(RecordType->CompareTypeInstance(&*RecordA, &*RecordB) < 0);
+    DTL_TEST_CHECK(RecordType->EqualsTypeInstance(&*RecordA, &*RecordB) == (RecordType->CompareTypeInstance(&*RecordA, &*RecordB) == 0));
+}
+
+/** Members of the parent type are compared before the members of the child type, and nested dynamic types are ordered by their own members */
+static void TestParentAndNestedTypesOrdered()
+{
+    const IDynamicTypeLayout* ChildType = FOrderedChildRecord::StaticType();
+    Dyn<FOrderedChildRecord> ChildA;
+    Dyn<FOrderedChildRecord> ChildB;
+    ChildA->GetPriority() = 1;
+    ChildB->GetPriority() = 2;
+    ChildA->GetSequence() = 100;
+    ChildB->GetSequence() = 50;
+    DTL_TEST_CHECK(ChildType->CompareTypeInstance(&*ChildA, &*ChildB) < 0);
+    ChildB->GetPriority() = 1;
+    DTL_TEST_CHECK(ChildType->CompareTypeInstance(&*ChildA, &*ChildB) > 0);
+
+    const IDynamicTypeLayout* EnvelopeType = FOrderedEnvelope::StaticType();
+    Dyn<FOrderedEnvelope> EnvelopeA;
+    Dyn<FOrderedEnvelope> EnvelopeB;
+    EnvelopeA->GetRecord().GetName() = "Alpha";
+    EnvelopeB->GetRecord().GetName() = "Beta";
+    EnvelopeA->GetChannel() = 9;
+    EnvelopeB->GetChannel() = 1;
+    DTL_TEST_CHECK(EnvelopeType->CompareTypeInstance(&*EnvelopeA, &*EnvelopeB) < 0);
+    EnvelopeB->GetRecord().GetName() = "Alpha";
+    DTL_TEST_CHECK(EnvelopeType->CompareTypeInstance(&*EnvelopeA, &*EnvelopeB) > 0);
+    EnvelopeB->GetChannel() = 9;
+    DTL_TEST_CHECK(EnvelopeType->CompareTypeInstance(&*EnvelopeA, &*EnvelopeB) == 0);
+}
+
+/** Trailing arrays are compared element by element after the fixed members, and the shorter array is ordered first when it is the prefix of the longer one */
+static void TestTrailingArraysOrderedLexicographically()
+{
+    const IDynamicTypeLayout* SamplesType = FOrderedSamples::StaticType();
+    const Dyn<FOrderedSamples> Short = MakeSamples(1, {4, 5});
+    const Dyn<FOrderedSamples> Long = MakeSamples(1, {4, 5, 0});
+    const Dyn<FOrderedSamples> Greater = MakeSamples(1, {4, 6});
+    const Dyn<FOrderedSamples> Empty = MakeSamples(2, {});
+
+    DTL_TEST_CHECK(SamplesType->CompareTypeInstance(&*Short, &*MakeSamples(1, {4, 5})) == 0);
+    DTL_TEST_CHECK(SamplesType->CompareTypeInstance(&*Short, &*Long) < 0);
+    DTL_TEST_CHECK(SamplesType->CompareTypeInstance(&*Long, &*Short) > 0);
+    DTL_TEST_CHECK(SamplesType->CompareTypeInstance(&*Long, &*Greater) < 0);
+    // Fixed members decide the order before the trailing array is looked at
+    DTL_TEST_CHECK(SamplesType->CompareTypeInstance(&*Greater, &*Empty) < 0);
+}
+
+/** Types with a member that has no ordering throw instead of being ordered by the bytes of the member */
+static void TestMemberWithoutOrderingThrows()
+{
+    const IDynamicTypeLayout* RecordType = FPairRecord::StaticType();
+    Dyn<FPairRecord> RecordA;
+    Dyn<FPairRecord> RecordB;
+    DTL_TEST_CHECK_THROWS(static_cast<void>(RecordType->CompareTypeInstance(&*RecordA, &*RecordB)));
+}
+
+int main()
+{
+    TestEqualInstancesHashEqual();
+    TestBitwiseComparableEqualValuesHashEqual();
+    TestInstancesOrderedByDeclaredMembers();
+    TestParentAndNestedTypesOrdered();
+    TestTrailingArraysOrderedLexicographically();
+    TestMemberWithoutOrderingThrows();
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "DynamicTypeContainers.h"
+#include "DynamicTypeTestUtils.h"
+
+class FNamedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FNamedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(std::string, Name)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FNamedRecord)
+
+class FWeightedRecord : public FNamedRecord
+{
+    DYNAMIC_TYPE_BODY(FWeightedRecord, FNamedRecord, )
+    DEFINE_TYPE_MEMBER_ARRAY(float, Weights, 3)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FWeightedRecord)
+
+/** Value counting the live instances, whose move constructor can be told to throw once the provided number of moves has succeeded */
+struct FRelocatedValue
+{
+    static inline int32_t NumLiveValues = 0;
+    static inline int32_t NumMovesBeforeThrow = -1;
+    int32_t Value{0};
+
+    FRelocatedValue() { NumLiveValues++; }
+    FRelocatedValue(const FRelocatedValue& Other) : Value(Other.Value) { NumLiveValues++; }
+    FRelocatedValue(FRelocatedValue&& Other) : Value(Other.Value)
+    {
+        if (NumMovesBeforeThrow == 0)
+        {
+            throw std::runtime_error("Relocated value move failed");
+        }
+        NumMovesBeforeThrow--;
+        NumLiveValues++;
+    }
+    FRelocatedValue& operator=(const FRelocatedValue&) = default;
+    FRelocatedValue& operator=(FRelocatedValue&&) = default;
+    ~FRelocatedValue() { NumLiveValues--; }
+};
+
+class FRelocatedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FRelocatedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FRelocatedValue, First)
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(FRelocatedValue, Second)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FRelocatedRecord)
+
+/** Fills the array up to it's capacity, so that the next Add has to reallocate. Names are longer than the small string buffer, so they live on the heap */
+static void FillToCapacity(DynArray<FNamedRecord>& Array)
+{
+    Array.Reserve(4);
+    while (Array.Num() < Array.Max())
+    {
+        const size_t ElementIndex = Array.AddDefaulted();
+        Array[ElementIndex].GetId() = static_cast<int32_t>(ElementIndex);
+        Array[ElementIndex].GetName() = std::string(40, static_cast<char>('a' + ElementIndex));
+    }
+}
+
+/** Adding the element of the array to itself must copy it before the old allocation is released by the growth */
+static void TestAddCopiesElementOfSameArray()
+{
+    DynArray<FNamedRecord> Array;
+    FillToCapacity(Array);
+    const size_t NumBefore = Array.Num();
+
+    const size_t NewIndex = Array.Add(Array[1]);
+    DTL_TEST_CHECK(NewIndex == NumBefore);
+    DTL_TEST_CHECK(Array.Max() > NumBefore);
+    DTL_TEST_CHECK(Array[NewIndex].GetId() == 1);
+    DTL_TEST_CHECK(Array[NewIndex].GetName() == std::string(40, 'b'));
+    DTL_TEST_CHECK(Array[1].GetName() == std::string(40, 'b'));
+}
+
+/** Moving the element of the array into itself must move from the relocated element, leaving the rest of the array intact */
+static void TestAddMovesElementOfSameArray()
+{
+    DynArray<FNamedRecord> Array;
+    FillToCapacity(Array);
+    const size_t NumBefore = Array.Num();
+
+    const size_t NewIndex = Array.Add(std::move(Array[2]));
+    DTL_TEST_CHECK(NewIndex == NumBefore);
+    DTL_TEST_CHECK(Array[NewIndex].GetId() == 2);
+    DTL_TEST_CHECK(Array[NewIndex].GetName() == std::string(40, 'c'));
+    DTL_TEST_CHECK(Array[3].GetName() == std::string(40, 'd'));
+}
+
+/** Failed relocation keeps the old allocation of the array along with it's elements, and releases everything the growth has constructed */
+static void TestArrayGrowthRollsBack()
+{
+    {
+        DynArray<FRelocatedRecord> Array;
+        Array.Reserve(4);
+        for (int32_t ElementIndex = 0; ElementIndex < 4; ElementIndex++)
+        {
+            Array[Array.AddDefaulted()].GetFirst().Value = ElementIndex;
+        }
+        DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 8);
+
+        for (int32_t NumMoves = 0; NumMoves < 8; NumMoves++)
+        {
+            FRelocatedValue::NumMovesBeforeThrow = NumMoves;
+            DTL_TEST_CHECK_THROWS(Array.AddDefaulted());
+            FRelocatedValue::NumMovesBeforeThrow = -1;
+            DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 8);
+            DTL_TEST_CHECK(Array.Num() == 4 && Array.Max() == 4);
+        }
+        DTL_TEST_CHECK(Array[3].GetFirst().Value == 3);
+        Array.AddDefaulted();
+        DTL_TEST_CHECK(Array[3].GetFirst().Value == 3);
+    }
+    DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 0);
+}
+
+/** Columns follow the type hierarchy from the root type, and array members store all values of the element next to each other */
+static void TestSoAColumns()
+{
+    const std::vector<FDynamicTypeMember*>& NamedMembers = FNamedRecord::StaticType()->GetTypeMembers();
+    const std::vector<FDynamicTypeMember*>& WeightedMembers = FWeightedRecord::StaticType()->GetTypeMembers();
+
+    DynSoA<FWeightedRecord> Array;
+    DTL_TEST_CHECK(Array.NumColumns() == 3);
+    const int32_t IdColumn = Array.FindColumn(NamedMembers[0]);
+    const int32_t NameColumn = Array.FindColumn(NamedMembers[1]);
+    const int32_t WeightsColumn = Array.FindColumn(WeightedMembers[0]);
+    DTL_TEST_CHECK(IdColumn == 0 && NameColumn == 1 && WeightsColumn == 2);
+    DTL_TEST_CHECK(Array.GetColumnMember(WeightsColumn) == WeightedMembers[0]);
+
+    Dyn<FWeightedRecord> Element;
+    for (int32_t ElementIndex = 0; ElementIndex < 3; ElementIndex++)
+    {
+        Element->GetId() = ElementIndex;
+        Element->GetName() = std::string(40, static_cast<char>('a' + ElementIndex));
+        for (int32_t WeightIndex = 0; WeightIndex < 3; WeightIndex++)
+        {
+            Element->GetWeights(WeightIndex) = static_cast<float>(ElementIndex * 10 + WeightIndex);
+        }
+        DTL_TEST_CHECK(Array.Add(*Element) == static_cast<size_t>(ElementIndex));
+    }
+
+    const int32_t* Ids = Array.GetColumnData<int32_t>(IdColumn);
+    const float* Weights = Array.GetColumnData<float>(WeightsColumn);
+    DTL_TEST_CHECK(Ids[0] == 0 && Ids[1] == 1 && Ids[2] == 2);
+    DTL_TEST_CHECK(Weights[1 * 3 + 2] == 12.0f);
+    DTL_TEST_CHECK(Array.GetColumnData<std::string>(NameColumn)[2] == std::string(40, 'c'));
+
+    // Last element takes the place of the removed one
+    Array.RemoveAtSwap(0);
+    DTL_TEST_CHECK(Array.Num() == 2);
+    Array.CopyElementTo(0, *Element);
+    DTL_TEST_CHECK(Element->GetId() == 2);
+    DTL_TEST_CHECK(Element->GetName() == std::string(40, 'c'));
+    DTL_TEST_CHECK(Element->GetWeights(1) == 21.0f);
+}
+
+/** Growing the array relocates the values of every column, and copies and moves carry the elements over */
+static void TestSoAResize()
+{
+    DynSoA<FWeightedRecord> Array;
+    Array.Reserve(2);
+    DTL_TEST_CHECK(Array.Max() == 2);
+    DTL_TEST_CHECK(Array.AddDefaulted(2) == 0);
+    for (size_t ElementIndex = 0; ElementIndex < 2; ElementIndex++)
+    {
+        Array.GetColumnData<int32_t>(0)[ElementIndex] = static_cast<int32_t>(ElementIndex);
+        Array.GetColumnData<std::string>(1)[ElementIndex] = std::string(40, static_cast<char>('a' + ElementIndex));
+    }
+
+    DTL_TEST_CHECK(Array.AddDefaulted(30) == 2);
+    DTL_TEST_CHECK(Array.Num() == 32 && Array.Max() >= 32);
+    DTL_TEST_CHECK(Array.GetColumnData<int32_t>(0)[1] == 1);
+    DTL_TEST_CHECK(Array.GetColumnData<std::string>(1)[1] == std::string(40, 'b'));
+    DTL_TEST_CHECK(Array.GetColumnData<std::string>(1)[31].empty());
+    DTL_TEST_CHECK(Array.GetColumnData<float>(2)[31 * 3 + 2] == 0.0f);
+
+    const DynSoA<FWeightedRecord> Copy(Array);
+    DTL_TEST_CHECK(Copy.Num() == 32);
+    DTL_TEST_CHECK(Copy.GetColumnData<std::string>(1)[0] == std::string(40, 'a'));
+
+    DynSoA<FWeightedRecord> Moved(std::move(Array));
+    DTL_TEST_CHECK(Moved.Num() == 32 && Moved.NumColumns() == 3);
+    DTL_TEST_CHECK(Moved.GetColumnData<std::string>(1)[1] == std::string(40, 'b'));
+    DTL_TEST_CHECK(Array.Num() == 0 && Array.NumColumns() == 0);
+
+    Array = std::move(Moved);
+    DTL_TEST_CHECK(Array.Num() == 32 && Array.NumColumns() == 3);
+    DTL_TEST_CHECK(Array.GetColumnData<int32_t>(0)[1] == 1);
+}
+
+/** Failed relocation of any of the columns keeps the old columns along with their values, and releases everything the growth has constructed */
+static void TestSoAGrowthRollsBack()
+{
+    {
+        DynSoA<FRelocatedRecord> Array;
+        Array.Reserve(4);
+        Array.AddDefaulted(4);
+        DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 8);
+        Array.GetColumnData<FRelocatedValue>(2)[3].Value = 3;
+
+        for (int32_t NumMoves = 0; NumMoves < 8; NumMoves++)
+        {
+            FRelocatedValue::NumMovesBeforeThrow = NumMoves;
+            DTL_TEST_CHECK_THROWS(Array.AddDefaulted());
+            FRelocatedValue::NumMovesBeforeThrow = -1;
+            DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 8);
+            DTL_TEST_CHECK(Array.Num() == 4 && Array.Max() == 4);
+        }
+        DTL_TEST_CHECK(Array.GetColumnData<FRelocatedValue>(2)[3].Value == 3);
+        Array.AddDefaulted();
+        DTL_TEST_CHECK(Array.GetColumnData<FRelocatedValue>(2)[3].Value == 3);
+        DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 10);
+    }
+    DTL_TEST_CHECK(FRelocatedValue::NumLiveValues == 0);
+}
+
+static_assert(std::is_nothrow_move_constructible_v<DynSoA<FNamedRecord>>);
+static_assert(std::is_nothrow_move_assignable_v<DynSoA<FNamedRecord>>);
+
+int main()
+{
+    TestAddCopiesElementOfSameArray();
+    TestAddMovesElementOfSameArray();
+    TestArrayGrowthRollsBack();
+    TestSoAColumns();
+    TestSoAResize();
+    TestSoAGrowthRollsBack();
+    return 0;
+}
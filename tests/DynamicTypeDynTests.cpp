@@ -0,0 +1,275 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "DynamicTypeTestUtils.h"
+
+/** Value whose copy or move constructor throws while the flag is set, for checking the state the containers are left in by a failed construction */
+struct FThrowingValue
+{
+    static inline bool bThrowOnCopy = false;
+    static inline bool bThrowOnMove = false;
+    int32_t Value{0};
+
+    FThrowingValue() = default;
+    FThrowingValue(const FThrowingValue& Other) : Value(Other.Value)
+    {
+        if (bThrowOnCopy)
+        {
+            throw std::runtime_error("Value copy failed");
+        }
+    }
+    FThrowingValue(FThrowingValue&& Other) : Value(Other.Value)
+    {
+        if (bThrowOnMove)
+        {
+            throw std::runtime_error("Value move failed");
+        }
+    }
+    FThrowingValue& operator=(const FThrowingValue&) = default;
+    FThrowingValue& operator=(FThrowingValue&&) = default;
+};
+
+/** Payload larger than the default inline storage of InlineDyn */
+struct FLargePayload
+{
+    uint64_t Words[16]{};
+};
+
+/** Value aligned stricter than the inline storage of InlineDyn */
+struct alignas(64) FOverAlignedPayload
+{
+    uint64_t Words[2]{};
+};
+
+class FSmallRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FSmallRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(std::string, Name)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FSmallRecord)
+
+class FLargeRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FLargeRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(FLargePayload, Payload)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FLargeRecord)
+
+class FOverAlignedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FOverAlignedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FOverAlignedPayload, Payload)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FOverAlignedRecord)
+
+class FSamplesRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FSamplesRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(int32_t, Samples)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FSamplesRecord)
+
+class FThrowingMoveRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FThrowingMoveRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FThrowingValue, Value)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FThrowingMoveRecord)
+
+class FThrowingSamplesRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FThrowingSamplesRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FThrowingValue, Value)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(int32_t, Samples)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FThrowingSamplesRecord)
+
+/** Heap allocator policy counting the live allocations, so the tests can check that failed constructions release their memory */
+struct FCountingAllocator
+{
+    static inline int32_t NumLiveAllocations = 0;
+
+    static void* Allocate(const IDynamicTypeLayout* Type, const size_t Size)
+    {
+        void* Memory = FDynHeapAllocator::Allocate(Type, Size);
+        NumLiveAllocations++;
+        return Memory;
+    }
+    static void Free(const IDynamicTypeLayout* Type, void* Memory, const size_t Size)
+    {
+        NumLiveAllocations--;
+        FDynHeapAllocator::Free(Type, Memory, Size);
+    }
+};
+
+// Moving the inline instance runs the move constructor of the dynamic type, which can throw
+static_assert(!std::is_nothrow_move_constructible_v<InlineDyn<FSmallRecord>>);
+static_assert(!std::is_nothrow_move_assignable_v<InlineDyn<FSmallRecord>>);
+
+/** Instances are placed inline only when both their size and their alignment fit the inline storage */
+static void TestInlineStorageDecision()
+{
+    DTL_TEST_CHECK(InlineDyn<FSmallRecord>().IsInline());
+    DTL_TEST_CHECK(!(InlineDyn<FSmallRecord, 8>().IsInline()));
+    DTL_TEST_CHECK(!InlineDyn<FLargeRecord>().IsInline());
+    DTL_TEST_CHECK((InlineDyn<FLargeRecord, 256>().IsInline()));
+    DTL_TEST_CHECK(!(InlineDyn<FOverAlignedRecord, 256>().IsInline()));
+
+    // Trailing array elements count towards the size of the instance
+    InlineDyn<FSamplesRecord> FewSamples(WithTrailingArray, 4);
+    DTL_TEST_CHECK(FewSamples.IsInline());
+    DTL_TEST_CHECK(FewSamples->GetSamplesNum() == 4);
+    InlineDyn<FSamplesRecord> ManySamples(WithTrailingArray, 64);
+    DTL_TEST_CHECK(!ManySamples.IsInline());
+    DTL_TEST_CHECK(ManySamples->GetSamplesNum() == 64);
+
+    // Copies make the same decision as the original
+    const InlineDyn<FSamplesRecord> ManySamplesCopy(ManySamples);
+    DTL_TEST_CHECK(!ManySamplesCopy.IsInline());
+    DTL_TEST_CHECK(ManySamplesCopy->GetSamplesNum() == 64);
+}
+
+/** Moving the inline instance moves the instance into the inline storage of the new container, and leaves the old one in a null-state */
+static void TestInlineMove()
+{
+    InlineDyn<FSmallRecord> Source;
+    Source->GetId() = 7;
+    Source->GetName() = std::string(40, 'n');
+
+    InlineDyn<FSmallRecord> Moved(std::move(Source));
+    DTL_TEST_CHECK(Moved.IsInline());
+    DTL_TEST_CHECK(Moved->GetId() == 7);
+    DTL_TEST_CHECK(Moved->GetName() == std::string(40, 'n'));
+    DTL_TEST_CHECK(Source.operator->() == nullptr);
+
+    InlineDyn<FSmallRecord> Assigned;
+    Assigned = std::move(Moved);
+    DTL_TEST_CHECK(Assigned.IsInline());
+    DTL_TEST_CHECK(Assigned->GetName() == std::string(40, 'n'));
+    DTL_TEST_CHECK(Moved.operator->() == nullptr);
+}
+
+/** Moving the heap instance steals it without moving the instance */
+static void TestHeapMove()
+{
+    InlineDyn<FLargeRecord> Source;
+    Source->GetId() = 9;
+    const FLargeRecord* Instance = Source.operator->();
+
+    InlineDyn<FLargeRecord> Moved(std::move(Source));
+    DTL_TEST_CHECK(!Moved.IsInline());
+    DTL_TEST_CHECK(Moved.operator->() == Instance);
+    DTL_TEST_CHECK(Source.operator->() == nullptr);
+
+    InlineDyn<FLargeRecord> Assigned;
+    Assigned = std::move(Moved);
+    DTL_TEST_CHECK(Assigned.operator->() == Instance);
+    DTL_TEST_CHECK(Assigned->GetId() == 9);
+}
+
+/** Failed move of the inline instance leaves the new container in a null-state and the source instance intact */
+static void TestThrowingInlineMove()
+{
+    InlineDyn<FThrowingMoveRecord> Source;
+    Source->GetValue().Value = 5;
+    DTL_TEST_CHECK(Source.IsInline());
+
+    FThrowingValue::bThrowOnMove = true;
+    InlineDyn<FThrowingMoveRecord> Target;
+    DTL_TEST_CHECK_THROWS(Target = std::move(Source));
+    FThrowingValue::bThrowOnMove = false;
+
+    DTL_TEST_CHECK(Target.operator->() == nullptr);
+    DTL_TEST_CHECK(Source.IsInline());
+    DTL_TEST_CHECK(Source->GetValue().Value == 5);
+}
+
+/** Failed constructors of Dyn release the memory they have allocated */
+static void TestThrowingDynConstructionReleasesMemory()
+{
+    {
+        Dyn<FThrowingSamplesRecord, FCountingAllocator> Source(WithTrailingArray, 4);
+        DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 1);
+
+        FThrowingValue::bThrowOnCopy = true;
+        DTL_TEST_CHECK_THROWS((Dyn<FThrowingSamplesRecord, FCountingAllocator>(Source)));
+        DTL_TEST_CHECK_THROWS((Dyn<FThrowingSamplesRecord, FCountingAllocator>(*Source)));
+        FThrowingValue::bThrowOnCopy = false;
+        FThrowingValue::bThrowOnMove = true;
+        DTL_TEST_CHECK_THROWS((Dyn<FThrowingSamplesRecord, FCountingAllocator>(std::move(*Source))));
+        FThrowingValue::bThrowOnMove = false;
+        DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 1);
+    }
+    DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 0);
+}
+
+/** Assigning the instance of a different size constructs it before releasing the held one, so a failed assignment keeps the held instance */
+static void TestThrowingDynAssignmentKeepsInstance()
+{
+    {
+        Dyn<FThrowingSamplesRecord, FCountingAllocator> Target(WithTrailingArray, 2);
+        Target->GetValue().Value = 3;
+        Dyn<FThrowingSamplesRecord, FCountingAllocator> Source(WithTrailingArray, 8);
+        Source->GetValue().Value = 5;
+
+        FThrowingValue::bThrowOnCopy = true;
+        DTL_TEST_CHECK_THROWS(Target = *Source);
+        FThrowingValue::bThrowOnCopy = false;
+        FThrowingValue::bThrowOnMove = true;
+        DTL_TEST_CHECK_THROWS(Target = std::move(*Source));
+        FThrowingValue::bThrowOnMove = false;
+
+        DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 2);
+        DTL_TEST_CHECK(Target->GetValue().Value == 3);
+        DTL_TEST_CHECK(Target->GetSamplesNum() == 2);
+
+        Target = *Source;
+        DTL_TEST_CHECK(Target->GetValue().Value == 5);
+        DTL_TEST_CHECK(Target->GetSamplesNum() == 8);
+    }
+    DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 0);
+}
+
+/** Failed assignment of the instance of a different size leaves InlineDyn in a null-state, and releases the memory it has allocated for the new instance */
+static void TestThrowingInlineDynAssignment()
+{
+    {
+        InlineDyn<FThrowingSamplesRecord, 64, FCountingAllocator> Target(WithTrailingArray, 2);
+        DTL_TEST_CHECK(Target.IsInline());
+        const Dyn<FThrowingSamplesRecord> Source(WithTrailingArray, 64);
+
+        FThrowingValue::bThrowOnCopy = true;
+        DTL_TEST_CHECK_THROWS(Target = *Source);
+        DTL_TEST_CHECK_THROWS((InlineDyn<FThrowingSamplesRecord, 64, FCountingAllocator>(*Source)));
+        FThrowingValue::bThrowOnCopy = false;
+        DTL_TEST_CHECK(Target.operator->() == nullptr);
+        DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 0);
+
+        Target = *Source;
+        DTL_TEST_CHECK(!Target.IsInline());
+        DTL_TEST_CHECK(Target->GetSamplesNum() == 64);
+        DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 1);
+    }
+    DTL_TEST_CHECK(FCountingAllocator::NumLiveAllocations == 0);
+}
+
+int main()
+{
+    TestInlineStorageDecision();
+    TestInlineMove();
+    TestHeapMove();
+    TestThrowingInlineMove();
+    TestThrowingDynConstructionReleasesMemory();
+    TestThrowingDynAssignmentKeepsInstance();
+    TestThrowingInlineDynAssignment();
+    return 0;
+}
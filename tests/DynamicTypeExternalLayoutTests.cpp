@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "DynamicTypeTestUtils.h"
+
+/** Layout of the record as compiled into the foreign binary. Members are declared in a different order than in the dynamic type, and Level is not described by it at all */
+struct FForeignRecord
+{
+    double Weight{0.0};
+    int16_t Level{0};
+    int32_t Id{0};
+};
+
+class FExternalRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FExternalRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(double, Weight)
+    DEFINE_OPTIONAL_TYPE_MEMBER(int64_t, Extra)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_EXTERNAL(FExternalRecord)
+
+static FExternalTypeLayoutDesc MakeForeignRecordDesc()
+{
+    FExternalTypeLayoutDesc TypeLayoutDesc;
+    TypeLayoutDesc.TypeName = DTL_TEXT("FExternalRecord");
+    TypeLayoutDesc.Size = sizeof(FForeignRecord);
+    TypeLayoutDesc.Alignment = alignof(FForeignRecord);
+    TypeLayoutDesc.MemberOffsets = {
+        {DTL_TEXT("Weight"), offsetof(FForeignRecord, Weight)},
+        {DTL_TEXT("Level"), offsetof(FForeignRecord, Level)},
+        {DTL_TEXT("Id"), offsetof(FForeignRecord, Id)},
+    };
+    return TypeLayoutDesc;
+}
+
+/** Describes the type with a single int32 member at the provided offset, for the types constructed directly by the tests */
+static FExternalTypeLayoutDesc MakeSingleMemberDesc(const dtl_string& TypeName, const size_t Alignment, const int64_t MemberOffset)
+{
+    FExternalTypeLayoutDesc TypeLayoutDesc;
+    TypeLayoutDesc.TypeName = TypeName;
+    TypeLayoutDesc.Size = 16;
+    TypeLayoutDesc.Alignment = Alignment;
+    TypeLayoutDesc.MemberOffsets = {{DTL_TEXT("Value"), MemberOffset}};
+    return TypeLayoutDesc;
+}
+
+/** External types are constructed directly instead of being declared with the macros, so the tests can check the types that fail to initialize */
+static FExternalLayoutDynamicType* MakeSingleMemberType(const dtl_string& TypeName)
+{
+    return new FExternalLayoutDynamicType(FDynamicTypeName(TypeName), nullptr, {new FDynamicTypeMember(DTL_TEXT("Value"), StaticMemberType<int32_t>(DTL_TEXT("int32")))}, {});
+}
+
+static std::vector<uint8_t> ReadFileBytes(const std::filesystem::path& FilePath)
+{
+    std::ifstream File(FilePath, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+}
+
+static void WriteFileBytes(const std::filesystem::path& FilePath, const std::vector<uint8_t>& Bytes)
+{
+    std::ofstream File(FilePath, std::ios::binary | std::ios::trunc);
+    File.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+}
+
+/** Replaces the last character of the name stored in the name data of the manifest, keeping it's name hash in the index and in the layouts */
+static void CorruptStoredName(std::vector<uint8_t>& ManifestBytes, const dtl_string_view Name)
+{
+    const uint8_t* NameBytes = reinterpret_cast<const uint8_t*>(Name.data());
+    const auto NameLocation = std::search(ManifestBytes.begin(), ManifestBytes.end(), NameBytes, NameBytes + Name.size() * sizeof(DTL_CHAR));
+    DTL_TEST_CHECK(NameLocation != ManifestBytes.end());
+    *(NameLocation + static_cast<std::ptrdiff_t>((Name.size() - 1) * sizeof(DTL_CHAR))) ^= 1;
+}
+
+/** Manifest written by SaveToFile is read back with the same layouts, and the types are found by their full names */
+static void TestManifestRoundTrip(const std::filesystem::path& ManifestFilePath)
+{
+    const FExternalLayoutManifest& LayoutManifest = FExternalLayoutManifest::Get();
+    DTL_TEST_CHECK(LayoutManifest.GetNumTypes() == 3);
+
+    const FExternalTypeLayout* RecordLayout = LayoutManifest.FindTypeLayout(DTL_TEXT("FExternalRecord"));
+    DTL_TEST_CHECK(RecordLayout != nullptr);
+    DTL_TEST_CHECK(RecordLayout->GetTypeName() == DTL_TEXT("FExternalRecord"));
+    DTL_TEST_CHECK(RecordLayout->Size == sizeof(FForeignRecord));
+    DTL_TEST_CHECK(RecordLayout->Alignment == alignof(FForeignRecord));
+    DTL_TEST_CHECK(RecordLayout->NumMembers == 3);
+    DTL_TEST_CHECK(RecordLayout->NumVirtualFunctions == 0);
+
+    const FExternalMemberLayout* LevelLayout = RecordLayout->FindMember(DTL_TEXT("Level"));
+    DTL_TEST_CHECK(LevelLayout != nullptr && LevelLayout->Offset == static_cast<int64_t>(offsetof(FForeignRecord, Level)));
+    DTL_TEST_CHECK(RecordLayout->GetMemberName(*LevelLayout) == DTL_TEXT("Level"));
+    DTL_TEST_CHECK(RecordLayout->FindMember(DTL_TEXT("Extra")) == nullptr);
+    DTL_TEST_CHECK(RecordLayout->FindVirtualFunction(DTL_TEXT("Id")) == nullptr);
+    DTL_TEST_CHECK(LayoutManifest.FindTypeLayout(DTL_TEXT("FMissingRecord")) == nullptr);
+
+    // Same type cannot be described twice, and neither can it's members
+    const std::filesystem::path InvalidManifestFilePath = std::filesystem::path(ManifestFilePath).replace_extension(".invalid.dtlm");
+    DTL_TEST_CHECK_THROWS(FExternalLayoutManifest::SaveToFile(InvalidManifestFilePath, {MakeForeignRecordDesc(), MakeForeignRecordDesc()}));
+    FExternalTypeLayoutDesc DuplicateMemberDesc = MakeForeignRecordDesc();
+    DuplicateMemberDesc.MemberOffsets.push_back({DTL_TEXT("Id"), 0});
+    DTL_TEST_CHECK_THROWS(FExternalLayoutManifest::SaveToFile(InvalidManifestFilePath, {DuplicateMemberDesc}));
+    DTL_TEST_CHECK(!std::filesystem::exists(InvalidManifestFilePath));
+}
+
+/** Accessors of the external type read and write the memory of the foreign object in place, at the offsets taken from the manifest */
+static void TestOverlayForeignInstance()
+{
+    FForeignRecord ForeignRecord;
+    ForeignRecord.Weight = 2.5;
+    ForeignRecord.Level = 3;
+    ForeignRecord.Id = 7;
+
+    FExternalRecord* Record = OverlayExternalInstance<FExternalRecord>(&ForeignRecord);
+    DTL_TEST_CHECK(FExternalRecord::StaticType()->GetSize() == sizeof(FForeignRecord));
+    DTL_TEST_CHECK(Record->GetId() == 7);
+    DTL_TEST_CHECK(Record->GetWeight() == 2.5);
+    // Optional member missing in the manifest has no storage in the foreign object
+    DTL_TEST_CHECK(Record->GetExtraPtr() == nullptr);
+
+    Record->GetId() = 42;
+    Record->GetWeight() = 4.0;
+    DTL_TEST_CHECK(ForeignRecord.Id == 42);
+    DTL_TEST_CHECK(ForeignRecord.Weight == 4.0);
+    DTL_TEST_CHECK(ForeignRecord.Level == 3);
+
+    const FExternalRecord* ConstRecord = OverlayExternalInstance<FExternalRecord>(static_cast<const void*>(&ForeignRecord));
+    DTL_TEST_CHECK(ConstRecord->GetId() == 42);
+    DTL_TEST_CHECK_THROWS(FExternalRecord::StaticType()->EmplaceTypeInstance(&ForeignRecord));
+}
+
+/** Members placed at an offset that is not a multiple of their alignment, or aligned stricter than the type itself, fail the initialization of the type */
+static void TestMisalignedMemberIsRejected()
+{
+    DTL_TEST_CHECK_THROWS(MakeSingleMemberType(DTL_TEXT("FMisalignedRecord"))->EnsureInitialized());
+    DTL_TEST_CHECK_THROWS(MakeSingleMemberType(DTL_TEXT("FUnderalignedRecord"))->EnsureInitialized());
+}
+
+/** Names are looked up by their hash, but the layout is only used if the full name stored in the manifest matches too */
+static void TestNameMismatchIsRejected(const std::filesystem::path& ManifestFilePath)
+{
+    FExternalLayoutManifest& LayoutManifest = FExternalLayoutManifest::Get();
+    const std::vector<uint8_t> ManifestBytes = ReadFileBytes(ManifestFilePath);
+    const std::filesystem::path CorruptedManifestFilePath = std::filesystem::path(ManifestFilePath).replace_extension(".corrupted.dtlm");
+
+    std::vector<uint8_t> CorruptedManifestBytes = ManifestBytes;
+    CorruptStoredName(CorruptedManifestBytes, DTL_TEXT("FExternalRecord"));
+    WriteFileBytes(CorruptedManifestFilePath, CorruptedManifestBytes);
+    DTL_TEST_CHECK(LayoutManifest.LoadFromFile(CorruptedManifestFilePath));
+    DTL_TEST_CHECK(LayoutManifest.FindTypeLayout(DTL_TEXT("FExternalRecord")) == nullptr);
+    DTL_TEST_CHECK(LayoutManifest.FindTypeLayout(DTL_TEXT("FMisalignedRecord")) != nullptr);
+
+    CorruptedManifestBytes = ManifestBytes;
+    CorruptStoredName(CorruptedManifestBytes, DTL_TEXT("Level"));
+    WriteFileBytes(CorruptedManifestFilePath, CorruptedManifestBytes);
+    DTL_TEST_CHECK(LayoutManifest.LoadFromFile(CorruptedManifestFilePath));
+    const FExternalTypeLayout* RecordLayout = LayoutManifest.FindTypeLayout(DTL_TEXT("FExternalRecord"));
+    DTL_TEST_CHECK(RecordLayout != nullptr);
+    DTL_TEST_CHECK(RecordLayout->FindMember(DTL_TEXT("Level")) == nullptr);
+    DTL_TEST_CHECK(RecordLayout->FindMember(DTL_TEXT("Weight")) != nullptr);
+
+    // Truncated name data fails the validation of the manifest, which leaves it empty
+    WriteFileBytes(CorruptedManifestFilePath, std::vector<uint8_t>(ManifestBytes.begin(), ManifestBytes.end() - 8));
+    DTL_TEST_CHECK(!LayoutManifest.LoadFromFile(CorruptedManifestFilePath));
+    DTL_TEST_CHECK(LayoutManifest.GetNumTypes() == 0);
+    std::filesystem::remove(CorruptedManifestFilePath);
+}
+
+int main()
+{
+    // Manifest must be loaded before the external types are initialized
+    const std::filesystem::path ManifestFilePath = std::filesystem::temp_directory_path() / "DynamicTypeExternalLayoutTests.dtlm";
+    FExternalLayoutManifest::SaveToFile(ManifestFilePath, {
+        MakeForeignRecordDesc(),
+        MakeSingleMemberDesc(DTL_TEXT("FMisalignedRecord"), 8, 2),
+        MakeSingleMemberDesc(DTL_TEXT("FUnderalignedRecord"), 2, 4),
+    });
+    DTL_TEST_CHECK(FExternalLayoutManifest::Get().LoadFromFile(ManifestFilePath));
+
+    TestManifestRoundTrip(ManifestFilePath);
+    TestOverlayForeignInstance();
+    TestMisalignedMemberIsRejected();
+    TestNameMismatchIsRejected(ManifestFilePath);
+    std::filesystem::remove(ManifestFilePath);
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DynamicTypeLayoutCache.h"
+#include "DynamicTypeTestUtils.h"
+
+/** Each version of the record gets it's own members, since the members hold the offsets assigned by the type they are laid out in */
+static std::vector<FDynamicTypeMember*> MakeRecordMembers()
+{
+    return {
+        new FHintedDynamicTypeMember(DTL_TEXT("Flags"), StaticMemberType<int8_t>(DTL_TEXT("int8")), false, EMemberLayoutHint::Cold),
+        new FHintedDynamicTypeMember(DTL_TEXT("Counter"), StaticMemberType<int64_t>(DTL_TEXT("int64")), false, EMemberLayoutHint::Hot),
+        new FHintedDynamicTypeMember(DTL_TEXT("Kind"), StaticMemberType<int16_t>(DTL_TEXT("int16"))),
+        new FHintedDynamicTypeMember(DTL_TEXT("Label"), StaticMemberType<std::string>(DTL_TEXT("string"))),
+    };
+}
+
+/** Layouts are constructed directly instead of being registered, so the same record can be initialized once per loaded cache file */
+static PackedTypeLayout* MakeRecordLayout(const std::vector<FDynamicTypeMember*>& Members)
+{
+    PackedTypeLayout* RecordType = new PackedTypeLayout(DTL_TEXT("CachedRecord"), nullptr, Members, {});
+    RecordType->EnsureInitialized();
+    return RecordType;
+}
+
+/** Checks that both records have been laid out the same way */
+static void CheckSameRecordLayout(const PackedTypeLayout* RecordType, const PackedTypeLayout* ExpectedRecordType)
+{
+    DTL_TEST_CHECK(RecordType->GetStructuralHash() == ExpectedRecordType->GetStructuralHash());
+    DTL_TEST_CHECK(RecordType->GetSize() == ExpectedRecordType->GetSize());
+    DTL_TEST_CHECK(RecordType->GetMinAlignment() == ExpectedRecordType->GetMinAlignment());
+    DTL_TEST_CHECK(RecordType->GetDeclarationOrderSize() == ExpectedRecordType->GetDeclarationOrderSize());
+    for (size_t MemberIndex = 0; MemberIndex < ExpectedRecordType->GetTypeMembers().size(); MemberIndex++)
+    {
+        DTL_TEST_CHECK(RecordType->GetTypeMembers()[MemberIndex]->GetMemberOffset() == ExpectedRecordType->GetTypeMembers()[MemberIndex]->GetMemberOffset());
+    }
+}
+
+static std::vector<uint8_t> ReadFileBytes(const std::filesystem::path& FilePath)
+{
+    std::ifstream File(FilePath, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+}
+
+static void WriteFileBytes(const std::filesystem::path& FilePath, const std::vector<uint8_t>& Bytes)
+{
+    std::ofstream File(FilePath, std::ios::binary | std::ios::trunc);
+    File.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+}
+
+/** Types initialized before any cache has been loaded do not look up their layout, so they neither hit nor miss */
+static void TestNoLookupWithoutLoadedCache()
+{
+    const FDynamicTypeLayoutCache& LayoutCache = FDynamicTypeLayoutCache::Get();
+    DTL_TEST_CHECK(!LayoutCache.IsLoaded());
+    DTL_TEST_CHECK(LayoutCache.GetNumTypes() == 0);
+    DTL_TEST_CHECK(LayoutCache.FindTypeLayout(0) == nullptr);
+
+    MakeRecordLayout(MakeRecordMembers());
+    DTL_TEST_CHECK(LayoutCache.GetNumCacheHits() == 0);
+    DTL_TEST_CHECK(LayoutCache.GetNumCacheMisses() == 0);
+}
+
+/** Layout saved by one run is taken from the cache by the next one, and is the same as the computed one */
+static void TestCachedLayoutIsApplied(const std::filesystem::path& CacheFilePath, const PackedTypeLayout* ComputedRecordType)
+{
+    FDynamicTypeLayoutCache& LayoutCache = FDynamicTypeLayoutCache::Get();
+    DTL_TEST_CHECK(LayoutCache.LoadFromFile(CacheFilePath));
+    DTL_TEST_CHECK(LayoutCache.GetNumTypes() == 1);
+    DTL_TEST_CHECK(LayoutCache.FindTypeLayout(ComputedRecordType->GetStructuralHash()) != nullptr);
+
+    const uint32_t NumCacheHits = LayoutCache.GetNumCacheHits();
+    const PackedTypeLayout* CachedRecordType = MakeRecordLayout(MakeRecordMembers());
+    DTL_TEST_CHECK(LayoutCache.GetNumCacheHits() == NumCacheHits + 1);
+    CheckSameRecordLayout(CachedRecordType, ComputedRecordType);
+}
+
+/** Declaration order layouts compute their layout even when the cache is loaded, without looking it up */
+static void TestAutoLayoutDoesNotUseCache(const std::filesystem::path& CacheFilePath)
+{
+    FDynamicTypeLayoutCache& LayoutCache = FDynamicTypeLayoutCache::Get();
+    DTL_TEST_CHECK(LayoutCache.LoadFromFile(CacheFilePath));
+
+    const uint32_t NumCacheHits = LayoutCache.GetNumCacheHits();
+    const uint32_t NumCacheMisses = LayoutCache.GetNumCacheMisses();
+    AutoTypeLayout* RecordType = new AutoTypeLayout(DTL_TEXT("CachedRecord"), nullptr, MakeRecordMembers(), {});
+    RecordType->EnsureInitialized();
+    DTL_TEST_CHECK(LayoutCache.GetNumCacheHits() == NumCacheHits);
+    DTL_TEST_CHECK(LayoutCache.GetNumCacheMisses() == NumCacheMisses);
+}
+
+/** Types initialized while the cache is being reloaded see either the old or the new file, and end up with the same layout either way */
+static void TestConcurrentLoadAndInitialization(const std::filesystem::path& CacheFilePath, const PackedTypeLayout* ComputedRecordType)
+{
+    constexpr size_t NumInitializingThreads = 4;
+    constexpr size_t NumTypesPerThread = 64;
+    constexpr size_t NumLoads = 64;
+
+    FDynamicTypeLayoutCache& LayoutCache = FDynamicTypeLayoutCache::Get();
+    std::vector<std::vector<const PackedTypeLayout*>> RecordTypes(NumInitializingThreads);
+    {
+        std::vector<std::jthread> InitializingThreads;
+        for (size_t ThreadIndex = 0; ThreadIndex < NumInitializingThreads; ThreadIndex++)
+        {
+            InitializingThreads.emplace_back([&RecordTypes, ThreadIndex]
+            {
+                for (size_t TypeIndex = 0; TypeIndex < NumTypesPerThread; TypeIndex++)
+                {
+                    RecordTypes[ThreadIndex].push_back(MakeRecordLayout(MakeRecordMembers()));
+                }
+            });
+        }
+        for (size_t LoadIndex = 0; LoadIndex < NumLoads; LoadIndex++)
+        {
+            DTL_TEST_CHECK(LayoutCache.LoadFromFile(CacheFilePath));
+        }
+    }
+    for (const std::vector<const PackedTypeLayout*>& ThreadRecordTypes : RecordTypes)
+    {
+        for (const PackedTypeLayout* RecordType : ThreadRecordTypes)
+        {
+            CheckSameRecordLayout(RecordType, ComputedRecordType);
+        }
+    }
+}
+
+/** Entries that would place the members at invalid offsets are rejected, and the type computes it's layout instead */
+static void TestCorruptedLayoutIsRejected(const std::filesystem::path& CacheFilePath, const PackedTypeLayout* ComputedRecordType)
+{
+    const std::vector<uint8_t> CacheFileBytes = ReadFileBytes(CacheFilePath);
+    const uint64_t StructuralHash = ComputedRecordType->GetStructuralHash();
+
+    // Structural hash is stored in the index and then at the start of the layout, which is followed by the members sorted by their offset
+    size_t LayoutOffset = 0;
+    for (size_t ByteOffset = 0; ByteOffset + sizeof(uint64_t) <= CacheFileBytes.size(); ByteOffset += alignof(uint64_t))
+    {
+        if (std::memcmp(CacheFileBytes.data() + ByteOffset, &StructuralHash, sizeof(uint64_t)) == 0)
+        {
+            LayoutOffset = ByteOffset;
+        }
+    }
+    DTL_TEST_CHECK(LayoutOffset != 0);
+
+    const std::vector<std::function<void(FCachedTypeLayout&, FCachedMemberLayout*)>> Corruptions{
+        // Misaligned member
+        [](FCachedTypeLayout&, FCachedMemberLayout* Members) { Members[0].Offset += 1; },
+        // Overlapping members
+        [](FCachedTypeLayout&, FCachedMemberLayout* Members) { Members[1].Offset = Members[0].Offset; },
+        // Member placed over the parent type, before the offset the layout starts from
+        [](FCachedTypeLayout&, FCachedMemberLayout* Members) { Members[0].Offset = -8; },
+        // Members that do not fit into the type
+        [](FCachedTypeLayout& Layout, FCachedMemberLayout*) { Layout.Size -= Layout.Alignment; },
+        // Same member placed twice
+        [](FCachedTypeLayout&, FCachedMemberLayout* Members) { Members[1].MemberIndex = Members[0].MemberIndex; },
+    };
+    const std::filesystem::path CorruptedCacheFilePath = std::filesystem::path(CacheFilePath).replace_extension(".corrupted.dtlc");
+    FDynamicTypeLayoutCache& LayoutCache = FDynamicTypeLayoutCache::Get();
+    for (const auto& Corruption : Corruptions)
+    {
+        FCachedTypeLayout CachedLayout;
+        std::memcpy(&CachedLayout, CacheFileBytes.data() + LayoutOffset, sizeof(FCachedTypeLayout));
+        std::vector<FCachedMemberLayout> CachedMembers(CachedLayout.NumMembers);
+        std::memcpy(CachedMembers.data(), CacheFileBytes.data() + LayoutOffset + sizeof(FCachedTypeLayout), CachedMembers.size() * sizeof(FCachedMemberLayout));
+        Corruption(CachedLayout, CachedMembers.data());
+
+        std::vector<uint8_t> CorruptedCacheFileBytes = CacheFileBytes;
+        std::memcpy(CorruptedCacheFileBytes.data() + LayoutOffset, &CachedLayout, sizeof(FCachedTypeLayout));
+        std::memcpy(CorruptedCacheFileBytes.data() + LayoutOffset + sizeof(FCachedTypeLayout), CachedMembers.data(), CachedMembers.size() * sizeof(FCachedMemberLayout));
+        WriteFileBytes(CorruptedCacheFilePath, CorruptedCacheFileBytes);
+        DTL_TEST_CHECK(LayoutCache.LoadFromFile(CorruptedCacheFilePath));
+
+        const uint32_t NumCacheHits = LayoutCache.GetNumCacheHits();
+        const uint32_t NumCacheMisses = LayoutCache.GetNumCacheMisses();
+        const PackedTypeLayout* RecordType = MakeRecordLayout(MakeRecordMembers());
+        DTL_TEST_CHECK(LayoutCache.GetNumCacheHits() == NumCacheHits);
+        DTL_TEST_CHECK(LayoutCache.GetNumCacheMisses() == NumCacheMisses + 1);
+        CheckSameRecordLayout(RecordType, ComputedRecordType);
+    }
+
+    // Truncated file fails the validation of the index, which leaves the cache empty
+    WriteFileBytes(CorruptedCacheFilePath, std::vector<uint8_t>(CacheFileBytes.begin(), CacheFileBytes.begin() + static_cast<std::ptrdiff_t>(LayoutOffset)));
+    DTL_TEST_CHECK(!LayoutCache.LoadFromFile(CorruptedCacheFilePath));
+    DTL_TEST_CHECK(LayoutCache.GetNumTypes() == 0);
+    std::filesystem::remove(CorruptedCacheFilePath);
+}
+
+int main()
+{
+    const std::filesystem::path CacheFilePath = std::filesystem::temp_directory_path() / "DynamicTypeLayoutCacheTests.dtlc";
+    TestNoLookupWithoutLoadedCache();
+    const PackedTypeLayout* ComputedRecordType = MakeRecordLayout(MakeRecordMembers());
+    FDynamicTypeLayoutCache::SaveToFile(CacheFilePath, {ComputedRecordType});
+
+    TestCachedLayoutIsApplied(CacheFilePath, ComputedRecordType);
+    TestAutoLayoutDoesNotUseCache(CacheFilePath);
+    TestConcurrentLoadAndInitialization(CacheFilePath, ComputedRecordType);
+    TestCorruptedLayoutIsRejected(CacheFilePath, ComputedRecordType);
+    std::filesystem::remove(CacheFilePath);
+    return 0;
+}
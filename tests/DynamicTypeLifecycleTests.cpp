@@ -0,0 +1,109 @@
+#include <stdexcept>
+#include "DynamicTypeTestUtils.h"
+
+/** Value counting the live instances, which can be told to throw from the constructor once the provided number of constructions has succeeded */
+struct FTrackedValue
+{
+    static inline int32_t NumLiveValues = 0;
+    static inline int32_t NumConstructionsBeforeThrow = -1;
+
+    FTrackedValue() { Track(); }
+    FTrackedValue(const FTrackedValue&) { Track(); }
+    FTrackedValue(FTrackedValue&&) { Track(); }
+    FTrackedValue& operator=(const FTrackedValue&) = default;
+    FTrackedValue& operator=(FTrackedValue&&) = default;
+    ~FTrackedValue() { NumLiveValues--; }
+
+    static void Track()
+    {
+        if (NumConstructionsBeforeThrow == 0)
+        {
+            throw std::runtime_error("Tracked value construction failed");
+        }
+        NumConstructionsBeforeThrow--;
+        NumLiveValues++;
+    }
+};
+
+class FTrackedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FTrackedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FTrackedValue, First)
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(FTrackedValue, Second)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FTrackedRecord)
+
+class FTrackedPacket : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FTrackedPacket, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(FTrackedValue, Header)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(FTrackedValue, Payload)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FTrackedPacket)
+
+static constexpr size_t NumRecords = 4;
+alignas(16) static uint8_t RecordStorage[1024];
+alignas(16) static uint8_t OtherRecordStorage[1024];
+
+/** Fails the construction after the provided number of values has been constructed, and checks that the values constructed before the failure have been destroyed */
+template<typename InConstructFunction>
+static void CheckConstructionRollsBack(const int32_t NumConstructionsBeforeThrow, InConstructFunction&& ConstructFunction)
+{
+    const int32_t NumLiveValues = FTrackedValue::NumLiveValues;
+    FTrackedValue::NumConstructionsBeforeThrow = NumConstructionsBeforeThrow;
+    DTL_TEST_CHECK_THROWS(ConstructFunction());
+    FTrackedValue::NumConstructionsBeforeThrow = -1;
+    DTL_TEST_CHECK(FTrackedValue::NumLiveValues == NumLiveValues);
+}
+
+/** Plan constructs the members of all the instances before moving to the next member, so the failure in the middle leaves the earlier members constructed in every instance */
+static void TestBulkConstructionRollsBack()
+{
+    const IDynamicTypeLayout* RecordType = FTrackedRecord::StaticType();
+    DTL_TEST_CHECK(RecordType->GetSize() * NumRecords <= sizeof(RecordStorage));
+
+    for (int32_t NumConstructions = 0; NumConstructions < static_cast<int32_t>(NumRecords) * 2; NumConstructions++)
+    {
+        CheckConstructionRollsBack(NumConstructions, [&] { RecordType->EmplaceTypeInstances(RecordStorage, NumRecords); });
+    }
+
+    RecordType->EmplaceTypeInstances(OtherRecordStorage, NumRecords);
+    for (int32_t NumConstructions = 0; NumConstructions < static_cast<int32_t>(NumRecords) * 2; NumConstructions++)
+    {
+        CheckConstructionRollsBack(NumConstructions, [&] { RecordType->CopyConstructTypeInstances(RecordStorage, OtherRecordStorage, NumRecords); });
+        CheckConstructionRollsBack(NumConstructions, [&] { RecordType->MoveConstructTypeInstances(RecordStorage, OtherRecordStorage, NumRecords); });
+    }
+    RecordType->DestructTypeInstances(OtherRecordStorage, NumRecords);
+    DTL_TEST_CHECK(FTrackedValue::NumLiveValues == 0);
+}
+
+/** Failure to construct one of the trailing array elements destroys the elements before it and the fixed part of the instance */
+static void TestTrailingArrayConstructionRollsBack()
+{
+    const IDynamicTypeLayout* PacketType = FTrackedPacket::StaticType();
+    constexpr size_t NumElements = 3;
+    DTL_TEST_CHECK(PacketType->GetSizeWithTrailingArray(NumElements) <= sizeof(RecordStorage));
+
+    for (int32_t NumConstructions = 0; NumConstructions <= static_cast<int32_t>(NumElements); NumConstructions++)
+    {
+        CheckConstructionRollsBack(NumConstructions, [&] { PacketType->EmplaceTypeInstanceWithTrailingArray(RecordStorage, NumElements); });
+    }
+
+    PacketType->EmplaceTypeInstanceWithTrailingArray(OtherRecordStorage, NumElements);
+    for (int32_t NumConstructions = 0; NumConstructions <= static_cast<int32_t>(NumElements); NumConstructions++)
+    {
+        CheckConstructionRollsBack(NumConstructions, [&] { PacketType->CopyConstructTypeInstance(RecordStorage, OtherRecordStorage); });
+    }
+    PacketType->DestructTypeInstance(OtherRecordStorage);
+    DTL_TEST_CHECK(FTrackedValue::NumLiveValues == 0);
+}
+
+int main()
+{
+    TestBulkConstructionRollsBack();
+    TestTrailingArrayConstructionRollsBack();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <string>
+#include "DynamicTypeTestUtils.h"
+
+class FMacroRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FMacroRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(std::string, Name)
+    DEFINE_TYPE_MEMBER_VAL(double, Weight)
+    DEFINE_OPTIONAL_TYPE_MEMBER(int64_t, Extra)
+    DEFINE_CONST_VIRTUAL_FUNCTION(Describe, int32_t, int32_t, Offset)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FMacroRecord)
+
+class FMacroRecordChild : public FMacroRecord
+{
+    DYNAMIC_TYPE_BODY(FMacroRecordChild, FMacroRecord, )
+    DEFINE_TYPE_MEMBER_REF(int16_t, Level)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FMacroRecordChild)
+
+class FMacroPacket : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FMacroPacket, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_ARRAY(std::string, Tags, 3)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(std::string, Payload)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FMacroPacket)
+
+static int32_t DescribeMacroRecord(const FMacroRecord* Record, const int32_t Offset)
+{
+    return Record->GetId() + Offset;
+}
+
+/** Members and virtual functions declared with the macros are collected in declaration order */
+static void TestMacrosCollectMembersInDeclarationOrder()
+{
+    const IDynamicTypeLayout* RecordType = FMacroRecord::StaticType();
+    DTL_TEST_CHECK(RecordType->GetTypeMembers().size() == 4);
+    DTL_TEST_CHECK(RecordType->GetTypeMembers()[0]->GetName() == DTL_TEXT("Id"));
+    DTL_TEST_CHECK(RecordType->GetTypeMembers()[3]->GetName() == DTL_TEXT("Extra"));
+    DTL_TEST_CHECK(RecordType->GetTypeMembers()[3]->IsOptionalMember());
+    DTL_TEST_CHECK(RecordType->GetVirtualFunctions().size() == 1);
+    DTL_TEST_CHECK(FMacroRecordChild::StaticType()->GetTypeMembers().size() == 1);
+}
+
+/** Generated accessors read the cached offsets, which must point at the same values as the offsets of the resolved members */
+static void TestAccessorsUseResolvedOffsets()
+{
+    Dyn<FMacroRecordChild> Record;
+    Record->GetId() = 7;
+    Record->GetName() = "Seven";
+    Record->SetWeight(2.5);
+    *Record->GetExtraPtr() = 70;
+    Record->GetLevel() = 3;
+
+    const IDynamicTypeLayout* RecordType = FMacroRecordChild::StaticType();
+    DTL_TEST_CHECK(*RecordType->FindTypeMemberRecursive(DTL_TEXT("Id"))->ContainerPtrToValuePtr<int32_t>(&*Record) == 7);
+    DTL_TEST_CHECK(*RecordType->FindTypeMemberRecursive(DTL_TEXT("Name"))->ContainerPtrToValuePtr<std::string>(&*Record) == "Seven");
+    DTL_TEST_CHECK(*RecordType->FindTypeMemberRecursive(DTL_TEXT("Weight"))->ContainerPtrToValuePtr<double>(&*Record) == 2.5);
+    DTL_TEST_CHECK(*RecordType->FindTypeMemberRecursive(DTL_TEXT("Extra"))->ContainerPtrToValuePtr<int64_t>(&*Record) == 70);
+    DTL_TEST_CHECK(*RecordType->FindTypeMember(DTL_TEXT("Level"))->ContainerPtrToValuePtr<int16_t>(&*Record) == 3);
+    DTL_TEST_CHECK(Record->GetWeight() == 2.5);
+
+    const Dyn<FMacroRecordChild> RecordCopy = Record;
+    DTL_TEST_CHECK(RecordCopy->GetName() == "Seven");
+    DTL_TEST_CHECK(RecordCopy->GetLevel() == 3);
+}
+
+/** Thunks generated for the virtual functions call the registered override */
+static void TestVirtualFunctionThunkCallsOverride()
+{
+    AutoTypeLayout* RecordType = CastDynamicTypeImpl<AutoTypeLayout>(FMacroRecord::StaticType());
+    RecordType->RegisterVirtualFunctionOverride(RecordType->FindVirtualFunction(DTL_TEXT("Describe")), reinterpret_cast<GenericFunctionPtr>(&DescribeMacroRecord));
+
+    Dyn<FMacroRecordChild> Record;
+    Record->GetId() = 40;
+    DTL_TEST_CHECK(Record->Describe(2) == 42);
+}
+
+/** Array accessors index the elements of the fixed-size and the trailing arrays, which are copied, compared and hashed element by element */
+static void TestArrayAccessorsAndTrailingArrayOperations()
+{
+    Dyn<FMacroPacket> Packet(WithTrailingArray, 4);
+    Dyn<FMacroPacket> OtherPacket(WithTrailingArray, 4);
+    DTL_TEST_CHECK(FMacroPacket::TagsNum == 3);
+    DTL_TEST_CHECK(Packet->GetPayloadNum() == 4);
+
+    for (int32_t TagIndex = 0; TagIndex < FMacroPacket::TagsNum; TagIndex++)
+    {
+        Packet->GetTags(TagIndex) = std::string(32, static_cast<char>('a' + TagIndex));
+    }
+    for (size_t ElementIndex = 0; ElementIndex < Packet->GetPayloadNum(); ElementIndex++)
+    {
+        Packet->GetPayload()[ElementIndex] = std::string(32, static_cast<char>('k' + ElementIndex));
+    }
+    DTL_TEST_CHECK(Packet->GetTags()[2] == std::string(32, 'c'));
+
+    const IDynamicTypeLayout* PacketType = FMacroPacket::StaticType();
+    DTL_TEST_CHECK(!PacketType->EqualsTypeInstance(&*Packet, &*OtherPacket));
+    *OtherPacket = *Packet;
+    DTL_TEST_CHECK(OtherPacket->GetTags(1) == std::string(32, 'b'));
+    DTL_TEST_CHECK(OtherPacket->GetPayload()[3] == std::string(32, 'n'));
+    DTL_TEST_CHECK(PacketType->EqualsTypeInstance(&*Packet, &*OtherPacket));
+    DTL_TEST_CHECK(PacketType->HashTypeInstance(&*Packet) == PacketType->HashTypeInstance(&*OtherPacket));
+
+    OtherPacket->GetPayload()[3].back() = 'z';
+    DTL_TEST_CHECK(!PacketType->EqualsTypeInstance(&*Packet, &*OtherPacket));
+}
+
+int main()
+{
+    TestMacrosCollectMembersInDeclarationOrder();
+    TestAccessorsUseResolvedOffsets();
+    TestVirtualFunctionThunkCallsOverride();
+    TestArrayAccessorsAndTrailingArrayOperations();
+    return 0;
+}
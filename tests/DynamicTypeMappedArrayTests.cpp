@@ -0,0 +1,186 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "DynamicTypeContainers.h"
+#include "DynamicTypeMappedArray.h"
+#include "DynamicTypeTestUtils.h"
+
+class FMappedPoint : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FMappedPoint, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, X)
+    DEFINE_TYPE_MEMBER_REF(int32_t, Y)
+    DEFINE_TYPE_MEMBER_REF(double, Weight)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FMappedPoint)
+
+class FMappedLabel : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FMappedLabel, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(std::string, Text)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FMappedLabel)
+
+/** Versions of the same record are constructed directly instead of being registered under the same name */
+static AutoTypeLayout* MakePairVersion(const dtl_string& FirstMemberName, const dtl_string& SecondMemberName)
+{
+    AutoTypeLayout* PairType = new AutoTypeLayout(DTL_TEXT("MappedPair"), nullptr, {
+        new FDynamicTypeMember(FDynamicTypeName(FirstMemberName), StaticMemberType<int32_t>(DTL_TEXT("int32"))),
+        new FDynamicTypeMember(FDynamicTypeName(SecondMemberName), StaticMemberType<int32_t>(DTL_TEXT("int32"))),
+    }, {});
+    PairType->EnsureInitialized();
+    return PairType;
+}
+
+static DynArray<FMappedPoint> MakePoints(const size_t NumPoints, const int32_t FirstX)
+{
+    DynArray<FMappedPoint> Points;
+    Points.AddDefaulted(NumPoints);
+    for (size_t PointIndex = 0; PointIndex < NumPoints; PointIndex++)
+    {
+        Points[PointIndex].GetX() = FirstX + static_cast<int32_t>(PointIndex);
+        Points[PointIndex].GetY() = -static_cast<int32_t>(PointIndex);
+        Points[PointIndex].GetWeight() = static_cast<double>(PointIndex) * 0.5;
+    }
+    return Points;
+}
+
+static std::vector<uint8_t> ReadFileBytes(const std::filesystem::path& FilePath)
+{
+    std::ifstream File(FilePath, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+}
+
+static void WriteFileBytes(const std::filesystem::path& FilePath, const std::vector<uint8_t>& Bytes)
+{
+    std::ofstream File(FilePath, std::ios::binary | std::ios::trunc);
+    File.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+}
+
+/** Instances written by SaveToFile are read in place from the mapped file, aligned to the alignment of the type */
+static void TestCreateAndOpen(const std::filesystem::path& FilePath)
+{
+    constexpr size_t NumPoints = 100;
+    const DynArray<FMappedPoint> Points = MakePoints(NumPoints, 10);
+    TDynamicTypeMappedArray<FMappedPoint>::SaveToFile(FilePath, &Points[0], Points.Num());
+
+    TDynamicTypeMappedArray<FMappedPoint> MappedPoints;
+    DTL_TEST_CHECK(!MappedPoints.IsOpen());
+    DTL_TEST_CHECK(MappedPoints.Open(FilePath));
+    DTL_TEST_CHECK(MappedPoints.IsOpen());
+    DTL_TEST_CHECK(MappedPoints.Num() == NumPoints);
+    DTL_TEST_CHECK(reinterpret_cast<uintptr_t>(&MappedPoints[0]) % FMappedPoint::StaticType()->GetMinAlignment() == 0);
+
+    size_t PointIndex = 0;
+    for (const FMappedPoint& Point : MappedPoints)
+    {
+        DTL_TEST_CHECK(FMappedPoint::StaticType()->EqualsTypeInstance(&Point, &Points[PointIndex]));
+        PointIndex++;
+    }
+    DTL_TEST_CHECK(PointIndex == NumPoints);
+    DTL_TEST_CHECK(MappedPoints[99].GetX() == 109);
+    DTL_TEST_CHECK(MappedPoints[99].GetWeight() == 49.5);
+
+    MappedPoints.Close();
+    DTL_TEST_CHECK(!MappedPoints.IsOpen());
+    DTL_TEST_CHECK(MappedPoints.Num() == 0);
+}
+
+/** Opening the file again replaces the previous mapping, and picks up the file that has been rewritten in the meantime */
+static void TestReopen(const std::filesystem::path& FilePath)
+{
+    const DynArray<FMappedPoint> Points = MakePoints(4, 0);
+    TDynamicTypeMappedArray<FMappedPoint>::SaveToFile(FilePath, &Points[0], Points.Num());
+
+    TDynamicTypeMappedArray<FMappedPoint> MappedPoints;
+    DTL_TEST_CHECK(MappedPoints.Open(FilePath));
+    DTL_TEST_CHECK(MappedPoints.Num() == 4);
+    DTL_TEST_CHECK(MappedPoints.Open(FilePath));
+    DTL_TEST_CHECK(MappedPoints.Num() == 4);
+    DTL_TEST_CHECK(MappedPoints[3].GetX() == 3);
+
+    // File cannot be replaced while it is mapped on Windows, so it is closed before being rewritten
+    MappedPoints.Close();
+    const DynArray<FMappedPoint> NewPoints = MakePoints(7, 1000);
+    TDynamicTypeMappedArray<FMappedPoint>::SaveToFile(FilePath, &NewPoints[0], NewPoints.Num());
+    DTL_TEST_CHECK(MappedPoints.Open(FilePath));
+    DTL_TEST_CHECK(MappedPoints.Num() == 7);
+    DTL_TEST_CHECK(MappedPoints[6].GetX() == 1006);
+
+    // Empty array still has the header, so it can be opened
+    MappedPoints.Close();
+    TDynamicTypeMappedArray<FMappedPoint>::SaveToFile(FilePath, nullptr, 0);
+    DTL_TEST_CHECK(MappedPoints.Open(FilePath));
+    DTL_TEST_CHECK(MappedPoints.Num() == 0);
+    DTL_TEST_CHECK(MappedPoints.begin() == MappedPoints.end());
+}
+
+/** Type with the same size and alignment but a different record layout has a different fingerprint, so it cannot open the file */
+static void TestFingerprintMismatchIsRejected(const std::filesystem::path& FilePath)
+{
+    const AutoTypeLayout* PairType = MakePairVersion(DTL_TEXT("First"), DTL_TEXT("Second"));
+    const AutoTypeLayout* SwappedPairType = MakePairVersion(DTL_TEXT("Second"), DTL_TEXT("First"));
+    DTL_TEST_CHECK(PairType->GetSize() == SwappedPairType->GetSize());
+
+    const int32_t Pair[2]{1, 2};
+    FDynamicTypeMappedArray::SaveToFile(FilePath, PairType, Pair, 1);
+    FDynamicTypeMappedArray MappedPairs;
+    DTL_TEST_CHECK(MappedPairs.Open(FilePath, PairType));
+    DTL_TEST_CHECK(MappedPairs.GetDynamicType() == PairType);
+    DTL_TEST_CHECK(static_cast<const int32_t*>(MappedPairs.GetData())[1] == 2);
+    DTL_TEST_CHECK(!MappedPairs.Open(FilePath, SwappedPairType));
+    DTL_TEST_CHECK(!MappedPairs.IsOpen());
+    DTL_TEST_CHECK(MappedPairs.GetDynamicType() == nullptr);
+
+    // Different type of a different size is rejected as well
+    TDynamicTypeMappedArray<FMappedPoint> MappedPoints;
+    DTL_TEST_CHECK(!MappedPoints.Open(FilePath));
+
+    // Types that own memory outside of the record cannot be persisted at all
+    DynArray<FMappedLabel> Labels;
+    Labels.AddDefaulted(1);
+    DTL_TEST_CHECK_THROWS(TDynamicTypeMappedArray<FMappedLabel>::SaveToFile(FilePath, &Labels[0], Labels.Num()));
+    DTL_TEST_CHECK_THROWS(TDynamicTypeMappedArray<FMappedLabel>().Open(FilePath));
+}
+
+/** Files too small to hold the header or the number of instances recorded in it are rejected instead of being read past their end */
+static void TestUndersizedFileIsRejected(const std::filesystem::path& FilePath)
+{
+    const DynArray<FMappedPoint> Points = MakePoints(16, 0);
+    TDynamicTypeMappedArray<FMappedPoint>::SaveToFile(FilePath, &Points[0], Points.Num());
+    const std::vector<uint8_t> FileBytes = ReadFileBytes(FilePath);
+    const size_t PointSize = FMappedPoint::StaticType()->GetSize();
+
+    TDynamicTypeMappedArray<FMappedPoint> MappedPoints;
+    for (const size_t TruncatedSize : {size_t{1}, size_t{16}, FileBytes.size() - Points.Num() * PointSize - 1, FileBytes.size() - PointSize, FileBytes.size() - 1})
+    {
+        WriteFileBytes(FilePath, std::vector<uint8_t>(FileBytes.begin(), FileBytes.begin() + static_cast<std::ptrdiff_t>(TruncatedSize)));
+        DTL_TEST_CHECK(!MappedPoints.Open(FilePath));
+        DTL_TEST_CHECK(!MappedPoints.IsOpen());
+    }
+
+    // Empty file cannot be mapped, and the missing file cannot be opened
+    WriteFileBytes(FilePath, {});
+    DTL_TEST_CHECK(!MappedPoints.Open(FilePath));
+    std::filesystem::remove(FilePath);
+    DTL_TEST_CHECK(!MappedPoints.Open(FilePath));
+
+    WriteFileBytes(FilePath, FileBytes);
+    DTL_TEST_CHECK(MappedPoints.Open(FilePath));
+    DTL_TEST_CHECK(MappedPoints.Num() == Points.Num());
+}
+
+int main()
+{
+    const std::filesystem::path FilePath = std::filesystem::temp_directory_path() / "DynamicTypeMappedArrayTests.dtda";
+    TestCreateAndOpen(FilePath);
+    TestReopen(FilePath);
+    TestFingerprintMismatchIsRejected(FilePath);
+    TestUndersizedFileIsRejected(FilePath);
+    std::filesystem::remove(FilePath);
+    return 0;
+}
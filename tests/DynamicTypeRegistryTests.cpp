@@ -0,0 +1,154 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DynamicTypeTestUtils.h"
+
+class FRegistryRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FRegistryRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FRegistryRecord)
+
+/** Never referenced by it's C++ name, so it can only be reached through the registry */
+class FUnreferencedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FUnreferencedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int64_t, Value)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FUnreferencedRecord)
+
+static dtl_string MakeTypeName(const std::string& Prefix, const size_t Index)
+{
+    const std::string TypeName = Prefix + std::to_string(Index);
+    return dtl_string(TypeName.begin(), TypeName.end());
+}
+
+/** Types are registered directly instead of being declared with the macros, so the tests can register as many of them as they need */
+static AutoTypeLayout* RegisterGeneratedType(const dtl_string& TypeName)
+{
+    AutoTypeLayout* Type = new AutoTypeLayout(FDynamicTypeName(TypeName), nullptr, {}, {});
+    FDynamicTypeRegistry::Get().RegisterType(Type);
+    return Type;
+}
+
+/** Types implemented with the macros are registered during the static initialization, so they can be found by name before they are first used */
+static void TestTypesRegisteredOnStartup()
+{
+    const IDynamicTypeLayout* RecordType = FDynamicTypeRegistry::Get().FindTypeByName(DTL_TEXT("FUnreferencedRecord"));
+    DTL_TEST_CHECK(RecordType != nullptr);
+    DTL_TEST_CHECK(RecordType->GetSize() == sizeof(int64_t));
+}
+
+/** Lookups by name find the registered types, and return nullptr for the names that are not registered */
+static void TestFindTypeByName()
+{
+    const FDynamicTypeRegistry& TypeRegistry = FDynamicTypeRegistry::Get();
+    const IDynamicTypeLayout* RecordType = FRegistryRecord::StaticType();
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByName(DTL_TEXT("FRegistryRecord")) == RecordType);
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByInternedName(FDynamicTypeName(DTL_TEXT("FRegistryRecord"))) == RecordType);
+    DTL_TEST_CHECK(TypeRegistry.FindTypeById(RecordType->GetTypeId()) == RecordType);
+
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByName(DTL_TEXT("FMissingRecord")) == nullptr);
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByName(DTL_TEXT("FRegistryRecor")) == nullptr);
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByName(DTL_TEXT("")) == nullptr);
+    DTL_TEST_CHECK(TypeRegistry.FindTypeById(TypeRegistry.GetNumTypes()) == nullptr);
+
+    // Names must be unique, so registering the second type with the same name fails
+    DTL_TEST_CHECK_THROWS(RegisterGeneratedType(DTL_TEXT("FRegistryRecord")));
+}
+
+/** Registering more types than fit into one chunk allocates the next chunk and grows the name table, without losing the types registered before */
+static void TestRegistryGrowth()
+{
+    const FDynamicTypeRegistry& TypeRegistry = FDynamicTypeRegistry::Get();
+    const uint32_t NumTypesBefore = TypeRegistry.GetNumTypes();
+    constexpr size_t NumGeneratedTypes = 600;
+
+    std::vector<AutoTypeLayout*> GeneratedTypes;
+    for (size_t TypeIndex = 0; TypeIndex < NumGeneratedTypes; TypeIndex++)
+    {
+        GeneratedTypes.push_back(RegisterGeneratedType(MakeTypeName("FGrowthType_", TypeIndex)));
+        DTL_TEST_CHECK(GeneratedTypes.back()->GetTypeId() == NumTypesBefore + TypeIndex);
+    }
+    DTL_TEST_CHECK(TypeRegistry.GetNumTypes() == NumTypesBefore + NumGeneratedTypes);
+
+    for (size_t TypeIndex = 0; TypeIndex < NumGeneratedTypes; TypeIndex++)
+    {
+        DTL_TEST_CHECK(TypeRegistry.FindTypeById(GeneratedTypes[TypeIndex]->GetTypeId()) == GeneratedTypes[TypeIndex]);
+        DTL_TEST_CHECK(TypeRegistry.FindTypeByName(MakeTypeName("FGrowthType_", TypeIndex)) == GeneratedTypes[TypeIndex]);
+    }
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByName(MakeTypeName("FGrowthType_", NumGeneratedTypes)) == nullptr);
+    DTL_TEST_CHECK(TypeRegistry.FindTypeByName(DTL_TEXT("FRegistryRecord")) == FRegistryRecord::StaticType());
+}
+
+/** Lookups running concurrently with the registration always see either nothing or the fully registered type */
+static void TestConcurrentRegistrationAndLookup()
+{
+    const FDynamicTypeRegistry& TypeRegistry = FDynamicTypeRegistry::Get();
+    constexpr size_t NumRegisteringThreads = 4;
+    constexpr size_t NumTypesPerThread = 200;
+    constexpr size_t NumLookupThreads = 4;
+
+    std::atomic<bool> bRegistrationFinished{false};
+    std::atomic<bool> bLookupFailed{false};
+    {
+        std::vector<std::jthread> LookupThreads;
+        for (size_t ThreadIndex = 0; ThreadIndex < NumLookupThreads; ThreadIndex++)
+        {
+            LookupThreads.emplace_back([&]
+            {
+                while (!bRegistrationFinished.load(std::memory_order_acquire))
+                {
+                    // Every ID below the number of types is reachable, and the type found by the name is the type with that name
+                    const uint32_t NumTypes = TypeRegistry.GetNumTypes();
+                    const IDynamicTypeLayout* LastType = TypeRegistry.FindTypeById(NumTypes - 1);
+                    if (LastType == nullptr || TypeRegistry.FindTypeByName(LastType->GetTypeName()) != LastType)
+                    {
+                        bLookupFailed.store(true, std::memory_order_relaxed);
+                    }
+                    if (TypeRegistry.FindTypeByName(DTL_TEXT("FRegistryRecord")) != FRegistryRecord::StaticType())
+                    {
+                        bLookupFailed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+
+        std::vector<std::jthread> RegisteringThreads;
+        for (size_t ThreadIndex = 0; ThreadIndex < NumRegisteringThreads; ThreadIndex++)
+        {
+            RegisteringThreads.emplace_back([ThreadIndex]
+            {
+                for (size_t TypeIndex = 0; TypeIndex < NumTypesPerThread; TypeIndex++)
+                {
+                    RegisterGeneratedType(MakeTypeName("FConcurrentType_" + std::to_string(ThreadIndex) + "_", TypeIndex));
+                }
+            });
+        }
+        RegisteringThreads.clear();
+        bRegistrationFinished.store(true, std::memory_order_release);
+    }
+    DTL_TEST_CHECK(!bLookupFailed.load());
+
+    for (size_t ThreadIndex = 0; ThreadIndex < NumRegisteringThreads; ThreadIndex++)
+    {
+        for (size_t TypeIndex = 0; TypeIndex < NumTypesPerThread; TypeIndex++)
+        {
+            const IDynamicTypeLayout* Type = TypeRegistry.FindTypeByName(MakeTypeName("FConcurrentType_" + std::to_string(ThreadIndex) + "_", TypeIndex));
+            DTL_TEST_CHECK(Type != nullptr && TypeRegistry.FindTypeById(Type->GetTypeId()) == Type);
+        }
+    }
+}
+
+int main()
+{
+    TestTypesRegisteredOnStartup();
+    TestFindTypeByName();
+    TestRegistryGrowth();
+    TestConcurrentRegistrationAndLookup();
+    return 0;
+}
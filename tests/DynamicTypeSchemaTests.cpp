@@ -0,0 +1,105 @@
+#include <string>
+#include <vector>
+#include "DynamicTypeSchema.h"
+#include "DynamicTypeTestUtils.h"
+
+static FDynamicTypeMember SourceIdMember(DTL_TEXT("Id"), StaticMemberType<int32_t>(DTL_TEXT("int32")));
+static FDynamicTypeMember SourceLabelMember(DTL_TEXT("Label"), StaticMemberType<std::string>(DTL_TEXT("string")));
+
+static FDynamicTypeMember TargetIdMember(DTL_TEXT("Id"), StaticMemberType<int32_t>(DTL_TEXT("int32")));
+static FDynamicTypeMember TargetScaleMember(DTL_TEXT("Scale"), StaticMemberType<float>(DTL_TEXT("float")), true);
+static FDynamicTypeMember RequiredLabelMember(DTL_TEXT("Label"), StaticMemberType<std::string>(DTL_TEXT("string")));
+static FDynamicTypeMember OptionalLabelMember(DTL_TEXT("Label"), StaticMemberType<std::string>(DTL_TEXT("string")), true);
+
+/** Same size and representation as int32_t, but not trivially default constructible */
+struct FInitializedInt
+{
+    int32_t Value{0};
+};
+
+/** Same size as int32_t, but not trivially copyable */
+struct FCopiedInt
+{
+    int32_t Value{0};
+
+    FCopiedInt() = default;
+    FCopiedInt(const FCopiedInt& Other) : Value(Other.Value) {}
+    FCopiedInt& operator=(const FCopiedInt& Other) = default;
+};
+
+static FDynamicTypeMember InitializedIdMember(DTL_TEXT("Id"), StaticMemberType<FInitializedInt>(DTL_TEXT("int32")));
+static FDynamicTypeMember CopiedIdMember(DTL_TEXT("Id"), StaticMemberType<FCopiedInt>(DTL_TEXT("int32")));
+
+/** Returns the reference to the value of the member in the record */
+template<typename InMemberType>
+static InMemberType& MemberValue(const FDynamicTypeMember& Member, void* Record)
+{
+    return *Member.ContainerPtrToValuePtr<InMemberType>(Record);
+}
+
+/** Layouts describe the versions of the same record, so they are constructed directly instead of being registered under the same name */
+static AutoTypeLayout* MakeRecordVersion(const std::vector<FDynamicTypeMember*>& Members)
+{
+    AutoTypeLayout* RecordType = new AutoTypeLayout(DTL_TEXT("Record"), nullptr, Members, {});
+    RecordType->EnsureInitialized();
+    return RecordType;
+}
+
+/** Traits that do not change how the records are read leave the fingerprint unchanged, while losing the trivial copyability changes it */
+static void TestFingerprintIgnoresLayoutIndependentTraits()
+{
+    const FDynamicTypeSchema SourceSchema = FDynamicTypeSchema::FromType(MakeRecordVersion({&SourceIdMember}));
+    const FDynamicTypeSchema InitializedSchema = FDynamicTypeSchema::FromType(MakeRecordVersion({&InitializedIdMember}));
+    const FDynamicTypeSchema CopiedSchema = FDynamicTypeSchema::FromType(MakeRecordVersion({&CopiedIdMember}));
+
+    DTL_TEST_CHECK(SourceSchema.GetMembers()[0].TypeFlags != InitializedSchema.GetMembers()[0].TypeFlags);
+    DTL_TEST_CHECK(SourceSchema.GetFingerprint() == InitializedSchema.GetFingerprint());
+    DTL_TEST_CHECK(SourceSchema.GetFingerprint() != CopiedSchema.GetFingerprint());
+}
+
+/** Non-trivial members cannot be copied from the raw records, so the target requiring one cannot be migrated to */
+static void TestRequiredNonTrivialMemberFailsPlan()
+{
+    const AutoTypeLayout* SourceType = MakeRecordVersion({&SourceIdMember, &SourceLabelMember});
+    const AutoTypeLayout* TargetType = MakeRecordVersion({&TargetIdMember, &RequiredLabelMember});
+    const FDynamicTypeSchema SourceSchema = FDynamicTypeSchema::FromType(SourceType);
+
+    DTL_TEST_CHECK_THROWS(FDynamicTypeMigrationPlan(SourceSchema, TargetType));
+    DTL_TEST_CHECK_THROWS(FDynamicTypeMigrationPlan::FindOrCompile(SourceSchema, TargetType));
+}
+
+/** Optional non-trivial members are left default constructed, while the trivially copyable members are carried over */
+static void TestOptionalNonTrivialMemberIsDefaulted()
+{
+    AutoTypeLayout* SourceType = MakeRecordVersion({&SourceIdMember, &SourceLabelMember});
+    AutoTypeLayout* TargetType = MakeRecordVersion({&TargetScaleMember, &OptionalLabelMember, &TargetIdMember});
+    const FDynamicTypeMigrationPlan MigrationPlan(FDynamicTypeSchema::FromType(SourceType), TargetType);
+
+    constexpr size_t NumRecords = 3;
+    std::vector<uint8_t> SourceRecords(SourceType->GetSize() * NumRecords);
+    SourceType->EmplaceTypeInstances(SourceRecords.data(), NumRecords);
+    for (size_t RecordIndex = 0; RecordIndex < NumRecords; RecordIndex++)
+    {
+        MemberValue<int32_t>(SourceIdMember, SourceRecords.data() + RecordIndex * SourceType->GetSize()) = static_cast<int32_t>(RecordIndex + 10);
+    }
+
+    std::vector<uint8_t> TargetRecords(TargetType->GetSize() * NumRecords);
+    MigrationPlan.MigrateRecords(SourceRecords.data(), NumRecords, TargetRecords.data());
+    for (size_t RecordIndex = 0; RecordIndex < NumRecords; RecordIndex++)
+    {
+        uint8_t* TargetRecord = TargetRecords.data() + RecordIndex * TargetType->GetSize();
+        DTL_TEST_CHECK(MemberValue<int32_t>(TargetIdMember, TargetRecord) == static_cast<int32_t>(RecordIndex + 10));
+        DTL_TEST_CHECK(MemberValue<float>(TargetScaleMember, TargetRecord) == 0.0f);
+        DTL_TEST_CHECK(MemberValue<std::string>(OptionalLabelMember, TargetRecord).empty());
+    }
+    TargetType->DestructTypeInstances(TargetRecords.data(), NumRecords);
+    SourceType->DestructTypeInstances(SourceRecords.data(), NumRecords);
+}
+
+int main()
+{
+    TestFingerprintIgnoresLayoutIndependentTraits();
+    TestRequiredNonTrivialMemberFailsPlan();
+    TestOptionalNonTrivialMemberIsDefaulted();
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "DynamicTypeSerialization.h"
+#include "DynamicTypeTestUtils.h"
+
+class FSerializedRecord : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FSerializedRecord, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(std::string, Name)
+    DEFINE_TYPE_MEMBER_REF(std::vector<int32_t>, Values)
+    DEFINE_TYPE_MEMBER_ARRAY(float, Weights, 3)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FSerializedRecord)
+
+/** Same members as FSerializedRecord except for the type of the last one, so only the serialized layout tells them apart */
+class FSerializedRecordV2 : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FSerializedRecordV2, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_REF(std::string, Name)
+    DEFINE_TYPE_MEMBER_REF(std::vector<int32_t>, Values)
+    DEFINE_TYPE_MEMBER_ARRAY(double, Weights, 3)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FSerializedRecordV2)
+
+class FSerializedPacket : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FSerializedPacket, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(std::string, Lines)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FSerializedPacket)
+
+class FSerializedSamples : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FSerializedSamples, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int16_t, Channel)
+    DEFINE_TYPE_MEMBER_TRAILING_ARRAY(int32_t, Samples)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FSerializedSamples)
+
+/** Serializes the stream of instances into the buffer sized by FDynamicTypeSizeCounter */
+static std::vector<uint8_t> WriteStream(const IDynamicTypeLayout* DynamicType, const std::vector<const void*>& TypeInstances)
+{
+    const auto WriteInstances = [&](IDynamicTypeWriter& Writer)
+    {
+        WriteDynamicTypeStreamHeader(DynamicType, TypeInstances.size(), Writer);
+        for (const void* TypeInstance : TypeInstances)
+        {
+            DynamicType->SerializeTypeInstance(TypeInstance, Writer);
+        }
+    };
+    FDynamicTypeSizeCounter SizeCounter;
+    WriteInstances(SizeCounter);
+
+    std::vector<uint8_t> StreamBytes(SizeCounter.GetSize());
+    FDynamicTypeBufferWriter Writer(StreamBytes.data(), StreamBytes.size());
+    WriteInstances(Writer);
+    DTL_TEST_CHECK(Writer.GetWrittenSize() == StreamBytes.size());
+    return StreamBytes;
+}
+
+static void FillRecord(FSerializedRecord& Record, const int32_t Id)
+{
+    Record.GetId() = Id;
+    Record.GetName() = "Record number " + std::to_string(Id) + " with a name too long for the small string buffer";
+    Record.GetValues() = {Id, Id * 2, Id * 3};
+    for (int32_t WeightIndex = 0; WeightIndex < FSerializedRecord::WeightsNum; WeightIndex++)
+    {
+        Record.GetWeights(WeightIndex) = static_cast<float>(Id) + 0.25f * static_cast<float>(WeightIndex);
+    }
+}
+
+/** Instances read back from the stream are equal to the instances written into it, including their strings, vectors and fixed-size arrays */
+static void TestRecordRoundTrip()
+{
+    const IDynamicTypeLayout* RecordType = FSerializedRecord::StaticType();
+    Dyn<FSerializedRecord> FirstRecord;
+    Dyn<FSerializedRecord> SecondRecord;
+    FillRecord(*FirstRecord, 1);
+    FillRecord(*SecondRecord, 2);
+    SecondRecord->GetValues().clear();
+    const std::vector<uint8_t> StreamBytes = WriteStream(RecordType, {&*FirstRecord, &*SecondRecord});
+
+    FDynamicTypeBufferReader Reader(StreamBytes.data(), StreamBytes.size());
+    DTL_TEST_CHECK(ReadDynamicTypeStreamHeader(RecordType, Reader) == 2);
+    Dyn<FSerializedRecord> ReadFirstRecord;
+    Dyn<FSerializedRecord> ReadSecondRecord;
+    RecordType->DeserializeTypeInstance(&*ReadFirstRecord, Reader);
+    RecordType->DeserializeTypeInstance(&*ReadSecondRecord, Reader);
+    DTL_TEST_CHECK(Reader.GetRemainingSize() == 0);
+
+    DTL_TEST_CHECK(RecordType->EqualsTypeInstance(&*ReadFirstRecord, &*FirstRecord));
+    DTL_TEST_CHECK(RecordType->EqualsTypeInstance(&*ReadSecondRecord, &*SecondRecord));
+    DTL_TEST_CHECK(ReadFirstRecord->GetName() == FirstRecord->GetName());
+    DTL_TEST_CHECK(ReadFirstRecord->GetValues().size() == 3 && ReadFirstRecord->GetValues()[2] == 3);
+    DTL_TEST_CHECK(ReadSecondRecord->GetValues().empty());
+    DTL_TEST_CHECK(ReadSecondRecord->GetWeights(2) == 2.5f);
+}
+
+/** Trailing arrays are written as the number of elements followed by the elements, and are read into the instance constructed with the same number of elements */
+static void TestTrailingArrayRoundTrip()
+{
+    const IDynamicTypeLayout* PacketType = FSerializedPacket::StaticType();
+    Dyn<FSerializedPacket> Packet(WithTrailingArray, 3);
+    Packet->GetId() = 9;
+    for (size_t LineIndex = 0; LineIndex < Packet->GetLinesNum(); LineIndex++)
+    {
+        Packet->GetLines()[LineIndex] = std::string(24 + LineIndex, static_cast<char>('a' + LineIndex));
+    }
+    std::vector<uint8_t> StreamBytes = WriteStream(PacketType, {&*Packet});
+    {
+        FDynamicTypeBufferReader Reader(StreamBytes.data(), StreamBytes.size());
+        DTL_TEST_CHECK(ReadDynamicTypeStreamHeader(PacketType, Reader) == 1);
+        Dyn<FSerializedPacket> ReadPacket(WithTrailingArray, 3);
+        PacketType->DeserializeTypeInstance(&*ReadPacket, Reader);
+        DTL_TEST_CHECK(PacketType->EqualsTypeInstance(&*ReadPacket, &*Packet));
+        DTL_TEST_CHECK(ReadPacket->GetLines()[2] == std::string(26, 'c'));
+    }
+
+    // Trivially copyable elements are written and read with a single call, and the empty trailing array only writes it's number of elements
+    const IDynamicTypeLayout* SamplesType = FSerializedSamples::StaticType();
+    Dyn<FSerializedSamples> Samples(WithTrailingArray, 5);
+    Dyn<FSerializedSamples> NoSamples(WithTrailingArray, 0);
+    Samples->GetChannel() = 2;
+    for (size_t SampleIndex = 0; SampleIndex < Samples->GetSamplesNum(); SampleIndex++)
+    {
+        Samples->GetSamples()[SampleIndex] = static_cast<int32_t>(SampleIndex * 100);
+    }
+    StreamBytes = WriteStream(SamplesType, {&*Samples, &*NoSamples});
+    {
+        FDynamicTypeBufferReader Reader(StreamBytes.data(), StreamBytes.size());
+        DTL_TEST_CHECK(ReadDynamicTypeStreamHeader(SamplesType, Reader) == 2);
+        Dyn<FSerializedSamples> ReadSamples(WithTrailingArray, 5);
+        Dyn<FSerializedSamples> ReadNoSamples(WithTrailingArray, 0);
+        SamplesType->DeserializeTypeInstance(&*ReadSamples, Reader);
+        SamplesType->DeserializeTypeInstance(&*ReadNoSamples, Reader);
+        DTL_TEST_CHECK(Reader.GetRemainingSize() == 0);
+        DTL_TEST_CHECK(SamplesType->EqualsTypeInstance(&*ReadSamples, &*Samples));
+        DTL_TEST_CHECK(ReadSamples->GetSamples()[4] == 400);
+        DTL_TEST_CHECK(ReadNoSamples->GetSamplesNum() == 0);
+    }
+}
+
+/** Trailing array cannot be resized by the deserialization, so reading it into the instance with a different number of elements throws */
+static void TestTrailingArrayNumMismatchThrows()
+{
+    const IDynamicTypeLayout* PacketType = FSerializedPacket::StaticType();
+    Dyn<FSerializedPacket> Packet(WithTrailingArray, 3);
+    const std::vector<uint8_t> StreamBytes = WriteStream(PacketType, {&*Packet});
+
+    for (const size_t ReadLinesNum : {size_t{0}, size_t{2}, size_t{4}})
+    {
+        FDynamicTypeBufferReader Reader(StreamBytes.data(), StreamBytes.size());
+        DTL_TEST_CHECK(ReadDynamicTypeStreamHeader(PacketType, Reader) == 1);
+        Dyn<FSerializedPacket> ReadPacket(WithTrailingArray, ReadLinesNum);
+        DTL_TEST_CHECK_THROWS(PacketType->DeserializeTypeInstance(&*ReadPacket, Reader));
+        DTL_TEST_CHECK(ReadPacket->GetLinesNum() == ReadLinesNum);
+    }
+}
+
+/** Stream headers with the wrong magic, version or layout hash are rejected before any instance is read */
+static void TestCorruptedHeaderIsRejected()
+{
+    const IDynamicTypeLayout* RecordType = FSerializedRecord::StaticType();
+    Dyn<FSerializedRecord> Record;
+    FillRecord(*Record, 3);
+    const std::vector<uint8_t> StreamBytes = WriteStream(RecordType, {&*Record});
+
+    const std::vector<std::function<void(FDynamicTypeStreamHeader&)>> Corruptions{
+        [](FDynamicTypeStreamHeader& Header) { Header.Magic ^= 1; },
+        [](FDynamicTypeStreamHeader& Header) { Header.Version++; },
+        [](FDynamicTypeStreamHeader& Header) { Header.LayoutHash ^= 1; },
+    };
+    for (const auto& Corruption : Corruptions)
+    {
+        std::vector<uint8_t> CorruptedStreamBytes = StreamBytes;
+        FDynamicTypeStreamHeader Header;
+        std::memcpy(&Header, CorruptedStreamBytes.data(), sizeof(Header));
+        Corruption(Header);
+        std::memcpy(CorruptedStreamBytes.data(), &Header, sizeof(Header));
+
+        FDynamicTypeBufferReader Reader(CorruptedStreamBytes.data(), CorruptedStreamBytes.size());
+        DTL_TEST_CHECK_THROWS(ReadDynamicTypeStreamHeader(RecordType, Reader));
+    }
+
+    // Header shorter than the header itself
+    FDynamicTypeBufferReader TruncatedReader(StreamBytes.data(), sizeof(FDynamicTypeStreamHeader) - 1);
+    DTL_TEST_CHECK_THROWS(ReadDynamicTypeStreamHeader(RecordType, TruncatedReader));
+}
+
+/** Types with the same member names but different member types have different serialized layouts, so the stream written by one cannot be read as the other */
+static void TestMismatchedLayoutIsRejected()
+{
+    DTL_TEST_CHECK(HashSerializedTypeLayout(FSerializedRecord::StaticType()) != HashSerializedTypeLayout(FSerializedRecordV2::StaticType()));
+    DTL_TEST_CHECK(HashSerializedTypeLayout(FSerializedRecord::StaticType()) == HashSerializedTypeLayout(FSerializedRecord::StaticType()));
+
+    Dyn<FSerializedRecord> Record;
+    FillRecord(*Record, 4);
+    const std::vector<uint8_t> StreamBytes = WriteStream(FSerializedRecord::StaticType(), {&*Record});
+    FDynamicTypeBufferReader Reader(StreamBytes.data(), StreamBytes.size());
+    DTL_TEST_CHECK_THROWS(ReadDynamicTypeStreamHeader(FSerializedRecordV2::StaticType(), Reader));
+
+    FDynamicTypeBufferReader PacketReader(StreamBytes.data(), StreamBytes.size());
+    DTL_TEST_CHECK_THROWS(ReadDynamicTypeStreamHeader(FSerializedPacket::StaticType(), PacketReader));
+}
+
+/** Truncated instances and element counts larger than the rest of the data throw instead of reading past the end of the stream */
+static void TestCorruptedInstanceIsRejected()
+{
+    const IDynamicTypeLayout* RecordType = FSerializedRecord::StaticType();
+    Dyn<FSerializedRecord> Record;
+    FillRecord(*Record, 5);
+    const std::vector<uint8_t> StreamBytes = WriteStream(RecordType, {&*Record});
+
+    for (size_t TruncatedSize = sizeof(FDynamicTypeStreamHeader); TruncatedSize < StreamBytes.size(); TruncatedSize += 7)
+    {
+        FDynamicTypeBufferReader Reader(StreamBytes.data(), TruncatedSize);
+        DTL_TEST_CHECK(ReadDynamicTypeStreamHeader(RecordType, Reader) == 1);
+        Dyn<FSerializedRecord> ReadRecord;
+        DTL_TEST_CHECK_THROWS(RecordType->DeserializeTypeInstance(&*ReadRecord, Reader));
+    }
+
+    // Name is written right after the Id, starting with it's number of characters
+    std::vector<uint8_t> CorruptedStreamBytes = StreamBytes;
+    const uint64_t CorruptedNameNum = uint64_t{1} << 40;
+    std::memcpy(CorruptedStreamBytes.data() + sizeof(FDynamicTypeStreamHeader) + sizeof(int32_t), &CorruptedNameNum, sizeof(CorruptedNameNum));
+    FDynamicTypeBufferReader Reader(CorruptedStreamBytes.data(), CorruptedStreamBytes.size());
+    DTL_TEST_CHECK(ReadDynamicTypeStreamHeader(RecordType, Reader) == 1);
+    Dyn<FSerializedRecord> ReadRecord;
+    DTL_TEST_CHECK_THROWS(RecordType->DeserializeTypeInstance(&*ReadRecord, Reader));
+}
+
+int main()
+{
+    TestRecordRoundTrip();
+    TestTrailingArrayRoundTrip();
+    TestTrailingArrayNumMismatchThrows();
+    TestCorruptedHeaderIsRejected();
+    TestMismatchedLayoutIsRejected();
+    TestCorruptedInstanceIsRejected();
+    return 0;
+}
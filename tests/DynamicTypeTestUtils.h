@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include "DynamicTypeMacros.h"
+
+/** Fails the test with the location of the failed check. Tests are plain executables run by CTest, which treats the non-zero exit code as a failure */
+#define DTL_TEST_CHECK( __CONDITION__ ) \
+    do \
+    { \
+        if (!(__CONDITION__)) \
+        { \
+            std::fprintf(stderr, "%s:%d: Check failed: %s\n", __FILE__, __LINE__, #__CONDITION__); \
+            std::exit(1); \
+        } \
+    } while (false)
+
+/** Fails the test if evaluating the expression does not throw */
+#define DTL_TEST_CHECK_THROWS( __EXPRESSION__ ) \
+    do \
+    { \
+        bool bThrown = false; \
+        try { (void)(__EXPRESSION__); } catch (const std::exception&) { bThrown = true; } \
+        DTL_TEST_CHECK(bThrown && "Expected to throw: " #__EXPRESSION__); \
+    } while (false)
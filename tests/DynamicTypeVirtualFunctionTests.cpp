@@ -0,0 +1,179 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include "DynamicTypeTestUtils.h"
+
+class FVersionedShape : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FVersionedShape, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Id)
+    DEFINE_CONST_VIRTUAL_FUNCTION(GetMajorVersion, int32_t, int32_t, Bias)
+    DEFINE_CONST_VIRTUAL_FUNCTION(GetMinorVersion, int32_t, int32_t, Bias)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FVersionedShape)
+
+class FVersionedCircle : public FVersionedShape
+{
+    DYNAMIC_TYPE_BODY(FVersionedCircle, FVersionedShape, )
+    DEFINE_TYPE_MEMBER_REF(double, Radius)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FVersionedCircle)
+
+class FVersionedSquare final : public FVersionedShape
+{
+    DYNAMIC_TYPE_BODY(FVersionedSquare, FVersionedShape, )
+    DEFINE_CONST_VIRTUAL_FUNCTION(GetCorners, int32_t, int32_t, Bias)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_FINAL(FVersionedSquare)
+
+class FShapeBounds : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FShapeBounds, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Width)
+    DEFINE_TYPE_MEMBER_REF(std::string, Label)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FShapeBounds)
+
+class FBoundedShape : public FDynamicTypeBase
+{
+    DYNAMIC_TYPE_BODY(FBoundedShape, FDynamicTypeBase, )
+    DEFINE_TYPE_MEMBER_REF(int32_t, Size)
+    DEFINE_CONST_VIRTUAL_FUNCTION(GetBounds, FShapeBounds, int32_t, Scale)
+    DYNAMIC_TYPE_END
+};
+IMPLEMENT_DYNAMIC_TYPE_SEQUENTIAL(FBoundedShape)
+
+static int32_t GetMajorVersionOne(const FVersionedShape*, const int32_t Bias) { return 1 + Bias; }
+static int32_t GetMinorVersionOne(const FVersionedShape*, const int32_t Bias) { return 10 + Bias; }
+static int32_t GetMajorVersionTwo(const FVersionedShape*, const int32_t Bias) { return 2 + Bias; }
+static int32_t GetMinorVersionTwo(const FVersionedShape*, const int32_t Bias) { return 20 + Bias; }
+static int32_t GetCircleMinorVersion(const FVersionedShape*, const int32_t Bias) { return 30 + Bias; }
+static int32_t GetFourCorners(const FVersionedSquare*, const int32_t Bias) { return 4 + Bias; }
+static int32_t GetNoCorners(const FVersionedSquare*, const int32_t Bias) { return Bias; }
+
+/** Functions returning the dynamic types receive the storage for the return value, and construct the value in it */
+static FShapeBounds* GetScaledBounds(const FBoundedShape* Shape, FShapeBounds* ReturnValueStorage, const int32_t Scale)
+{
+    FShapeBounds::StaticType()->EmplaceTypeInstance(ReturnValueStorage);
+    ReturnValueStorage->GetWidth() = Shape->GetSize() * Scale;
+    ReturnValueStorage->GetLabel() = std::string(40, 'b');
+    return ReturnValueStorage;
+}
+
+static std::vector<AutoTypeLayout::FVirtualFunctionOverride> MakeVersionOverrides(const IDynamicTypeLayout* ShapeType, const bool bVersionTwo)
+{
+    return {
+        {ShapeType->FindVirtualFunction(DTL_TEXT("GetMajorVersion")), reinterpret_cast<GenericFunctionPtr>(bVersionTwo ? &GetMajorVersionTwo : &GetMajorVersionOne)},
+        {ShapeType->FindVirtualFunction(DTL_TEXT("GetMinorVersion")), reinterpret_cast<GenericFunctionPtr>(bVersionTwo ? &GetMinorVersionTwo : &GetMinorVersionOne)},
+    };
+}
+
+/** Batch overrides reach the child types that inherit the functions, but not the functions the child types have overridden themselves */
+static void TestBatchOverrideReachesInheritingTypes()
+{
+    AutoTypeLayout* ShapeType = CastDynamicTypeImpl<AutoTypeLayout>(FVersionedShape::StaticType());
+    AutoTypeLayout* CircleType = CastDynamicTypeImpl<AutoTypeLayout>(FVersionedCircle::StaticType());
+    ShapeType->RegisterVirtualFunctionOverrides(MakeVersionOverrides(ShapeType, false));
+
+    Dyn<FVersionedCircle> Circle;
+    DTL_TEST_CHECK(Circle->GetMajorVersion(0) == 1);
+    DTL_TEST_CHECK(Circle->GetMinorVersion(0) == 10);
+
+    CircleType->RegisterVirtualFunctionOverride(ShapeType->FindVirtualFunction(DTL_TEXT("GetMinorVersion")), reinterpret_cast<GenericFunctionPtr>(&GetCircleMinorVersion));
+    ShapeType->RegisterVirtualFunctionOverrides(MakeVersionOverrides(ShapeType, true));
+
+    Dyn<FVersionedShape> Shape;
+    DTL_TEST_CHECK(Shape->GetMajorVersion(1) == 3);
+    DTL_TEST_CHECK(Shape->GetMinorVersion(1) == 21);
+    DTL_TEST_CHECK(Circle->GetMajorVersion(0) == 2);
+    DTL_TEST_CHECK(Circle->GetMinorVersion(0) == 30);
+
+    // Instances point to the slot of the published table, which is still preceded by their type
+    DTL_TEST_CHECK(ShapeType->GetInstanceType(&*Circle) == CircleType);
+    DTL_TEST_CHECK(ShapeType->GetInstanceType(&*Shape) == ShapeType);
+}
+
+/** Final types dispatch through the published table slot of the type, so they see the overrides registered after the first call */
+static void TestFinalTypeCallsPublishedTable()
+{
+    AutoTypeLayout* SquareType = CastDynamicTypeImpl<AutoTypeLayout>(FVersionedSquare::StaticType());
+    const FDynamicTypeVirtualFunction* GetCornersFunction = SquareType->FindVirtualFunction(DTL_TEXT("GetCorners"));
+    SquareType->RegisterVirtualFunctionOverride(GetCornersFunction, reinterpret_cast<GenericFunctionPtr>(&GetFourCorners));
+
+    Dyn<FVersionedSquare> Square;
+    DTL_TEST_CHECK(Square->GetCorners(0) == 4);
+    SquareType->RegisterVirtualFunctionOverride(GetCornersFunction, reinterpret_cast<GenericFunctionPtr>(&GetNoCorners));
+    DTL_TEST_CHECK(Square->GetCorners(0) == 0);
+}
+
+/** Readers of the published table observe either all or none of the overrides of the batch, even while the batches are being registered concurrently */
+static void TestConcurrentBatchIsPublishedAtOnce()
+{
+    AutoTypeLayout* ShapeType = CastDynamicTypeImpl<AutoTypeLayout>(FVersionedShape::StaticType());
+    const int64_t MajorVersionIndex = ShapeType->FindVirtualFunction(DTL_TEXT("GetMajorVersion"))->GetVirtualFunctionTableOffset() / static_cast<int64_t>(sizeof(GenericFunctionPtr));
+    const int64_t MinorVersionIndex = ShapeType->FindVirtualFunction(DTL_TEXT("GetMinorVersion"))->GetVirtualFunctionTableOffset() / static_cast<int64_t>(sizeof(GenericFunctionPtr));
+    const GenericFunctionPtr* PublishedTableSlot = ShapeType->GetPublishedVirtualFunctionTableSlot();
+    DTL_TEST_CHECK(PublishedTableSlot != nullptr);
+
+    std::atomic<bool> bWriterFinished{false};
+    std::atomic<bool> bObservedTornBatch{false};
+    std::thread ReaderThread([&]
+    {
+        while (!bWriterFinished.load())
+        {
+            const GenericFunctionPtr* VirtualFunctionTable = FDynamicTypeVirtualFunction::LoadPublishedVirtualFunctionTable(PublishedTableSlot);
+            const bool bVersionOne = VirtualFunctionTable[MajorVersionIndex] == reinterpret_cast<GenericFunctionPtr>(&GetMajorVersionOne);
+            const GenericFunctionPtr ExpectedMinorVersion = reinterpret_cast<GenericFunctionPtr>(bVersionOne ? &GetMinorVersionOne : &GetMinorVersionTwo);
+            if (VirtualFunctionTable[MinorVersionIndex] != ExpectedMinorVersion)
+            {
+                bObservedTornBatch.store(true);
+            }
+        }
+    });
+    for (int32_t BatchIndex = 0; BatchIndex < 2000; BatchIndex++)
+    {
+        ShapeType->RegisterVirtualFunctionOverrides(MakeVersionOverrides(ShapeType, BatchIndex % 2 == 0));
+    }
+    bWriterFinished.store(true);
+    ReaderThread.join();
+    DTL_TEST_CHECK(!bObservedTornBatch.load());
+}
+
+/** Variants of the functions returning the dynamic types construct the return value into the storage provided by the caller instead of allocating it */
+static void TestReturnValueIntoProvidedStorage()
+{
+    AutoTypeLayout* ShapeType = CastDynamicTypeImpl<AutoTypeLayout>(FBoundedShape::StaticType());
+    ShapeType->RegisterVirtualFunctionOverride(ShapeType->FindVirtualFunction(DTL_TEXT("GetBounds")), reinterpret_cast<GenericFunctionPtr>(&GetScaledBounds));
+    Dyn<FBoundedShape> Shape;
+    Shape->GetSize() = 3;
+
+    const IDynamicTypeLayout* BoundsType = FShapeBounds::StaticType();
+    alignas(std::max_align_t) uint8_t BoundsStorage[128];
+    DTL_TEST_CHECK(BoundsType->GetSize() <= sizeof(BoundsStorage));
+    FShapeBounds* Bounds = Shape->GetBoundsInto(reinterpret_cast<FShapeBounds*>(BoundsStorage), 2);
+    DTL_TEST_CHECK(Bounds == reinterpret_cast<FShapeBounds*>(BoundsStorage));
+    DTL_TEST_CHECK(Bounds->GetWidth() == 6);
+    DTL_TEST_CHECK(Bounds->GetLabel() == std::string(40, 'b'));
+    BoundsType->DestructTypeInstance(Bounds);
+
+    const InlineDyn<FShapeBounds> InlineBounds(ConstructInPlace, [&](FShapeBounds* ReturnValueStorage) { Shape->GetBoundsInto(ReturnValueStorage, 4); });
+    DTL_TEST_CHECK(InlineBounds.IsInline());
+    DTL_TEST_CHECK(InlineBounds->GetWidth() == 12);
+    DTL_TEST_CHECK(InlineBounds->GetLabel() == std::string(40, 'b'));
+
+    const Dyn<FShapeBounds> AllocatedBounds = Shape->GetBounds(5);
+    DTL_TEST_CHECK(AllocatedBounds->GetWidth() == 15);
+}
+
+int main()
+{
+    TestBatchOverrideReachesInheritingTypes();
+    TestFinalTypeCallsPublishedTable();
+    TestConcurrentBatchIsPublishedAtOnce();
+    TestReturnValueIntoProvidedStorage();
+    return 0;
+}